@@ -0,0 +1,230 @@
+#ifndef AML_AXISROTATION_H
+#define AML_AXISROTATION_H
+
+#include "AMLVector3.h"
+#include "AMLMatrix33.h"
+
+#include <cmath>
+
+namespace AML
+{
+  // ============================================================
+  // AxisRotation
+  //
+  // Elementary rotation about one coordinate axis
+  // (Axis = 0, 1, 2 for x, y, z), stored as the cosine and sine of
+  // the angle instead of nine matrix elements.
+  //
+  // Convention matches quat2dcm: the rotation turns vectors by
+  // +angle about the axis, e.g.
+  //
+  //   RotationZ(a) = [ c -s  0 ]
+  //                  [ s  c  0 ]
+  //                  [ 0  0  1 ]
+  //
+  // Products know the sparsity:
+  // - AxisRotation * Vector3: 4 multiplies (vs 9)
+  // - AxisRotation * Matrix33, Matrix33 * AxisRotation:
+  //   12 multiplies (vs 27)
+  // - same-axis AxisRotation * AxisRotation: 4 multiplies and
+  //   the result stays an AxisRotation
+  // - different-axis AxisRotation * AxisRotation: 4 multiplies
+  //
+  // Typical use, 3-2-1 Euler sequence:
+  //   Matrix33 R = RotationZ(yaw) * RotationY(pitch) * RotationX(roll);
+  // ============================================================
+  template <int Axis>
+  class AxisRotation
+  {
+    static_assert(Axis >= 0 && Axis < 3, "Axis must be 0 (x), 1 (y) or 2 (z)");
+
+  public:
+    // Cosine and sine of the rotation angle
+    double c;
+    double s;
+
+    // ------------------------------------------------------------
+    // Constructors
+    // ------------------------------------------------------------
+
+    // Default constructor
+    // Zero angle (identity).
+    constexpr AxisRotation() : c(1.0), s(0.0) {}
+
+    // Angle constructor (radians)
+    explicit AxisRotation(double angle) : c(std::cos(angle)), s(std::sin(angle)) {}
+
+    // Cosine / sine constructor
+    // Caller ensures cos^2 + sin^2 = 1.
+    constexpr AxisRotation(double cosAngle, double sinAngle) : c(cosAngle), s(sinAngle) {}
+
+    // Expands to a dense matrix
+    constexpr Matrix33 toMatrix33() const;
+
+    // Rotation angle in (-pi, pi]
+    double angle() const { return std::atan2(s, c); }
+
+    // ------------------------------------------------------------
+    // Identity rotation
+    // ------------------------------------------------------------
+    static constexpr AxisRotation identity() { return AxisRotation(); }
+
+  }; // class AxisRotation
+
+  using RotationX = AxisRotation<0>;
+  using RotationY = AxisRotation<1>;
+  using RotationZ = AxisRotation<2>;
+
+  // ============================================================
+  // Products
+  // ============================================================
+
+  // Rotates a vector
+  template <int A>
+  constexpr Vector3 operator*(const AxisRotation<A>& lhs, const Vector3& rhs);
+
+  // Rotation applied to the rows (left) or columns (right) of a matrix
+  template <int A>
+  Matrix33 operator*(const AxisRotation<A>& lhs, const Matrix33& rhs);
+
+  template <int A>
+  Matrix33 operator*(const Matrix33& lhs, const AxisRotation<A>& rhs);
+
+  // Same axis: angles add
+  template <int A>
+  constexpr AxisRotation<A> operator*(const AxisRotation<A>& lhs, const AxisRotation<A>& rhs);
+
+  // Different axes: dense result
+  template <int A, int B> requires (A != B)
+  constexpr Matrix33 operator*(const AxisRotation<A>& lhs, const AxisRotation<B>& rhs);
+
+  // Inverse rotation (negated angle)
+  template <int A>
+  constexpr AxisRotation<A> transpose(const AxisRotation<A>& rhs);
+
+  // ============================================================
+  // Implementation
+  //
+  // Each product is written out per axis so only the non-trivial
+  // terms are computed.
+  // ============================================================
+
+  template <int Axis>
+  constexpr Matrix33 AxisRotation<Axis>::toMatrix33() const
+  {
+    if constexpr (Axis == 0)
+      return Matrix33(1.0, 0.0, 0.0,
+                      0.0, c,   -s,
+                      0.0, s,   c);
+    else if constexpr (Axis == 1)
+      return Matrix33(c,   0.0, s,
+                      0.0, 1.0, 0.0,
+                      -s,  0.0, c);
+    else
+      return Matrix33(c,   -s,  0.0,
+                      s,   c,   0.0,
+                      0.0, 0.0, 1.0);
+  }
+
+  template <int A>
+  constexpr Vector3 operator*(const AxisRotation<A>& lhs, const Vector3& rhs)
+  {
+    const double c = lhs.c;
+    const double s = lhs.s;
+    if constexpr (A == 0)
+      return Vector3(rhs.x, c * rhs.y - s * rhs.z, s * rhs.y + c * rhs.z);
+    else if constexpr (A == 1)
+      return Vector3(c * rhs.x + s * rhs.z, rhs.y, c * rhs.z - s * rhs.x);
+    else
+      return Vector3(c * rhs.x - s * rhs.y, s * rhs.x + c * rhs.y, rhs.z);
+  }
+
+  template <int A>
+  Matrix33 operator*(const AxisRotation<A>& lhs, const Matrix33& rhs)
+  {
+    // Row A is unchanged, the other two rows mix
+    const double c = lhs.c;
+    const double s = lhs.s;
+    const Matrix33& m = rhs;
+    if constexpr (A == 0)
+      return Matrix33(m.m11, m.m12, m.m13,
+                      c * m.m21 - s * m.m31, c * m.m22 - s * m.m32, c * m.m23 - s * m.m33,
+                      s * m.m21 + c * m.m31, s * m.m22 + c * m.m32, s * m.m23 + c * m.m33);
+    else if constexpr (A == 1)
+      return Matrix33(c * m.m11 + s * m.m31, c * m.m12 + s * m.m32, c * m.m13 + s * m.m33,
+                      m.m21, m.m22, m.m23,
+                      c * m.m31 - s * m.m11, c * m.m32 - s * m.m12, c * m.m33 - s * m.m13);
+    else
+      return Matrix33(c * m.m11 - s * m.m21, c * m.m12 - s * m.m22, c * m.m13 - s * m.m23,
+                      s * m.m11 + c * m.m21, s * m.m12 + c * m.m22, s * m.m13 + c * m.m23,
+                      m.m31, m.m32, m.m33);
+  }
+
+  template <int A>
+  Matrix33 operator*(const Matrix33& lhs, const AxisRotation<A>& rhs)
+  {
+    // Column A is unchanged, the other two columns mix
+    const double c = rhs.c;
+    const double s = rhs.s;
+    const Matrix33& m = lhs;
+    if constexpr (A == 0)
+      return Matrix33(m.m11, c * m.m12 + s * m.m13, c * m.m13 - s * m.m12,
+                      m.m21, c * m.m22 + s * m.m23, c * m.m23 - s * m.m22,
+                      m.m31, c * m.m32 + s * m.m33, c * m.m33 - s * m.m32);
+    else if constexpr (A == 1)
+      return Matrix33(c * m.m11 - s * m.m13, m.m12, c * m.m13 + s * m.m11,
+                      c * m.m21 - s * m.m23, m.m22, c * m.m23 + s * m.m21,
+                      c * m.m31 - s * m.m33, m.m32, c * m.m33 + s * m.m31);
+    else
+      return Matrix33(c * m.m11 + s * m.m12, c * m.m12 - s * m.m11, m.m13,
+                      c * m.m21 + s * m.m22, c * m.m22 - s * m.m21, m.m23,
+                      c * m.m31 + s * m.m32, c * m.m32 - s * m.m31, m.m33);
+  }
+
+  template <int A>
+  constexpr AxisRotation<A> operator*(const AxisRotation<A>& lhs, const AxisRotation<A>& rhs)
+  {
+    return AxisRotation<A>(lhs.c * rhs.c - lhs.s * rhs.s, lhs.s * rhs.c + lhs.c * rhs.s);
+  }
+
+  template <int A, int B> requires (A != B)
+  constexpr Matrix33 operator*(const AxisRotation<A>& lhs, const AxisRotation<B>& rhs)
+  {
+    // Closed forms of the six ordered axis pairs, 4 multiplies each
+    const double ca = lhs.c, sa = lhs.s;
+    const double cb = rhs.c, sb = rhs.s;
+    if constexpr (A == 0 && B == 1)
+      return Matrix33(cb,       0.0, sb,
+                      sa * sb,  ca,  -sa * cb,
+                      -ca * sb, sa,  ca * cb);
+    else if constexpr (A == 0 && B == 2)
+      return Matrix33(cb,      -sb,     0.0,
+                      ca * sb, ca * cb, -sa,
+                      sa * sb, sa * cb, ca);
+    else if constexpr (A == 1 && B == 0)
+      return Matrix33(ca,  sa * sb, sa * cb,
+                      0.0, cb,      -sb,
+                      -sa, ca * sb, ca * cb);
+    else if constexpr (A == 1 && B == 2)
+      return Matrix33(ca * cb,  -ca * sb, sa,
+                      sb,       cb,       0.0,
+                      -sa * cb, sa * sb,  ca);
+    else if constexpr (A == 2 && B == 0)
+      return Matrix33(ca,  -sa * cb, sa * sb,
+                      sa,  ca * cb,  -ca * sb,
+                      0.0, sb,       cb);
+    else
+      return Matrix33(ca * cb, -sa, ca * sb,
+                      sa * cb, ca,  sa * sb,
+                      -sb,     0.0, cb);
+  }
+
+  template <int A>
+  constexpr AxisRotation<A> transpose(const AxisRotation<A>& rhs)
+  {
+    return AxisRotation<A>(rhs.c, -rhs.s);
+  }
+
+} // namespace AML
+
+#endif // AML_AXISROTATION_H
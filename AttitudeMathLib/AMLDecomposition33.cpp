@@ -0,0 +1,600 @@
+#include "AMLDecomposition33.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace AML
+{
+
+  namespace
+  {
+    // Matrices decomposed together; each step of the solver is a
+    // loop over the chunk so it vectorizes across matrices
+    constexpr std::size_t chunkSize = 64;
+
+    // Cyclic Jacobi converges quadratically; 3x3 matrices need 3-5
+    // sweeps, rank-deficient ones a few more to clear the zero rows
+    constexpr int maxSweeps = 12;
+
+    // Squared unit roundoff (2^-53)^2
+    constexpr double eps2 = 0x1p-106;
+
+    // Symmetric matrices of a chunk (upper triangle) and the
+    // accumulated rotations
+    struct EigenChunk
+    {
+      double a11[chunkSize], a12[chunkSize], a13[chunkSize];
+      double a22[chunkSize], a23[chunkSize], a33[chunkSize];
+      double v11[chunkSize], v12[chunkSize], v13[chunkSize];
+      double v21[chunkSize], v22[chunkSize], v23[chunkSize];
+      double v31[chunkSize], v32[chunkSize], v33[chunkSize];
+    };
+
+    // Off-diagonal element small enough to leave: relative to its
+    // diagonal pair, with an absolute floor for zero diagonals (the
+    // matrices are scaled so the largest element is in [0.5, 1))
+    inline bool negligible(double apq, double app, double aqq)
+    {
+      return apq * apq <= eps2 * std::max(std::fabs(app * aqq), eps2);
+    }
+
+    // ------------------------------------------------------------
+    // Jacobi rotation in the (p, q) plane zeroing a_pq. r is the
+    // remaining index: arp = a_rp, arq = a_rq. v1p..v3q are columns
+    // p and q of the accumulated rotation.
+    //
+    // t = tan(angle) is the smaller root of t^2 + 2 theta t - 1 = 0,
+    // theta = (a_qq - a_pp) / (2 a_pq), written without dividing by
+    // a_pq. Negligible a_pq gives t = 0 through a select, so extra
+    // sweeps leave converged matrices unchanged (a chunk sweeps
+    // until all of its matrices have converged).
+    // ------------------------------------------------------------
+    inline double jacobiTangent(double app, double aqq, double apq)
+    {
+      double d = aqq - app;
+      double den = std::fabs(d) + std::sqrt(d * d + 4.0 * apq * apq);
+      return negligible(apq, app, aqq) ? 0.0 : std::copysign(2.0, d) * apq / den;
+    }
+
+    // (xp, xq) <- (c * xp - s * xq, s * xp + c * xq)
+    inline void rotateColumns(double c, double s, double& xp, double& xq)
+    {
+      double x = xp, y = xq;
+      xp = c * x - s * y;
+      xq = s * x + c * y;
+    }
+
+    inline void jacobiRotate(double& app, double& aqq, double& apq, double& arp, double& arq,
+                             double& v1p, double& v1q, double& v2p, double& v2q, double& v3p, double& v3q)
+    {
+      double t = jacobiTangent(app, aqq, apq);
+      double c = 1.0 / std::sqrt(1.0 + t * t);
+      double s = t * c;
+
+      app -= t * apq;
+      aqq += t * apq;
+      apq = 0.0;
+
+      rotateColumns(c, s, arp, arq);
+      rotateColumns(c, s, v1p, v1q);
+      rotateColumns(c, s, v2p, v2q);
+      rotateColumns(c, s, v3p, v3q);
+    }
+
+    // (xp, xq) <- (xq, -xp) when swap is set: exchanging two
+    // columns this way keeps the determinant
+    inline void swapColumns(bool swap, double& xp, double& xq)
+    {
+      double x = xp, y = xq;
+      xp = swap ? y : x;
+      xq = swap ? -x : y;
+    }
+
+    // Orders eigenvalues lp >= lq, swapping columns p and q and
+    // negating one so the rotation keeps determinant +1
+    inline void sortPair(double& lp, double& lq,
+                         double& v1p, double& v1q, double& v2p, double& v2q, double& v3p, double& v3q)
+    {
+      bool swap = lp < lq;
+      double a = lp, b = lq;
+      lp = swap ? b : a;
+      lq = swap ? a : b;
+
+      swapColumns(swap, v1p, v1q);
+      swapColumns(swap, v2p, v2q);
+      swapColumns(swap, v3p, v3q);
+    }
+
+    // Diagonalizes the chunk in place: the eigenvalues end up on
+    // the diagonal in descending order and v holds the eigenvectors
+    void eigenChunk(EigenChunk& e, std::size_t count)
+    {
+      for (std::size_t l = 0; l < count; ++l)
+        {
+          e.v11[l] = 1.0; e.v12[l] = 0.0; e.v13[l] = 0.0;
+          e.v21[l] = 0.0; e.v22[l] = 1.0; e.v23[l] = 0.0;
+          e.v31[l] = 0.0; e.v32[l] = 0.0; e.v33[l] = 1.0;
+        }
+
+      for (int sweep = 0; sweep < maxSweeps; ++sweep)
+        {
+          int pending = 0;
+          for (std::size_t l = 0; l < count; ++l)
+            {
+              pending |= !negligible(e.a12[l], e.a11[l], e.a22[l]);
+              pending |= !negligible(e.a13[l], e.a11[l], e.a33[l]);
+              pending |= !negligible(e.a23[l], e.a22[l], e.a33[l]);
+            }
+          if (pending == 0)
+            break;
+
+          for (std::size_t l = 0; l < count; ++l)
+            {
+              double a11 = e.a11[l], a12 = e.a12[l], a13 = e.a13[l];
+              double a22 = e.a22[l], a23 = e.a23[l], a33 = e.a33[l];
+              double v11 = e.v11[l], v12 = e.v12[l], v13 = e.v13[l];
+              double v21 = e.v21[l], v22 = e.v22[l], v23 = e.v23[l];
+              double v31 = e.v31[l], v32 = e.v32[l], v33 = e.v33[l];
+
+              jacobiRotate(a11, a22, a12, a13, a23, v11, v12, v21, v22, v31, v32);
+              jacobiRotate(a11, a33, a13, a12, a23, v11, v13, v21, v23, v31, v33);
+              jacobiRotate(a22, a33, a23, a12, a13, v12, v13, v22, v23, v32, v33);
+
+              e.a11[l] = a11; e.a12[l] = a12; e.a13[l] = a13;
+              e.a22[l] = a22; e.a23[l] = a23; e.a33[l] = a33;
+              e.v11[l] = v11; e.v12[l] = v12; e.v13[l] = v13;
+              e.v21[l] = v21; e.v22[l] = v22; e.v23[l] = v23;
+              e.v31[l] = v31; e.v32[l] = v32; e.v33[l] = v33;
+            }
+        }
+
+      // Three compare-swaps sort three values
+      for (std::size_t l = 0; l < count; ++l)
+        {
+          double a11 = e.a11[l], a22 = e.a22[l], a33 = e.a33[l];
+          double v11 = e.v11[l], v12 = e.v12[l], v13 = e.v13[l];
+          double v21 = e.v21[l], v22 = e.v22[l], v23 = e.v23[l];
+          double v31 = e.v31[l], v32 = e.v32[l], v33 = e.v33[l];
+
+          sortPair(a11, a22, v11, v12, v21, v22, v31, v32);
+          sortPair(a22, a33, v12, v13, v22, v23, v32, v33);
+          sortPair(a11, a22, v11, v12, v21, v22, v31, v32);
+
+          e.a11[l] = a11; e.a22[l] = a22; e.a33[l] = a33;
+          e.v11[l] = v11; e.v12[l] = v12; e.v13[l] = v13;
+          e.v21[l] = v21; e.v22[l] = v22; e.v23[l] = v23;
+          e.v31[l] = v31; e.v32[l] = v32; e.v33[l] = v33;
+        }
+    }
+
+    // Givens rotation [c s; -s c] taking (a, b) to (rho, 0), the
+    // identity when both are zero
+    inline void givens(double a, double b, double& c, double& s)
+    {
+      double rho = std::sqrt(a * a + b * b);
+      bool nonzero = rho > 0.0;
+      c = nonzero ? a / rho : 1.0;
+      s = nonzero ? b / rho : 0.0;
+    }
+
+    inline void rotatePair(double c, double s, double& x, double& y)
+    {
+      double a = x, b = y;
+      x = c * a + s * b;
+      y = c * b - s * a;
+    }
+
+    // Power-of-two scaling that brings the largest element |x| into
+    // [0.5, 1): exact, and in range for any finite input. 2^-e
+    // alone overflows when x is subnormal (and 2^e when x is near
+    // the largest double), so each factor is applied in two halves.
+    struct Scaling
+    {
+      double down[2];
+      double up[2];
+    };
+
+    // 2^k for -1022 <= k <= 1023
+    inline double powerOfTwo(int k)
+    {
+      return std::bit_cast<double>(std::uint64_t(1023 + k) << 52);
+    }
+
+    // Exponents are read from the bits (frexp / ldexp are library
+    // calls and cost a third of the batch kernels); subnormals are
+    // lifted by 2^64 first. Zero is left unscaled.
+    inline Scaling scaling(double big)
+    {
+      bool tiny = big < std::numeric_limits<double>::min();
+      double lifted = tiny ? big * 0x1p64 : big;
+      int e = int((std::bit_cast<std::uint64_t>(lifted) >> 52) & 0x7ff) - 1022 - (tiny ? 64 : 0);
+      e = big > 0.0 ? e : 0;
+      int h = e / 2;
+      return Scaling{{powerOfTwo(-h), powerOfTwo(h - e)}, {powerOfTwo(h), powerOfTwo(e - h)}};
+    }
+
+    // ------------------------------------------------------------
+    // Element k of item i at p[k][i * stride]: the arrays of a
+    // batch (stride 1), one pointer per element into the buffer of
+    // a strided view, or a single matrix (n = 1).
+    // ------------------------------------------------------------
+    template <typename T, int K>
+    struct ElementArrays
+    {
+      T* p[K];
+      std::ptrdiff_t stride;
+
+      T& operator()(int k, std::size_t i) const
+      {
+        return p[k][std::ptrdiff_t(i) * stride];
+      }
+    };
+
+    using MatrixIn = ElementArrays<const double, 9>;
+    using MatrixOut = ElementArrays<double, 9>;
+    using VectorOut = ElementArrays<double, 3>;
+
+    // ------------------------------------------------------------
+    // Kernels over n matrices. Matrices are passed as 9 elements
+    // (row-major element order), symmetric ones as the 6 upper-
+    // triangle elements.
+    // ------------------------------------------------------------
+    void eigenKernel(std::size_t n, const ElementArrays<const double, 6>& s, const VectorOut& values,
+                     const MatrixOut& vectors)
+    {
+      EigenChunk e;
+      Scaling scale[chunkSize];
+      for (std::size_t begin = 0; begin < n; begin += chunkSize)
+        {
+          std::size_t count = std::min(chunkSize, n - begin);
+          for (std::size_t l = 0; l < count; ++l)
+            {
+              std::size_t i = begin + l;
+              double s11 = s(0, i), s12 = s(1, i), s13 = s(2, i);
+              double s22 = s(3, i), s23 = s(4, i), s33 = s(5, i);
+              double m = std::max(std::max(std::max(std::fabs(s11), std::fabs(s12)), std::max(std::fabs(s13), std::fabs(s22))),
+                                  std::max(std::fabs(s23), std::fabs(s33)));
+              scale[l] = scaling(m);
+              const double r0 = scale[l].down[0], r1 = scale[l].down[1];
+              e.a11[l] = s11 * r0 * r1; e.a12[l] = s12 * r0 * r1; e.a13[l] = s13 * r0 * r1;
+              e.a22[l] = s22 * r0 * r1; e.a23[l] = s23 * r0 * r1; e.a33[l] = s33 * r0 * r1;
+            }
+
+          eigenChunk(e, count);
+
+          for (std::size_t l = 0; l < count; ++l)
+            {
+              std::size_t i = begin + l;
+              const double u0 = scale[l].up[0], u1 = scale[l].up[1];
+              values(0, i) = e.a11[l] * u0 * u1;
+              values(1, i) = e.a22[l] * u0 * u1;
+              values(2, i) = e.a33[l] * u0 * u1;
+              vectors(0, i) = e.v11[l]; vectors(1, i) = e.v12[l]; vectors(2, i) = e.v13[l];
+              vectors(3, i) = e.v21[l]; vectors(4, i) = e.v22[l]; vectors(5, i) = e.v23[l];
+              vectors(6, i) = e.v31[l]; vectors(7, i) = e.v32[l]; vectors(8, i) = e.v33[l];
+            }
+        }
+    }
+
+    void svdKernel(std::size_t n, const MatrixIn& M, const MatrixOut& U, const VectorOut& S, const MatrixOut& V)
+    {
+      EigenChunk e;
+      double m[9][chunkSize];
+      Scaling scale[chunkSize];
+      for (std::size_t begin = 0; begin < n; begin += chunkSize)
+        {
+          std::size_t count = std::min(chunkSize, n - begin);
+
+          // Scaled M and A = M^T * M
+          for (std::size_t l = 0; l < count; ++l)
+            {
+              std::size_t i = begin + l;
+              double x[9];
+              double big = 0.0;
+              for (int k = 0; k < 9; ++k)
+                {
+                  x[k] = M(k, i);
+                  big = std::max(big, std::fabs(x[k]));
+                }
+              scale[l] = scaling(big);
+              for (int k = 0; k < 9; ++k)
+                {
+                  x[k] = x[k] * scale[l].down[0] * scale[l].down[1];
+                  m[k][l] = x[k];
+                }
+              e.a11[l] = x[0] * x[0] + x[3] * x[3] + x[6] * x[6];
+              e.a12[l] = x[0] * x[1] + x[3] * x[4] + x[6] * x[7];
+              e.a13[l] = x[0] * x[2] + x[3] * x[5] + x[6] * x[8];
+              e.a22[l] = x[1] * x[1] + x[4] * x[4] + x[7] * x[7];
+              e.a23[l] = x[1] * x[2] + x[4] * x[5] + x[7] * x[8];
+              e.a33[l] = x[2] * x[2] + x[5] * x[5] + x[8] * x[8];
+            }
+
+          eigenChunk(e, count);
+
+          // B = M * V, then B = Q * R by Givens rotations; R is
+          // diagonal to rounding because the columns of B are
+          // orthogonal and sorted by length
+          for (std::size_t l = 0; l < count; ++l)
+            {
+              std::size_t i = begin + l;
+              double v11 = e.v11[l], v12 = e.v12[l], v13 = e.v13[l];
+              double v21 = e.v21[l], v22 = e.v22[l], v23 = e.v23[l];
+              double v31 = e.v31[l], v32 = e.v32[l], v33 = e.v33[l];
+
+              double b11 = m[0][l] * v11 + m[1][l] * v21 + m[2][l] * v31;
+              double b12 = m[0][l] * v12 + m[1][l] * v22 + m[2][l] * v32;
+              double b13 = m[0][l] * v13 + m[1][l] * v23 + m[2][l] * v33;
+              double b21 = m[3][l] * v11 + m[4][l] * v21 + m[5][l] * v31;
+              double b22 = m[3][l] * v12 + m[4][l] * v22 + m[5][l] * v32;
+              double b23 = m[3][l] * v13 + m[4][l] * v23 + m[5][l] * v33;
+              double b31 = m[6][l] * v11 + m[7][l] * v21 + m[8][l] * v31;
+              double b32 = m[6][l] * v12 + m[7][l] * v22 + m[8][l] * v32;
+              double b33 = m[6][l] * v13 + m[7][l] * v23 + m[8][l] * v33;
+
+              // When s2 << s1 the eigenvectors of M^T * M only fix
+              // columns 2 and 3 of B to within eps * s1^2 / s2 of
+              // orthogonal. One one-sided Jacobi rotation on their
+              // Gram matrix, formed from B itself, restores that
+              // (applied to V as well, so M * V = B still holds).
+              double g22 = b12 * b12 + b22 * b22 + b32 * b32;
+              double g33 = b13 * b13 + b23 * b23 + b33 * b33;
+              double g23 = b12 * b13 + b22 * b23 + b32 * b33;
+              double t = jacobiTangent(g22, g33, g23);
+              double c = 1.0 / std::sqrt(1.0 + t * t);
+              double s = t * c;
+              rotateColumns(c, s, b12, b13);
+              rotateColumns(c, s, b22, b23);
+              rotateColumns(c, s, b32, b33);
+              rotateColumns(c, s, v12, v13);
+              rotateColumns(c, s, v22, v23);
+              rotateColumns(c, s, v32, v33);
+
+              bool swap = g22 - t * g23 < g33 + t * g23;
+              swapColumns(swap, b12, b13);
+              swapColumns(swap, b22, b23);
+              swapColumns(swap, b32, b33);
+              swapColumns(swap, v12, v13);
+              swapColumns(swap, v22, v23);
+              swapColumns(swap, v32, v33);
+
+              double q11 = 1.0, q12 = 0.0, q13 = 0.0;
+              double q21 = 0.0, q22 = 1.0, q23 = 0.0;
+              double q31 = 0.0, q32 = 0.0, q33 = 1.0;
+
+              // Rows 1, 2: zero b21
+              givens(b11, b21, c, s);
+              rotatePair(c, s, b11, b21);
+              rotatePair(c, s, b12, b22);
+              rotatePair(c, s, b13, b23);
+              rotatePair(c, s, q11, q12);
+              rotatePair(c, s, q21, q22);
+              rotatePair(c, s, q31, q32);
+
+              // Rows 1, 3: zero b31
+              givens(b11, b31, c, s);
+              rotatePair(c, s, b11, b31);
+              rotatePair(c, s, b12, b32);
+              rotatePair(c, s, b13, b33);
+              rotatePair(c, s, q11, q13);
+              rotatePair(c, s, q21, q23);
+              rotatePair(c, s, q31, q33);
+
+              // Rows 2, 3: zero b32
+              givens(b22, b32, c, s);
+              rotatePair(c, s, b22, b32);
+              rotatePair(c, s, b23, b33);
+              rotatePair(c, s, q12, q13);
+              rotatePair(c, s, q22, q23);
+              rotatePair(c, s, q32, q33);
+
+              const double u0 = scale[l].up[0], u1 = scale[l].up[1];
+              S(0, i) = b11 * u0 * u1;
+              S(1, i) = b22 * u0 * u1;
+              S(2, i) = b33 * u0 * u1;
+              U(0, i) = q11; U(1, i) = q12; U(2, i) = q13;
+              U(3, i) = q21; U(4, i) = q22; U(5, i) = q23;
+              U(6, i) = q31; U(7, i) = q32; U(8, i) = q33;
+              V(0, i) = v11; V(1, i) = v12; V(2, i) = v13;
+              V(3, i) = v21; V(4, i) = v22; V(5, i) = v23;
+              V(6, i) = v31; V(7, i) = v32; V(8, i) = v33;
+            }
+        }
+    }
+
+    // Element arrays of single matrices, batches and views
+    MatrixIn elements(const Matrix33& m)
+    {
+      MatrixIn e{{}, 0};
+      for (int k = 0; k < 9; ++k)
+        e.p[k] = &m.data[k / 3][k % 3];
+      return e;
+    }
+
+    MatrixOut elements(Matrix33& m)
+    {
+      MatrixOut e{{}, 0};
+      for (int k = 0; k < 9; ++k)
+        e.p[k] = &m.data[k / 3][k % 3];
+      return e;
+    }
+
+    MatrixIn elements(const Matrix33Batch& b)
+    {
+      return MatrixIn{{b.m11.data(), b.m12.data(), b.m13.data(), b.m21.data(), b.m22.data(), b.m23.data(),
+                       b.m31.data(), b.m32.data(), b.m33.data()}, 1};
+    }
+
+    MatrixOut elements(Matrix33Batch& b)
+    {
+      return MatrixOut{{b.m11.data(), b.m12.data(), b.m13.data(), b.m21.data(), b.m22.data(), b.m23.data(),
+                        b.m31.data(), b.m32.data(), b.m33.data()}, 1};
+    }
+
+    VectorOut elements(Vector3Batch& b)
+    {
+      return VectorOut{{b.x.data(), b.y.data(), b.z.data()}, 1};
+    }
+
+    template <typename T>
+    ElementArrays<T, 9> elements(BasicMatrix33View<T> m)
+    {
+      ElementArrays<T, 9> e{{}, m.stride()};
+      for (int k = 0; k < 9; ++k)
+        e.p[k] = m.data() + (k / 3) * m.rowStride() + (k % 3) * m.colStride();
+      return e;
+    }
+
+    VectorOut elements(Vector3View v)
+    {
+      VectorOut e{{}, v.stride()};
+      for (int k = 0; k < 3; ++k)
+        e.p[k] = v.data() + k * v.componentStride();
+      return e;
+    }
+
+    // Upper triangle s11, s12, s13, s22, s23, s33
+    ElementArrays<const double, 6> upper(const MatrixIn& m)
+    {
+      return ElementArrays<const double, 6>{{m.p[0], m.p[1], m.p[2], m.p[4], m.p[5], m.p[8]}, m.stride};
+    }
+
+    void checkSize(const char* function, std::size_t expected, std::size_t size)
+    {
+      if (size != expected)
+        throw std::invalid_argument(std::string(function) + ": view sizes differ");
+    }
+  }
+
+  // ============================================================
+  // Single matrices
+  // ============================================================
+  SymmetricEigen33 symmetricEigen(const SymMatrix33& S)
+  {
+    SymmetricEigen33 result;
+    ElementArrays<const double, 6> s{{&S.s11, &S.s12, &S.s13, &S.s22, &S.s23, &S.s33}, 0};
+    VectorOut values{{&result.values.d1, &result.values.d2, &result.values.d3}, 0};
+    eigenKernel(1, s, values, elements(result.vectors));
+    return result;
+  }
+
+  SVD33 svd(const Matrix33& M)
+  {
+    SVD33 result;
+    VectorOut s{{&result.S.d1, &result.S.d2, &result.S.d3}, 0};
+    svdKernel(1, elements(M), elements(result.U), s, elements(result.V));
+    return result;
+  }
+
+  Matrix33 nearestRotation(const Matrix33& M)
+  {
+    SVD33 d = svd(M);
+    return d.U * transpose(d.V);
+  }
+
+  Polar33 polar(const Matrix33& M)
+  {
+    SVD33 d = svd(M);
+    return Polar33{d.U * transpose(d.V), congruence(d.V, d.S)};
+  }
+
+  // ============================================================
+  // Batches
+  // ============================================================
+  Vector3Batch::Vector3Batch(std::size_t count)
+  {
+    resize(count);
+  }
+
+  void Vector3Batch::resize(std::size_t count)
+  {
+    x.resize(count); y.resize(count); z.resize(count);
+  }
+
+  std::size_t Vector3Batch::size() const
+  {
+    return x.size();
+  }
+
+  void Vector3Batch::set(std::size_t i, const Vector3& v)
+  {
+    x[i] = v.x; y[i] = v.y; z[i] = v.z;
+  }
+
+  Vector3 Vector3Batch::get(std::size_t i) const
+  {
+    return Vector3(x[i], y[i], z[i]);
+  }
+
+  Matrix33Batch::Matrix33Batch(std::size_t count)
+  {
+    resize(count);
+  }
+
+  void Matrix33Batch::resize(std::size_t count)
+  {
+    m11.resize(count); m12.resize(count); m13.resize(count);
+    m21.resize(count); m22.resize(count); m23.resize(count);
+    m31.resize(count); m32.resize(count); m33.resize(count);
+  }
+
+  std::size_t Matrix33Batch::size() const
+  {
+    return m11.size();
+  }
+
+  void Matrix33Batch::set(std::size_t i, const Matrix33& m)
+  {
+    m11[i] = m.m11; m12[i] = m.m12; m13[i] = m.m13;
+    m21[i] = m.m21; m22[i] = m.m22; m23[i] = m.m23;
+    m31[i] = m.m31; m32[i] = m.m32; m33[i] = m.m33;
+  }
+
+  Matrix33 Matrix33Batch::get(std::size_t i) const
+  {
+    return Matrix33(m11[i], m12[i], m13[i],
+                    m21[i], m22[i], m23[i],
+                    m31[i], m32[i], m33[i]);
+  }
+
+  void symmetricEigen(const Matrix33Batch& S, Vector3Batch& values, Matrix33Batch& vectors)
+  {
+    std::size_t n = S.size();
+    values.resize(n);
+    vectors.resize(n);
+    eigenKernel(n, upper(elements(S)), elements(values), elements(vectors));
+  }
+
+  void svd(const Matrix33Batch& M, Matrix33Batch& U, Vector3Batch& S, Matrix33Batch& V)
+  {
+    std::size_t n = M.size();
+    U.resize(n);
+    S.resize(n);
+    V.resize(n);
+    svdKernel(n, elements(M), elements(U), elements(S), elements(V));
+  }
+
+  // ============================================================
+  // Strided views
+  // ============================================================
+  void symmetricEigen(ConstMatrix33View S, Vector3View values, Matrix33View vectors)
+  {
+    checkSize("symmetricEigen", S.size(), values.size());
+    checkSize("symmetricEigen", S.size(), vectors.size());
+    eigenKernel(S.size(), upper(elements(S)), elements(values), elements(vectors));
+  }
+
+  void svd(ConstMatrix33View M, Matrix33View U, Vector3View S, Matrix33View V)
+  {
+    checkSize("svd", M.size(), U.size());
+    checkSize("svd", M.size(), S.size());
+    checkSize("svd", M.size(), V.size());
+    svdKernel(M.size(), elements(M), elements(U), elements(S), elements(V));
+  }
+
+} // namespace AML
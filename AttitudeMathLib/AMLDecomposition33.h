@@ -0,0 +1,155 @@
+#ifndef AML_DECOMPOSITION33_H
+#define AML_DECOMPOSITION33_H
+
+#include "AMLVector3.h"
+#include "AMLMatrix33.h"
+#include "AMLDiagMatrix33.h"
+#include "AMLSymMatrix33.h"
+#include "AMLStridedView.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace AML
+{
+  // ============================================================
+  // 3x3 decompositions
+  //
+  // Dedicated symmetric eigen-decomposition and SVD for 3x3
+  // matrices (principal inertia axes, covariance analysis, polar
+  // decomposition, Wahba / SVD attitude solutions).
+  //
+  // symmetricEigen uses cyclic Jacobi rotations. Sweeps stop once
+  // every off-diagonal element is negligible next to its two
+  // diagonal elements (|a_pq| <= eps * sqrt(|a_pp * a_qq|)), so
+  // small eigenvalues keep relative accuracy where the matrix
+  // allows it, and nearly repeated eigenvalues are handled as well
+  // as distinct ones.
+  //
+  // svd diagonalizes M^T * M with the same Jacobi solver to get V,
+  // re-orthogonalizes the two smaller columns of M * V with one
+  // one-sided Jacobi rotation, then QR-factors M * V with Givens
+  // rotations to get U and the singular values. Working on M * V
+  // (not on the eigenvalues of M^T * M) keeps the singular values
+  // accurate to rounding relative to the largest one, even for
+  // rank-deficient M.
+  //
+  // Both are branch-free apart from the sweep-count test, and the
+  // batch versions run the same kernels over structure-of-arrays
+  // input so they vectorize. Inputs are scaled by their largest
+  // element first, so any finite input works without overflow.
+  // ============================================================
+
+  // ------------------------------------------------------------
+  // Symmetric eigen-decomposition S = vectors * values * vectors^T
+  //
+  // - values: eigenvalues in descending order
+  // - vectors: orthonormal eigenvectors as columns, a proper
+  //   rotation (determinant +1)
+  // ------------------------------------------------------------
+  struct SymmetricEigen33
+  {
+    DiagMatrix33 values;
+    Matrix33 vectors;
+  };
+
+  SymmetricEigen33 symmetricEigen(const SymMatrix33& S);
+
+  // ------------------------------------------------------------
+  // Signed SVD M = U * S * V^T
+  //
+  // - U, V: proper rotations (determinant +1)
+  // - S: singular values with |s1| >= |s2| >= |s3|; s1, s2 >= 0
+  //   and s3 carries the sign of det(M)
+  //
+  // Keeping U and V rotations is what attitude problems need:
+  // U * V^T is then the closest rotation to M.
+  // ------------------------------------------------------------
+  struct SVD33
+  {
+    Matrix33 U;
+    DiagMatrix33 S;
+    Matrix33 V;
+  };
+
+  SVD33 svd(const Matrix33& M);
+
+  // Closest rotation to M in the Frobenius norm (U * V^T). For
+  // Wahba's problem pass B = sum w_i * b_i * r_i^T.
+  Matrix33 nearestRotation(const Matrix33& M);
+
+  // ------------------------------------------------------------
+  // Polar decomposition M = R * P
+  //
+  // R is nearestRotation(M) and P = V * S * V^T is symmetric
+  // (positive semi-definite when det(M) >= 0).
+  // ------------------------------------------------------------
+  struct Polar33
+  {
+    Matrix33 R;
+    SymMatrix33 P;
+  };
+
+  Polar33 polar(const Matrix33& M);
+
+  // ============================================================
+  // Structure-of-arrays batches
+  //
+  // One array per element so the batch kernels process several
+  // matrices per SIMD instruction. Element (r, c) of matrix i is
+  // mrc[i]. These own their storage; data already held in another
+  // buffer is passed through the view overloads below instead.
+  // ============================================================
+  struct Vector3Batch
+  {
+    std::vector<double> x, y, z;
+
+    explicit Vector3Batch(std::size_t count = 0);
+
+    void resize(std::size_t count);
+    std::size_t size() const;
+
+    void set(std::size_t i, const Vector3& v);
+    Vector3 get(std::size_t i) const;
+  };
+
+  struct Matrix33Batch
+  {
+    std::vector<double> m11, m12, m13;
+    std::vector<double> m21, m22, m23;
+    std::vector<double> m31, m32, m33;
+
+    explicit Matrix33Batch(std::size_t count = 0);
+
+    void resize(std::size_t count);
+    std::size_t size() const;
+
+    void set(std::size_t i, const Matrix33& m);
+    Matrix33 get(std::size_t i) const;
+  };
+
+  // ------------------------------------------------------------
+  // Batched decompositions
+  //
+  // Same results as the single-matrix functions. Outputs are
+  // resized to the input size. symmetricEigen reads the upper
+  // triangle of each S.
+  // ------------------------------------------------------------
+  void symmetricEigen(const Matrix33Batch& S, Vector3Batch& values, Matrix33Batch& vectors);
+  void svd(const Matrix33Batch& M, Matrix33Batch& U, Vector3Batch& S, Matrix33Batch& V);
+
+  // ------------------------------------------------------------
+  // Batched decompositions on strided views
+  //
+  // The same kernels reading and writing external buffers in
+  // place (see AMLStridedView.h), e.g. a telemetry frame of
+  // row-major matrices, with no copy into a Matrix33Batch. All
+  // views must have the same size (std::invalid_argument). The
+  // outputs must not overlap the input or each other.
+  // ------------------------------------------------------------
+  void symmetricEigen(ConstMatrix33View S, Vector3View values, Matrix33View vectors);
+  void svd(ConstMatrix33View M, Matrix33View U, Vector3View S, Matrix33View V);
+
+} // namespace AML
+
+#endif // AML_DECOMPOSITION33_H
@@ -0,0 +1,138 @@
+#include "AMLDiagMatrix33.h"
+#include "AMLVector3.h"
+#include "AMLMatrix33.h"
+
+#include <cmath>
+
+namespace AML
+{
+
+  // Vector constructor
+  DiagMatrix33::DiagMatrix33(const Vector3& d) :
+    d1(d.x), d2(d.y), d3(d.z)
+  {}
+
+  // Compound assignment operators
+  DiagMatrix33& DiagMatrix33::operator+=(const DiagMatrix33& rhs)
+  {
+    d1 += rhs.d1;
+    d2 += rhs.d2;
+    d3 += rhs.d3;
+    return *this;
+  }
+  DiagMatrix33& DiagMatrix33::operator-=(const DiagMatrix33& rhs)
+  {
+    d1 -= rhs.d1;
+    d2 -= rhs.d2;
+    d3 -= rhs.d3;
+    return *this;
+  }
+  DiagMatrix33& DiagMatrix33::operator*=(const DiagMatrix33& rhs)
+  {
+    d1 *= rhs.d1;
+    d2 *= rhs.d2;
+    d3 *= rhs.d3;
+    return *this;
+  }
+  DiagMatrix33& DiagMatrix33::operator*=(double s)
+  {
+    d1 *= s;
+    d2 *= s;
+    d3 *= s;
+    return *this;
+  }
+  DiagMatrix33& DiagMatrix33::operator/=(double s)
+  {
+    d1 /= s;
+    d2 /= s;
+    d3 /= s;
+    return *this;
+  }
+
+  // Conversions
+  Matrix33 DiagMatrix33::toMatrix33() const
+  {
+    return Matrix33(d1, 0.0, 0.0,
+                    0.0, d2, 0.0,
+                    0.0, 0.0, d3);
+  }
+  Vector3 DiagMatrix33::toVector3() const
+  {
+    return Vector3(d1, d2, d3);
+  }
+
+  // Operators
+  DiagMatrix33 operator-(const DiagMatrix33& rhs)
+  {
+    return DiagMatrix33(-rhs.d1, -rhs.d2, -rhs.d3);
+  }
+  DiagMatrix33 operator+(const DiagMatrix33& lhs, const DiagMatrix33& rhs) {return DiagMatrix33(lhs) += rhs;}
+  DiagMatrix33 operator-(const DiagMatrix33& lhs, const DiagMatrix33& rhs) {return DiagMatrix33(lhs) -= rhs;}
+  DiagMatrix33 operator*(const DiagMatrix33& lhs, const DiagMatrix33& rhs) {return DiagMatrix33(lhs) *= rhs;}
+  DiagMatrix33 operator*(const DiagMatrix33& lhs, double s) {return DiagMatrix33(lhs) *= s;}
+  DiagMatrix33 operator*(double s, const DiagMatrix33& rhs) {return DiagMatrix33(rhs) *= s;}
+  DiagMatrix33 operator/(const DiagMatrix33& lhs, double s) {return DiagMatrix33(lhs) /= s;}
+
+  // Scales each component
+  Vector3 operator*(const DiagMatrix33& lhs, const Vector3& rhs)
+  {
+    return Vector3(lhs.d1 * rhs.x, lhs.d2 * rhs.y, lhs.d3 * rhs.z);
+  }
+
+  // Scales the rows
+  Matrix33 operator*(const DiagMatrix33& lhs, const Matrix33& rhs)
+  {
+    return Matrix33(lhs.d1 * rhs.m11, lhs.d1 * rhs.m12, lhs.d1 * rhs.m13,
+                    lhs.d2 * rhs.m21, lhs.d2 * rhs.m22, lhs.d2 * rhs.m23,
+                    lhs.d3 * rhs.m31, lhs.d3 * rhs.m32, lhs.d3 * rhs.m33);
+  }
+
+  // Scales the columns
+  Matrix33 operator*(const Matrix33& lhs, const DiagMatrix33& rhs)
+  {
+    return Matrix33(lhs.m11 * rhs.d1, lhs.m12 * rhs.d2, lhs.m13 * rhs.d3,
+                    lhs.m21 * rhs.d1, lhs.m22 * rhs.d2, lhs.m23 * rhs.d3,
+                    lhs.m31 * rhs.d1, lhs.m32 * rhs.d2, lhs.m33 * rhs.d3);
+  }
+
+  // Dense sums
+  Matrix33 operator+(const DiagMatrix33& lhs, const Matrix33& rhs)
+  {
+    Matrix33 result(rhs);
+    result.m11 += lhs.d1;
+    result.m22 += lhs.d2;
+    result.m33 += lhs.d3;
+    return result;
+  }
+  Matrix33 operator+(const Matrix33& lhs, const DiagMatrix33& rhs)
+  {
+    return rhs + lhs;
+  }
+
+  DiagMatrix33 transpose(const DiagMatrix33& rhs)
+  {
+    return rhs;
+  }
+
+  double determinant(const DiagMatrix33& rhs)
+  {
+    return rhs.d1 * rhs.d2 * rhs.d3;
+  }
+
+  DiagMatrix33 inverse(const DiagMatrix33& rhs)
+  {
+    if (fabs(determinant(rhs)) > 0.0)
+      {
+        return DiagMatrix33(1.0 / rhs.d1, 1.0 / rhs.d2, 1.0 / rhs.d3);
+      }
+    return DiagMatrix33(NAN);
+  }
+
+  // Stream output
+  std::ostream& operator<<(std::ostream& os, const DiagMatrix33& obj)
+  {
+    os << "diag[" << obj.d1 << "," << obj.d2 << "," << obj.d3 << "]";
+    return os;
+  }
+
+} // namespace AML
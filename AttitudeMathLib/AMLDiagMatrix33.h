@@ -0,0 +1,126 @@
+#ifndef AML_DIAGMATRIX33_H
+#define AML_DIAGMATRIX33_H
+
+#include <iostream>
+
+namespace AML
+{
+  // Forward declarations
+  class Vector3;
+  class Matrix33;
+
+  // ============================================================
+  // DiagMatrix33
+  //
+  // Represents a 3x3 diagonal matrix by its three diagonal
+  // elements.
+  //
+  // Intended use:
+  // - Principal-axis inertia tensors
+  // - Diagonal covariances / gains
+  //
+  // Products exploit the zeros: scaling a Vector3 takes 3
+  // multiplies and scaling the rows or columns of a Matrix33
+  // takes 9 (vs 9 and 27 for the dense path).
+  // ============================================================
+  class DiagMatrix33
+  {
+  public:
+
+    // ------------------------------------------------------------
+    // Storage
+    //
+    // data[0..2] or d1, d2, d3 (the elements m11, m22, m33)
+    // ------------------------------------------------------------
+    union
+    {
+      double data[3];
+      struct { double d1, d2, d3; };
+    };
+
+    // ------------------------------------------------------------
+    // Constructors
+    // ------------------------------------------------------------
+
+    // Default constructor
+    // Initializes all elements to zero.
+    constexpr DiagMatrix33() : d1(0.0), d2(0.0), d3(0.0) {}
+
+    // Scalar constructor
+    // val * identity
+    constexpr explicit DiagMatrix33(double val) : d1(val), d2(val), d3(val) {}
+
+    // Element-wise constructor
+    constexpr DiagMatrix33(double d1_, double d2_, double d3_) : d1(d1_), d2(d2_), d3(d3_) {}
+
+    // Vector constructor
+    // Uses the components as the diagonal.
+    explicit DiagMatrix33(const Vector3& d);
+
+    // ------------------------------------------------------------
+    // Compound assignment operators
+    //
+    // Products of diagonal matrices are diagonal, so *= is exact.
+    // ------------------------------------------------------------
+    DiagMatrix33& operator+=(const DiagMatrix33& rhs);
+    DiagMatrix33& operator-=(const DiagMatrix33& rhs);
+    DiagMatrix33& operator*=(const DiagMatrix33& rhs);
+    DiagMatrix33& operator*=(double s);
+    DiagMatrix33& operator/=(double s);
+
+    // ------------------------------------------------------------
+    // Conversions
+    // ------------------------------------------------------------
+    Matrix33 toMatrix33() const;
+    Vector3 toVector3() const;
+
+    // ------------------------------------------------------------
+    // Identity matrix
+    // ------------------------------------------------------------
+    static constexpr DiagMatrix33 identity() { return DiagMatrix33(1.0, 1.0, 1.0); }
+
+  }; // class DiagMatrix33
+
+  // ============================================================
+  // Operators
+  // ============================================================
+  DiagMatrix33 operator-(const DiagMatrix33& rhs);
+  DiagMatrix33 operator+(const DiagMatrix33& lhs, const DiagMatrix33& rhs);
+  DiagMatrix33 operator-(const DiagMatrix33& lhs, const DiagMatrix33& rhs);
+  DiagMatrix33 operator*(const DiagMatrix33& lhs, const DiagMatrix33& rhs);
+  DiagMatrix33 operator*(const DiagMatrix33& lhs, double s);
+  DiagMatrix33 operator*(double s, const DiagMatrix33& rhs);
+  DiagMatrix33 operator/(const DiagMatrix33& lhs, double s);
+
+  // Scales each component (3 multiplies)
+  Vector3 operator*(const DiagMatrix33& lhs, const Vector3& rhs);
+
+  // Scales the rows (D * M) or the columns (M * D), 9 multiplies
+  Matrix33 operator*(const DiagMatrix33& lhs, const Matrix33& rhs);
+  Matrix33 operator*(const Matrix33& lhs, const DiagMatrix33& rhs);
+
+  // Dense sums
+  Matrix33 operator+(const DiagMatrix33& lhs, const Matrix33& rhs);
+  Matrix33 operator+(const Matrix33& lhs, const DiagMatrix33& rhs);
+
+  // ============================================================
+  // Utility functions
+  // ============================================================
+
+  // Diagonal matrices are their own transpose
+  DiagMatrix33 transpose(const DiagMatrix33& rhs);
+
+  // Product of the diagonal
+  double determinant(const DiagMatrix33& rhs);
+
+  // Element-wise reciprocal.
+  // Returns NaN elements when a diagonal element is zero,
+  // like inverse(const Matrix33&).
+  DiagMatrix33 inverse(const DiagMatrix33& rhs);
+
+  // Stream output
+  std::ostream& operator<<(std::ostream& os, const DiagMatrix33& obj);
+
+} // namespace AML
+
+#endif // AML_DIAGMATRIX33_H
@@ -0,0 +1,304 @@
+#include "AMLFrameGraph.h"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace AML
+{
+
+  namespace
+  {
+    void checkRotation(const Matrix33& R)
+    {
+      for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+          if (!std::isfinite(R.data[i][j]))
+            throw std::invalid_argument("FrameGraph: rotation must be finite");
+    }
+  }
+
+  FrameGraph::FrameGraph()
+    : stampCounter(0)
+  {
+  }
+
+  // ------------------------------------------------------------
+  // Frames
+  // ------------------------------------------------------------
+  FrameGraph::FrameId FrameGraph::addFrame(const std::string& name_)
+  {
+    std::unique_lock<std::shared_mutex> lock = writeLock();
+    if (names.count(name_) != 0)
+      throw std::invalid_argument("FrameGraph: duplicate frame " + name_);
+
+    FrameId frame = frames.size();
+    Frame f;
+    f.name = name_;
+    f.parent = frame;
+    f.root = frame;
+    f.edge = Matrix33::identity();
+    f.version = 0;
+    f.composite = Matrix33::identity();
+    f.builtVersion = 0;
+    f.builtParentStamp = 0;
+    f.stamp = ++stampCounter;
+    frames.push_back(f);
+    names.emplace(name_, frame);
+    return frame;
+  }
+
+  FrameGraph::FrameId FrameGraph::addFrame(const std::string& name_, FrameId parent_, const Matrix33& R)
+  {
+    checkRotation(R);
+    std::unique_lock<std::shared_mutex> lock = writeLock();
+    check(parent_);
+    if (names.count(name_) != 0)
+      throw std::invalid_argument("FrameGraph: duplicate frame " + name_);
+
+    refresh(parent_);
+    const Frame& p = frames[parent_];
+    FrameId frame = frames.size();
+    Frame f;
+    f.name = name_;
+    f.parent = parent_;
+    f.root = p.root;
+    f.edge = R;
+    f.version = 0;
+    f.composite = p.composite * R;
+    f.builtVersion = 0;
+    f.builtParentStamp = p.stamp;
+    f.stamp = ++stampCounter;
+    frames.push_back(f);
+    names.emplace(name_, frame);
+    return frame;
+  }
+
+  std::size_t FrameGraph::size() const
+  {
+    std::shared_lock<std::shared_mutex> lock = readLock();
+    return frames.size();
+  }
+
+  bool FrameGraph::contains(const std::string& name_) const
+  {
+    std::shared_lock<std::shared_mutex> lock = readLock();
+    return names.count(name_) != 0;
+  }
+
+  FrameGraph::FrameId FrameGraph::id(const std::string& name_) const
+  {
+    std::shared_lock<std::shared_mutex> lock = readLock();
+    auto it = names.find(name_);
+    if (it == names.end())
+      throw std::invalid_argument("FrameGraph: unknown frame " + name_);
+    return it->second;
+  }
+
+  std::string FrameGraph::name(FrameId frame) const
+  {
+    std::shared_lock<std::shared_mutex> lock = readLock();
+    check(frame);
+    return frames[frame].name;
+  }
+
+  FrameGraph::FrameId FrameGraph::parent(FrameId frame) const
+  {
+    std::shared_lock<std::shared_mutex> lock = readLock();
+    check(frame);
+    return frames[frame].parent;
+  }
+
+  // ------------------------------------------------------------
+  // Edges
+  // ------------------------------------------------------------
+  void FrameGraph::setRotation(FrameId frame, const Matrix33& R)
+  {
+    setRotations(&frame, &R, 1);
+  }
+
+  void FrameGraph::setRotations(const FrameId* frames_, const Matrix33* R, std::size_t n)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+      checkRotation(R[i]);
+
+    std::unique_lock<std::shared_mutex> lock = writeLock();
+    // Validate everything first so a bad id leaves the graph as it was
+    for (std::size_t i = 0; i < n; ++i)
+      {
+        check(frames_[i]);
+        if (frames[frames_[i]].parent == frames_[i])
+          throw std::invalid_argument("FrameGraph: root frame " + frames[frames_[i]].name + " has no rotation");
+      }
+    for (std::size_t i = 0; i < n; ++i)
+      {
+        Frame& f = frames[frames_[i]];
+        f.edge = R[i];
+        ++f.version;
+      }
+  }
+
+  Matrix33 FrameGraph::rotation(FrameId frame) const
+  {
+    std::shared_lock<std::shared_mutex> lock = readLock();
+    check(frame);
+    return frames[frame].edge;
+  }
+
+  std::uint64_t FrameGraph::version(FrameId frame) const
+  {
+    std::shared_lock<std::shared_mutex> lock = readLock();
+    check(frame);
+    return frames[frame].version;
+  }
+
+  // ------------------------------------------------------------
+  // Queries
+  //
+  // Fast path: both chains valid, answered under the shared lock.
+  // Otherwise the lock is retaken exclusively and the stale
+  // composites rebuilt. Frames are never removed, so ids checked
+  // under the first lock stay valid under the second.
+  // ------------------------------------------------------------
+  Matrix33 FrameGraph::transform(FrameId from, FrameId to) const
+  {
+    {
+      std::shared_lock<std::shared_mutex> lock = readLock();
+      checkConnected(from, to);
+      if (fresh(from) && fresh(to))
+        return compose(from, to);
+    }
+    std::unique_lock<std::shared_mutex> lock = writeLock();
+    refresh(from);
+    refresh(to);
+    return compose(from, to);
+  }
+
+  Matrix33 FrameGraph::transform(const std::string& from, const std::string& to) const
+  {
+    return transform(id(from), id(to));
+  }
+
+  void FrameGraph::transforms(const FrameId* from, const FrameId* to, Matrix33* out, std::size_t n) const
+  {
+    {
+      std::shared_lock<std::shared_mutex> lock = readLock();
+      bool stale = false;
+      for (std::size_t i = 0; i < n; ++i)
+        {
+          checkConnected(from[i], to[i]);
+          stale = stale || !fresh(from[i]) || !fresh(to[i]);
+        }
+      if (!stale)
+        {
+          for (std::size_t i = 0; i < n; ++i)
+            out[i] = compose(from[i], to[i]);
+          return;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock = writeLock();
+    for (std::size_t i = 0; i < n; ++i)
+      {
+        refresh(from[i]);
+        refresh(to[i]);
+        out[i] = compose(from[i], to[i]);
+      }
+  }
+
+  Matrix33 FrameGraph::toRoot(FrameId frame) const
+  {
+    {
+      std::shared_lock<std::shared_mutex> lock = readLock();
+      check(frame);
+      if (fresh(frame))
+        return frames[frame].composite;
+    }
+    std::unique_lock<std::shared_mutex> lock = writeLock();
+    refresh(frame);
+    return frames[frame].composite;
+  }
+
+  // ------------------------------------------------------------
+  // Locking
+  //
+  // std::shared_mutex may prefer readers (glibc does), which lets
+  // back-to-back queries starve updates. A writer holds the
+  // turnstile while it waits for the exclusive lock; readers pass
+  // through the turnstile before taking the shared lock, so new
+  // readers block behind a waiting writer while those already
+  // holding the lock finish.
+  // ------------------------------------------------------------
+  std::shared_lock<std::shared_mutex> FrameGraph::readLock() const
+  {
+    {
+      std::lock_guard<std::mutex> gate(turnstile);
+    }
+    return std::shared_lock<std::shared_mutex>(mutex);
+  }
+
+  std::unique_lock<std::shared_mutex> FrameGraph::writeLock() const
+  {
+    std::lock_guard<std::mutex> gate(turnstile);
+    return std::unique_lock<std::shared_mutex>(mutex);
+  }
+
+  // ------------------------------------------------------------
+  // Helpers (caller holds the lock)
+  // ------------------------------------------------------------
+  void FrameGraph::check(FrameId frame) const
+  {
+    if (frame >= frames.size())
+      throw std::out_of_range("FrameGraph: unknown frame id " + std::to_string(frame));
+  }
+
+  void FrameGraph::checkConnected(FrameId from, FrameId to) const
+  {
+    check(from);
+    check(to);
+    if (frames[from].root != frames[to].root)
+      throw std::invalid_argument("FrameGraph: frames " + frames[from].name + " and "
+                                  + frames[to].name + " are not connected");
+  }
+
+  // A composite is valid when it was built from the current edge
+  // and the current composite of its parent, and so on up to the
+  // root (roots never change)
+  bool FrameGraph::fresh(FrameId frame) const
+  {
+    for (FrameId k = frame; frames[k].parent != k; k = frames[k].parent)
+      {
+        const Frame& f = frames[k];
+        if (f.builtVersion != f.version || f.builtParentStamp != frames[f.parent].stamp)
+          return false;
+      }
+    return true;
+  }
+
+  // Rebuilds the stale composites on the chain from the root down
+  // to frame; each rebuilt composite gets a new stamp so that its
+  // descendants see the change. Needs the exclusive lock.
+  void FrameGraph::refresh(FrameId frame) const
+  {
+    Frame& f = frames[frame];
+    if (f.parent == frame)
+      return;
+    refresh(f.parent);
+
+    const Frame& p = frames[f.parent];
+    if (f.builtVersion != f.version || f.builtParentStamp != p.stamp)
+      {
+        f.composite = p.composite * f.edge;
+        f.builtVersion = f.version;
+        f.builtParentStamp = p.stamp;
+        f.stamp = ++stampCounter;
+      }
+  }
+
+  // v_to = C_to^T * C_from * v_from, C the composites to the root
+  Matrix33 FrameGraph::compose(FrameId from, FrameId to) const
+  {
+    if (from == to)
+      return Matrix33::identity();
+    return transpose(frames[to].composite) * frames[from].composite;
+  }
+
+} // namespace AML
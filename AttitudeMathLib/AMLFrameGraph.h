@@ -0,0 +1,140 @@
+#ifndef AML_FRAMEGRAPH_H
+#define AML_FRAMEGRAPH_H
+
+#include "AMLMatrix33.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace AML
+{
+  // ============================================================
+  // FrameGraph
+  //
+  // Named reference frames (inertial, body, IMU, camera, sensor
+  // mounts, ...) connected by rotations. Each frame except a root
+  // has one parent; its edge rotation R maps vectors in frame
+  // coordinates to parent coordinates (v_parent = R * v_frame).
+  // The frames form a forest, so the transform between two frames
+  // of the same tree is unique.
+  //
+  // Each edge carries a version counter that setRotation()
+  // increments. Every frame caches its composite rotation to the
+  // root of its tree, stamped with the edge version and the parent
+  // composite it was built from. A query revalidates the two
+  // chains (comparisons only) and recomputes just the composites
+  // whose edge, or an ancestor's edge, changed since they were
+  // last built; the result is then one product of cached
+  // composites.
+  //
+  // Thread safety: all members may be called concurrently.
+  // Queries over valid caches run in parallel under a shared lock;
+  // updates, and queries that find stale composites, take it
+  // exclusively. Updates are O(1): composites are rebuilt lazily
+  // by the next query that needs them. A waiting writer blocks
+  // queries that arrive after it (they sleep, not spin) until it
+  // has had its turn, so it only waits for the queries already in
+  // progress and for writers ahead of it.
+  //
+  // Errors: unknown frame ids std::out_of_range, duplicate or
+  // unknown names, non-finite rotations and queries between frames
+  // of different trees std::invalid_argument. Rotations are used
+  // as given (not re-orthonormalized).
+  // ============================================================
+  class FrameGraph
+  {
+  public:
+    using FrameId = std::size_t;
+
+    FrameGraph();
+
+    FrameGraph(const FrameGraph&) = delete;
+    FrameGraph& operator=(const FrameGraph&) = delete;
+
+    // ------------------------------------------------------------
+    // Frames
+    //
+    // addFrame(name) adds a root; addFrame(name, parent, R) a
+    // child of parent with edge rotation R (v_parent = R * v).
+    // ------------------------------------------------------------
+    FrameId addFrame(const std::string& name);
+    FrameId addFrame(const std::string& name, FrameId parent, const Matrix33& R);
+
+    std::size_t size() const;
+    bool contains(const std::string& name) const;
+    FrameId id(const std::string& name) const;
+    std::string name(FrameId frame) const;
+
+    // Parent of a frame; a root is its own parent
+    FrameId parent(FrameId frame) const;
+
+    // ------------------------------------------------------------
+    // Edges
+    //
+    // setRotation replaces the edge rotation of a non-root frame
+    // and increments its version; the batch form applies n updates
+    // under one lock. version() counts the updates of a frame's
+    // edge (0 for a root and for a frame never updated).
+    // ------------------------------------------------------------
+    void setRotation(FrameId frame, const Matrix33& R);
+    void setRotations(const FrameId* frames, const Matrix33* R, std::size_t n);
+
+    Matrix33 rotation(FrameId frame) const;
+    std::uint64_t version(FrameId frame) const;
+
+    // ------------------------------------------------------------
+    // Queries
+    //
+    // transform(from, to) maps vectors in "from" coordinates to
+    // "to" coordinates: v_to = transform(from, to) * v_from. The
+    // batch form answers n queries under one lock.
+    // ------------------------------------------------------------
+    Matrix33 transform(FrameId from, FrameId to) const;
+    Matrix33 transform(const std::string& from, const std::string& to) const;
+    void transforms(const FrameId* from, const FrameId* to, Matrix33* out, std::size_t n) const;
+
+    // Composite rotation of a frame to the root of its tree
+    // (v_root = toRoot(frame) * v_frame)
+    Matrix33 toRoot(FrameId frame) const;
+
+  private:
+    struct Frame
+    {
+      std::string name;
+      FrameId parent;
+      FrameId root;
+      Matrix33 edge;
+      std::uint64_t version;
+
+      // Cached composite to the root and what it was built from
+      Matrix33 composite;
+      std::uint64_t builtVersion;
+      std::uint64_t builtParentStamp;
+      std::uint64_t stamp;
+    };
+
+    std::shared_lock<std::shared_mutex> readLock() const;
+    std::unique_lock<std::shared_mutex> writeLock() const;
+
+    void check(FrameId frame) const;
+    void checkConnected(FrameId from, FrameId to) const;
+    bool fresh(FrameId frame) const;
+    void refresh(FrameId frame) const;
+    Matrix33 compose(FrameId from, FrameId to) const;
+
+    mutable std::shared_mutex mutex;
+    mutable std::mutex turnstile;
+    mutable std::vector<Frame> frames;
+    mutable std::uint64_t stampCounter;
+    std::unordered_map<std::string, FrameId> names;
+
+  }; // class FrameGraph
+
+} // namespace AML
+
+#endif // AML_FRAMEGRAPH_H
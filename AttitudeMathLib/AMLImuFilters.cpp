@@ -0,0 +1,513 @@
+#include "AMLImuFilters.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace AML
+{
+
+  namespace
+  {
+    void checkSizes(const char* filter, std::size_t imu, std::size_t sensors)
+    {
+      if (imu != sensors)
+        throw std::invalid_argument(std::string(filter) + ": IMU batch has " + std::to_string(imu)
+                                    + " samples for " + std::to_string(sensors) + " sensors");
+    }
+
+    void checkSizes(const char* filter, ConstVector3View gyro, ConstVector3View accel, ConstVector3View mag,
+                    bool useMagnetometer, std::size_t sensors)
+    {
+      checkSizes(filter, gyro.size(), sensors);
+      checkSizes(filter, accel.size(), sensors);
+      if (useMagnetometer)
+        checkSizes(filter, mag.size(), sensors);
+    }
+
+    // 1 / |v|, or 0 for a zero vector. Both operands are selected
+    // before the divide so the kernels below stay branch-free and
+    // vectorize.
+    inline double invNorm(double x, double y, double z)
+    {
+      double n = std::sqrt(x * x + y * y + z * z);
+      return ((n > 0.0) ? 1.0 : 0.0) / ((n > 0.0) ? n : 1.0);
+    }
+
+    inline double invNorm(double w, double x, double y, double z)
+    {
+      double n = std::sqrt(w * w + x * x + y * y + z * z);
+      return ((n > 0.0) ? 1.0 : 0.0) / ((n > 0.0) ? n : 1.0);
+    }
+
+    // ------------------------------------------------------------
+    // Kernel inputs: the ImuBatch arrays (unit stride, so the
+    // loops vectorize) or three strided views over external
+    // buffers. Without the magnetometer the m* accessors are never
+    // called.
+    // ------------------------------------------------------------
+    struct BatchInput
+    {
+      const double* __restrict g[3];
+      const double* __restrict a[3];
+      const double* __restrict m[3];
+
+      explicit BatchInput(const ImuBatch& imu) :
+        g{imu.gx.data(), imu.gy.data(), imu.gz.data()},
+        a{imu.ax.data(), imu.ay.data(), imu.az.data()},
+        m{imu.mx.data(), imu.my.data(), imu.mz.data()}
+      {}
+
+      double gx(std::size_t i) const { return g[0][i]; }
+      double gy(std::size_t i) const { return g[1][i]; }
+      double gz(std::size_t i) const { return g[2][i]; }
+      double ax(std::size_t i) const { return a[0][i]; }
+      double ay(std::size_t i) const { return a[1][i]; }
+      double az(std::size_t i) const { return a[2][i]; }
+      double mx(std::size_t i) const { return m[0][i]; }
+      double my(std::size_t i) const { return m[1][i]; }
+      double mz(std::size_t i) const { return m[2][i]; }
+    };
+
+    struct ViewInput
+    {
+      ConstVector3View g;
+      ConstVector3View a;
+      ConstVector3View m;
+
+      double gx(std::size_t i) const { return g(i, 0); }
+      double gy(std::size_t i) const { return g(i, 1); }
+      double gz(std::size_t i) const { return g(i, 2); }
+      double ax(std::size_t i) const { return a(i, 0); }
+      double ay(std::size_t i) const { return a(i, 1); }
+      double az(std::size_t i) const { return a(i, 2); }
+      double mx(std::size_t i) const { return m(i, 0); }
+      double my(std::size_t i) const { return m(i, 1); }
+      double mz(std::size_t i) const { return m(i, 2); }
+    };
+
+    // ------------------------------------------------------------
+    // Mahony kernel
+    // ------------------------------------------------------------
+    template <bool UseMag, typename Input>
+    void mahonyKernel(std::size_t n, double dt, double twoKp, double twoKi, const Input& imu,
+                      double* __restrict q0, double* __restrict q1,
+                      double* __restrict q2, double* __restrict q3,
+                      double* __restrict ix, double* __restrict iy, double* __restrict iz)
+    {
+      for (std::size_t i = 0; i < n; ++i)
+        {
+          double a = q0[i], b = q1[i], c = q2[i], d = q3[i];
+          double gx = imu.gx(i), gy = imu.gy(i), gz = imu.gz(i);
+
+          double ra = invNorm(imu.ax(i), imu.ay(i), imu.az(i));
+          double ax = imu.ax(i) * ra, ay = imu.ay(i) * ra, az = imu.az(i) * ra;
+          double valid = (ra > 0.0) ? 1.0 : 0.0;
+
+          // Estimated direction of gravity (half)
+          double halfvx = b * d - a * c;
+          double halfvy = a * b + c * d;
+          double halfvz = a * a - 0.5 + d * d;
+
+          double ex = ay * halfvz - az * halfvy;
+          double ey = az * halfvx - ax * halfvz;
+          double ez = ax * halfvy - ay * halfvx;
+
+          if constexpr (UseMag)
+            {
+              double rm = invNorm(imu.mx(i), imu.my(i), imu.mz(i));
+              double mx = imu.mx(i) * rm, my = imu.my(i) * rm, mz = imu.mz(i) * rm;
+
+              // Reference direction of the earth's field
+              double hx = 2.0 * (mx * (0.5 - c * c - d * d) + my * (b * c - a * d) + mz * (b * d + a * c));
+              double hy = 2.0 * (mx * (b * c + a * d) + my * (0.5 - b * b - d * d) + mz * (c * d - a * b));
+              double bx = std::sqrt(hx * hx + hy * hy);
+              double bz = 2.0 * (mx * (b * d - a * c) + my * (c * d + a * b) + mz * (0.5 - b * b - c * c));
+
+              // Estimated direction of the field (half)
+              double halfwx = bx * (0.5 - c * c - d * d) + bz * (b * d - a * c);
+              double halfwy = bx * (b * c - a * d) + bz * (a * b + c * d);
+              double halfwz = bx * (a * c + b * d) + bz * (0.5 - b * b - c * c);
+
+              ex += my * halfwz - mz * halfwy;
+              ey += mz * halfwx - mx * halfwz;
+              ez += mx * halfwy - my * halfwx;
+            }
+
+          ex *= valid;
+          ey *= valid;
+          ez *= valid;
+
+          // Integral feedback (gyro bias)
+          ix[i] += twoKi * ex * dt;
+          iy[i] += twoKi * ey * dt;
+          iz[i] += twoKi * ez * dt;
+
+          gx = (gx + ix[i] + twoKp * ex) * (0.5 * dt);
+          gy = (gy + iy[i] + twoKp * ey) * (0.5 * dt);
+          gz = (gz + iz[i] + twoKp * ez) * (0.5 * dt);
+
+          double na = a - b * gx - c * gy - d * gz;
+          double nb = b + a * gx + c * gz - d * gy;
+          double nc = c + a * gy - b * gz + d * gx;
+          double nd = d + a * gz + b * gy - c * gx;
+
+          double rq = invNorm(na, nb, nc, nd);
+          q0[i] = na * rq;
+          q1[i] = nb * rq;
+          q2[i] = nc * rq;
+          q3[i] = nd * rq;
+        }
+    }
+
+    // ------------------------------------------------------------
+    // Madgwick kernel
+    // ------------------------------------------------------------
+    template <bool UseMag, typename Input>
+    void madgwickKernel(std::size_t n, double dt, double beta, const Input& imu,
+                        double* __restrict q0, double* __restrict q1,
+                        double* __restrict q2, double* __restrict q3)
+    {
+      for (std::size_t i = 0; i < n; ++i)
+        {
+          double a = q0[i], b = q1[i], c = q2[i], d = q3[i];
+          double gx = imu.gx(i), gy = imu.gy(i), gz = imu.gz(i);
+
+          // Rate of change from the gyro
+          double qDot0 = 0.5 * (-b * gx - c * gy - d * gz);
+          double qDot1 = 0.5 * (a * gx + c * gz - d * gy);
+          double qDot2 = 0.5 * (a * gy - b * gz + d * gx);
+          double qDot3 = 0.5 * (a * gz + b * gy - c * gx);
+
+          double ra = invNorm(imu.ax(i), imu.ay(i), imu.az(i));
+          double ax = imu.ax(i) * ra, ay = imu.ay(i) * ra, az = imu.az(i) * ra;
+          double valid = (ra > 0.0) ? 1.0 : 0.0;
+
+          double s0, s1, s2, s3;
+          if constexpr (UseMag)
+            {
+              double rm = invNorm(imu.mx(i), imu.my(i), imu.mz(i));
+              double mx = imu.mx(i) * rm, my = imu.my(i) * rm, mz = imu.mz(i) * rm;
+
+              double _2amx = 2.0 * a * mx;
+              double _2amy = 2.0 * a * my;
+              double _2amz = 2.0 * a * mz;
+              double _2bmx = 2.0 * b * mx;
+              double _2a = 2.0 * a, _2b = 2.0 * b, _2c = 2.0 * c, _2d = 2.0 * d;
+              double _2ac = 2.0 * a * c;
+              double _2cd = 2.0 * c * d;
+              double aa = a * a, ab = a * b, ac = a * c, ad = a * d;
+              double bb = b * b, bc = b * c, bd = b * d;
+              double cc = c * c, cd = c * d, dd = d * d;
+
+              // Reference direction of the earth's field
+              double hx = mx * aa - _2amy * d + _2amz * c + mx * bb + _2b * my * c + _2b * mz * d - mx * cc - mx * dd;
+              double hy = _2amx * d + my * aa - _2amz * b + _2bmx * c - my * bb + my * cc + _2c * mz * d - my * dd;
+              double _2bx = std::sqrt(hx * hx + hy * hy);
+              double _2bz = -_2amx * c + _2amy * b + mz * aa + _2bmx * d - mz * bb + _2c * my * d - mz * cc + mz * dd;
+              double _4bx = 2.0 * _2bx;
+              double _4bz = 2.0 * _2bz;
+
+              // Objective function residuals
+              double fax = 2.0 * bd - _2ac - ax;
+              double fay = 2.0 * ab + _2cd - ay;
+              double faz = 1.0 - 2.0 * bb - 2.0 * cc - az;
+              double fmx = _2bx * (0.5 - cc - dd) + _2bz * (bd - ac) - mx;
+              double fmy = _2bx * (bc - ad) + _2bz * (ab + cd) - my;
+              double fmz = _2bx * (ac + bd) + _2bz * (0.5 - bb - cc) - mz;
+
+              // Gradient (Jacobian transpose times residuals)
+              s0 = -_2c * fax + _2b * fay - _2bz * c * fmx + (-_2bx * d + _2bz * b) * fmy + _2bx * c * fmz;
+              s1 = _2d * fax + _2a * fay - 4.0 * b * faz + _2bz * d * fmx + (_2bx * c + _2bz * a) * fmy + (_2bx * d - _4bz * b) * fmz;
+              s2 = -_2a * fax + _2d * fay - 4.0 * c * faz + (-_4bx * c - _2bz * a) * fmx + (_2bx * b + _2bz * d) * fmy + (_2bx * a - _4bz * c) * fmz;
+              s3 = _2b * fax + _2c * fay + (-_4bx * d + _2bz * b) * fmx + (-_2bx * a + _2bz * c) * fmy + _2bx * b * fmz;
+            }
+          else
+            {
+              double _2a = 2.0 * a, _2b = 2.0 * b, _2c = 2.0 * c, _2d = 2.0 * d;
+              double _4a = 4.0 * a, _4b = 4.0 * b, _4c = 4.0 * c;
+              double _8b = 8.0 * b, _8c = 8.0 * c;
+              double aa = a * a, bb = b * b, cc = c * c, dd = d * d;
+
+              s0 = _4a * cc + _2c * ax + _4a * bb - _2b * ay;
+              s1 = _4b * dd - _2d * ax + 4.0 * aa * b - _2a * ay - _4b + _8b * bb + _8b * cc + _4b * az;
+              s2 = 4.0 * aa * c + _2a * ax + _4c * dd - _2d * ay - _4c + _8c * bb + _8c * cc + _4c * az;
+              s3 = 4.0 * bb * d - _2b * ax + 4.0 * cc * d - _2c * ay;
+            }
+
+          double rs = invNorm(s0, s1, s2, s3) * beta * valid;
+          qDot0 -= s0 * rs;
+          qDot1 -= s1 * rs;
+          qDot2 -= s2 * rs;
+          qDot3 -= s3 * rs;
+
+          double na = a + qDot0 * dt;
+          double nb = b + qDot1 * dt;
+          double nc = c + qDot2 * dt;
+          double nd = d + qDot3 * dt;
+
+          double rq = invNorm(na, nb, nc, nd);
+          q0[i] = na * rq;
+          q1[i] = nb * rq;
+          q2[i] = nc * rq;
+          q3[i] = nd * rq;
+        }
+    }
+
+    // ------------------------------------------------------------
+    // Complementary kernel
+    // ------------------------------------------------------------
+    template <bool UseMag, typename Input>
+    void complementaryKernel(std::size_t n, double dt, double accelGain, double magGain, const Input& imu,
+                             double* __restrict q0, double* __restrict q1,
+                             double* __restrict q2, double* __restrict q3)
+    {
+      const double eps = 1e-12;
+
+      for (std::size_t i = 0; i < n; ++i)
+        {
+          // Gyro propagation: q + 0.5 * dt * q * (0, w)
+          double hx = 0.5 * dt * imu.gx(i), hy = 0.5 * dt * imu.gy(i), hz = 0.5 * dt * imu.gz(i);
+          double a = q0[i], b = q1[i], c = q2[i], d = q3[i];
+          double pa = a - b * hx - c * hy - d * hz;
+          double pb = b + a * hx + c * hz - d * hy;
+          double pc = c + a * hy - b * hz + d * hx;
+          double pd = d + a * hz + b * hy - c * hx;
+          double rp = invNorm(pa, pb, pc, pd);
+          a = pa * rp; b = pb * rp; c = pc * rp; d = pd * rp;
+
+          // Tilt: rotate the measured gravity direction into the
+          // earth frame and take the shortest arc onto +z.
+          double ra = invNorm(imu.ax(i), imu.ay(i), imu.az(i));
+          double ax = imu.ax(i) * ra, ay = imu.ay(i) * ra, az = imu.az(i) * ra;
+          double gex = (a * a + b * b - c * c - d * d) * ax + 2.0 * (b * c - a * d) * ay + 2.0 * (b * d + a * c) * az;
+          double gey = 2.0 * (b * c + a * d) * ax + (a * a - b * b + c * c - d * d) * ay + 2.0 * (c * d - a * b) * az;
+          double gez = 2.0 * (b * d - a * c) * ax + 2.0 * (c * d + a * b) * ay + (a * a - b * b - c * c + d * d) * az;
+
+          // Upside down: the arc is 180 degrees about x
+          bool flipped = (1.0 + gez) < eps;
+          double t0 = flipped ? 0.0 : 1.0 + gez;
+          double t1 = flipped ? 1.0 : gey;
+          double t2 = flipped ? 0.0 : -gex;
+          double rt = invNorm(t0, t1, t2, 0.0);
+
+          // Fractional correction: blend towards identity
+          double ka = (ra > 0.0) ? accelGain : 0.0;
+          double e0 = (1.0 - ka) + ka * t0 * rt;
+          double e1 = ka * t1 * rt;
+          double e2 = ka * t2 * rt;
+          double re = invNorm(e0, e1, e2, 0.0);
+          e0 *= re; e1 *= re; e2 *= re;
+
+          double ta = e0 * a - e1 * b - e2 * c;
+          double tb = e0 * b + e1 * a + e2 * d;
+          double tc = e0 * c - e1 * d + e2 * a;
+          double td = e0 * d + e1 * c - e2 * b;
+          a = ta; b = tb; c = tc; d = td;
+
+          if constexpr (UseMag)
+            {
+              // Heading: rotate the horizontal projection of the
+              // field onto +x about the earth z axis.
+              double mx = imu.mx(i), my = imu.my(i), mz = imu.mz(i);
+              double lx = (a * a + b * b - c * c - d * d) * mx + 2.0 * (b * c - a * d) * my + 2.0 * (b * d + a * c) * mz;
+              double ly = 2.0 * (b * c + a * d) * mx + (a * a - b * b + c * c - d * d) * my + 2.0 * (c * d - a * b) * mz;
+
+              double gamma = lx * lx + ly * ly;
+              double sg = std::sqrt(gamma);
+              double k = gamma + lx * sg;
+
+              // Pointing due south (k ~ 0) the correction is 180
+              // degrees; selects are taken after the arithmetic so the
+              // loop has no branches.
+              bool level = gamma > eps;
+              bool south = k <= eps * gamma;
+              double kSafe = south ? 1.0 : k;
+              double h0 = std::sqrt(kSafe / (2.0 * (level ? gamma : 1.0)));
+              double h3 = -ly / std::sqrt(2.0 * kSafe);
+              h0 = south ? 0.0 : h0;
+              h3 = south ? 1.0 : h3;
+
+              double km = level ? magGain : 0.0;
+              double f0 = (1.0 - km) + km * h0;
+              double f3 = km * h3;
+              double rf = invNorm(f0, 0.0, 0.0, f3);
+              f0 *= rf; f3 *= rf;
+
+              ta = f0 * a - f3 * d;
+              tb = f0 * b - f3 * c;
+              tc = f0 * c + f3 * b;
+              td = f0 * d + f3 * a;
+              a = ta; b = tb; c = tc; d = td;
+            }
+
+          double rq = invNorm(a, b, c, d);
+          q0[i] = a * rq;
+          q1[i] = b * rq;
+          q2[i] = c * rq;
+          q3[i] = d * rq;
+        }
+    }
+  }
+
+  // ============================================================
+  // ImuBatch
+  // ============================================================
+
+  ImuBatch::ImuBatch(std::size_t count)
+  {
+    resize(count);
+  }
+
+  void ImuBatch::resize(std::size_t count)
+  {
+    gx.resize(count); gy.resize(count); gz.resize(count);
+    ax.resize(count); ay.resize(count); az.resize(count);
+    mx.resize(count); my.resize(count); mz.resize(count);
+  }
+
+  std::size_t ImuBatch::size() const
+  {
+    return gx.size();
+  }
+
+  void ImuBatch::set(std::size_t i, const Vector3& gyro, const Vector3& accel, const Vector3& mag)
+  {
+    gx[i] = gyro.x; gy[i] = gyro.y; gz[i] = gyro.z;
+    ax[i] = accel.x; ay[i] = accel.y; az[i] = accel.z;
+    mx[i] = mag.x; my[i] = mag.y; mz[i] = mag.z;
+  }
+
+  // ============================================================
+  // AttitudeFilterBatch
+  // ============================================================
+
+  AttitudeFilterBatch::AttitudeFilterBatch(std::size_t count) :
+    q0(count, 1.0), q1(count, 0.0), q2(count, 0.0), q3(count, 0.0)
+  {}
+
+  std::size_t AttitudeFilterBatch::size() const
+  {
+    return q0.size();
+  }
+
+  Quaternion AttitudeFilterBatch::attitude(std::size_t i) const
+  {
+    return Quaternion(q0[i], q1[i], q2[i], q3[i]);
+  }
+
+  Matrix33 AttitudeFilterBatch::dcm(std::size_t i) const
+  {
+    return quat2dcm(attitude(i));
+  }
+
+  void AttitudeFilterBatch::setAttitude(std::size_t i, const Quaternion& q)
+  {
+    Quaternion u = unit(q);
+    q0[i] = u.q0;
+    q1[i] = u.q1;
+    q2[i] = u.q2;
+    q3[i] = u.q3;
+  }
+
+  // ============================================================
+  // MahonyFilterBatch
+  // ============================================================
+
+  MahonyFilterBatch::MahonyFilterBatch(std::size_t count, double kp_, double ki_) :
+    AttitudeFilterBatch(count), kp(kp_), ki(ki_),
+    ix(count, 0.0), iy(count, 0.0), iz(count, 0.0)
+  {}
+
+  void MahonyFilterBatch::update(const ImuBatch& imu, double dt, bool useMagnetometer)
+  {
+    checkSizes("MahonyFilterBatch", imu.size(), size());
+    const std::size_t n = size();
+    if (useMagnetometer)
+      mahonyKernel<true>(n, dt, 2.0 * kp, 2.0 * ki, BatchInput(imu), q0.data(), q1.data(), q2.data(), q3.data(),
+                         ix.data(), iy.data(), iz.data());
+    else
+      mahonyKernel<false>(n, dt, 2.0 * kp, 2.0 * ki, BatchInput(imu), q0.data(), q1.data(), q2.data(), q3.data(),
+                          ix.data(), iy.data(), iz.data());
+  }
+
+  void MahonyFilterBatch::update(ConstVector3View gyro, ConstVector3View accel, ConstVector3View mag,
+                                 double dt, bool useMagnetometer)
+  {
+    checkSizes("MahonyFilterBatch", gyro, accel, mag, useMagnetometer, size());
+    const std::size_t n = size();
+    const ViewInput imu{gyro, accel, mag};
+    if (useMagnetometer)
+      mahonyKernel<true>(n, dt, 2.0 * kp, 2.0 * ki, imu, q0.data(), q1.data(), q2.data(), q3.data(),
+                         ix.data(), iy.data(), iz.data());
+    else
+      mahonyKernel<false>(n, dt, 2.0 * kp, 2.0 * ki, imu, q0.data(), q1.data(), q2.data(), q3.data(),
+                          ix.data(), iy.data(), iz.data());
+  }
+
+  Vector3 MahonyFilterBatch::integralError(std::size_t i) const
+  {
+    return Vector3(ix[i], iy[i], iz[i]);
+  }
+
+  // ============================================================
+  // MadgwickFilterBatch
+  // ============================================================
+
+  MadgwickFilterBatch::MadgwickFilterBatch(std::size_t count, double beta_) :
+    AttitudeFilterBatch(count), beta(beta_)
+  {}
+
+  void MadgwickFilterBatch::update(const ImuBatch& imu, double dt, bool useMagnetometer)
+  {
+    checkSizes("MadgwickFilterBatch", imu.size(), size());
+    const std::size_t n = size();
+    if (useMagnetometer)
+      madgwickKernel<true>(n, dt, beta, BatchInput(imu), q0.data(), q1.data(), q2.data(), q3.data());
+    else
+      madgwickKernel<false>(n, dt, beta, BatchInput(imu), q0.data(), q1.data(), q2.data(), q3.data());
+  }
+
+  void MadgwickFilterBatch::update(ConstVector3View gyro, ConstVector3View accel, ConstVector3View mag,
+                                   double dt, bool useMagnetometer)
+  {
+    checkSizes("MadgwickFilterBatch", gyro, accel, mag, useMagnetometer, size());
+    const std::size_t n = size();
+    const ViewInput imu{gyro, accel, mag};
+    if (useMagnetometer)
+      madgwickKernel<true>(n, dt, beta, imu, q0.data(), q1.data(), q2.data(), q3.data());
+    else
+      madgwickKernel<false>(n, dt, beta, imu, q0.data(), q1.data(), q2.data(), q3.data());
+  }
+
+  // ============================================================
+  // ComplementaryFilterBatch
+  // ============================================================
+
+  ComplementaryFilterBatch::ComplementaryFilterBatch(std::size_t count, double accelGain_, double magGain_) :
+    AttitudeFilterBatch(count), accelGain(accelGain_), magGain(magGain_)
+  {}
+
+  void ComplementaryFilterBatch::update(const ImuBatch& imu, double dt, bool useMagnetometer)
+  {
+    checkSizes("ComplementaryFilterBatch", imu.size(), size());
+    const std::size_t n = size();
+    if (useMagnetometer)
+      complementaryKernel<true>(n, dt, accelGain, magGain, BatchInput(imu), q0.data(), q1.data(), q2.data(), q3.data());
+    else
+      complementaryKernel<false>(n, dt, accelGain, magGain, BatchInput(imu), q0.data(), q1.data(), q2.data(), q3.data());
+  }
+
+  void ComplementaryFilterBatch::update(ConstVector3View gyro, ConstVector3View accel, ConstVector3View mag,
+                                        double dt, bool useMagnetometer)
+  {
+    checkSizes("ComplementaryFilterBatch", gyro, accel, mag, useMagnetometer, size());
+    const std::size_t n = size();
+    const ViewInput imu{gyro, accel, mag};
+    if (useMagnetometer)
+      complementaryKernel<true>(n, dt, accelGain, magGain, imu, q0.data(), q1.data(), q2.data(), q3.data());
+    else
+      complementaryKernel<false>(n, dt, accelGain, magGain, imu, q0.data(), q1.data(), q2.data(), q3.data());
+  }
+
+} // namespace AML
@@ -0,0 +1,153 @@
+#ifndef AML_IMUFILTERS_H
+#define AML_IMUFILTERS_H
+
+#include "AMLVector3.h"
+#include "AMLMatrix33.h"
+#include "AMLQuaternion.h"
+#include "AMLStridedView.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace AML
+{
+  // ============================================================
+  // ImuBatch
+  //
+  // One tick of IMU samples for N sensors, stored as structure of
+  // arrays (one array per component) so the filter kernels can
+  // process several sensors per SIMD instruction.
+  //
+  // - g*: angular rate in rad/s (body frame)
+  // - a*: specific force, any unit (only its direction is used)
+  // - m*: magnetic field, any unit (only its direction is used)
+  //
+  // Samples already held in another buffer (e.g. interleaved
+  // driver records) are passed to the filters through the
+  // ConstVector3View overloads of update() instead of being
+  // copied in here.
+  // ============================================================
+  struct ImuBatch
+  {
+    std::vector<double> gx, gy, gz;
+    std::vector<double> ax, ay, az;
+    std::vector<double> mx, my, mz;
+
+    explicit ImuBatch(std::size_t count = 0);
+
+    void resize(std::size_t count);
+    std::size_t size() const;
+
+    // Writes the sample of sensor i
+    void set(std::size_t i, const Vector3& gyro, const Vector3& accel, const Vector3& mag);
+  };
+
+  // ============================================================
+  // AttitudeFilterBatch
+  //
+  // Quaternion state shared by the batched filters below, one
+  // array per component. Each attitude q rotates body-frame
+  // vectors into the earth frame (x north, z up), so
+  // quat2dcm(attitude(i)) * accel_i is close to +z at rest.
+  // ============================================================
+  class AttitudeFilterBatch
+  {
+  public:
+    explicit AttitudeFilterBatch(std::size_t count);
+
+    // Number of sensors
+    std::size_t size() const;
+
+    // Attitude of sensor i
+    Quaternion attitude(std::size_t i) const;
+    Matrix33 dcm(std::size_t i) const;
+
+    // Overrides the attitude of sensor i (normalized on write)
+    void setAttitude(std::size_t i, const Quaternion& q);
+
+  protected:
+    std::vector<double> q0, q1, q2, q3;
+  };
+
+  // ============================================================
+  // MahonyFilterBatch
+  //
+  // Mahony explicit complementary filter (PI correction of the
+  // gyro rate from the accelerometer and magnetometer error).
+  //
+  // - kp: proportional gain
+  // - ki: integral gain (0 disables gyro-bias estimation)
+  // ============================================================
+  class MahonyFilterBatch : public AttitudeFilterBatch
+  {
+  public:
+    MahonyFilterBatch(std::size_t count, double kp = 1.0, double ki = 0.0);
+
+    // Advances every sensor by dt seconds. With useMagnetometer
+    // false, only accelerometer (tilt) correction is applied.
+    // Throws std::invalid_argument unless imu.size() == size().
+    void update(const ImuBatch& imu, double dt, bool useMagnetometer = true);
+
+    // Same update reading the samples through strided views. gyro
+    // and accel must have size() elements, and so must mag unless
+    // useMagnetometer is false (then it is not read and may be
+    // empty); throws std::invalid_argument otherwise.
+    void update(ConstVector3View gyro, ConstVector3View accel, ConstVector3View mag,
+                double dt, bool useMagnetometer = true);
+
+    // Estimated gyro bias correction of sensor i
+    Vector3 integralError(std::size_t i) const;
+
+  private:
+    double kp;
+    double ki;
+    std::vector<double> ix, iy, iz;
+  };
+
+  // ============================================================
+  // MadgwickFilterBatch
+  //
+  // Madgwick gradient-descent orientation filter.
+  //
+  // - beta: gradient step gain (rad/s)
+  // ============================================================
+  class MadgwickFilterBatch : public AttitudeFilterBatch
+  {
+  public:
+    MadgwickFilterBatch(std::size_t count, double beta = 0.1);
+
+    void update(const ImuBatch& imu, double dt, bool useMagnetometer = true);
+    void update(ConstVector3View gyro, ConstVector3View accel, ConstVector3View mag,
+                double dt, bool useMagnetometer = true);
+
+  private:
+    double beta;
+  };
+
+  // ============================================================
+  // ComplementaryFilterBatch
+  //
+  // Quaternion complementary filter: the gyro-propagated attitude
+  // is pulled towards the accelerometer tilt and the magnetometer
+  // heading by fractional corrections each tick.
+  //
+  // - accelGain: fraction of the tilt error removed per update
+  // - magGain: fraction of the heading error removed per update
+  // ============================================================
+  class ComplementaryFilterBatch : public AttitudeFilterBatch
+  {
+  public:
+    ComplementaryFilterBatch(std::size_t count, double accelGain = 0.02, double magGain = 0.02);
+
+    void update(const ImuBatch& imu, double dt, bool useMagnetometer = true);
+    void update(ConstVector3View gyro, ConstVector3View accel, ConstVector3View mag,
+                double dt, bool useMagnetometer = true);
+
+  private:
+    double accelGain;
+    double magGain;
+  };
+
+} // namespace AML
+
+#endif // AML_IMUFILTERS_H
@@ -7,13 +7,6 @@
 namespace AML
 {
 
-  // Default constructor
-  Matrix33::Matrix33() :
-    m11(0.0), m12(0.0), m13(0.0),
-    m21(0.0), m22(0.0), m23(0.0),
-    m31(0.0), m32(0.0), m33(0.0)
-  {}
-
   // Scalar constructor
   Matrix33::Matrix33(double val) :
     m11(val), m12(val), m13(val),
@@ -30,9 +23,9 @@ namespace AML
 
   // 2D array constructor
   Matrix33::Matrix33(const double data_[3][3]) :
-    m11(data[0][0]), m12(data[0][1]), m13(data[0][2]),
-    m21(data[1][0]), m22(data[1][0]), m23(data[1][0]),
-    m31(data[2][0]), m32(data[2][0]), m33(data[2][0])  
+    m11(data_[0][0]), m12(data_[0][1]), m13(data_[0][2]),
+    m21(data_[1][0]), m22(data_[1][1]), m23(data_[1][2]),
+    m31(data_[2][0]), m32(data_[2][1]), m33(data_[2][2])
   {}
 
   // Vector-based constructor
@@ -158,13 +151,6 @@ namespace AML
     return *this;        
   }
 
-  // Identity matrix
-  const Matrix33 Matrix33::identity()
-  {
-    double data[3][3] = {{1,0,0}, {0,1,0}, {0,0,1}};
-    return Matrix33(data);
-  }
-
   // Unary minus
   Matrix33 operator-(const Matrix33 &rhs)
   {
@@ -240,7 +226,7 @@ namespace AML
 
   Vector3 diag(const Matrix33 &rhs)
   {
-    return Vector3(rhs.m11, rhs.m22, rhs.m23);
+    return Vector3(rhs.m11, rhs.m22, rhs.m33);
   }
 
   // Creates a diagonal matrix from a Vector3
@@ -268,7 +254,7 @@ namespace AML
     result[2] = rhs.m31;
     result[3] = rhs.m12;
     result[4] = rhs.m22;
-    result[5] = rhs.m22;
+    result[5] = rhs.m32;
     result[6] = rhs.m13;
     result[7] = rhs.m23;
     result[8] = rhs.m33;
@@ -41,7 +41,21 @@ namespace AML
 
     // Default constructor
     // Intended to initialize all elements to zero.
-    Matrix33();
+    constexpr Matrix33() :
+      m11(0.0), m12(0.0), m13(0.0),
+      m21(0.0), m22(0.0), m23(0.0),
+      m31(0.0), m32(0.0), m33(0.0)
+    {}
+
+    // Element-wise constructor
+    // Elements given in row-major order.
+    constexpr Matrix33(double m11_, double m12_, double m13_,
+                       double m21_, double m22_, double m23_,
+                       double m31_, double m32_, double m33_) :
+      m11(m11_), m12(m12_), m13(m13_),
+      m21(m21_), m22(m22_), m23(m23_),
+      m31(m31_), m32(m32_), m33(m33_)
+    {}
 
     // Scalar constructor
     // Initializes all elements to the same scalar value.
@@ -91,8 +105,14 @@ namespace AML
     //   [ 0 0 1 ]
     //
     // Static because identity does not depend on any instance.
+    // constexpr so it is built at compile time.
     // ------------------------------------------------------------
-    static const Matrix33 identity();
+    static constexpr Matrix33 identity()
+    {
+      return Matrix33(1.0, 0.0, 0.0,
+                      0.0, 1.0, 0.0,
+                      0.0, 0.0, 1.0);
+    }
     
   }; // class Matrix33
 
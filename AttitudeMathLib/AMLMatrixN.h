@@ -0,0 +1,500 @@
+#ifndef AML_MATRIXN_H
+#define AML_MATRIXN_H
+
+#include "AMLVector3.h"
+#include "AMLMatrix33.h"
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <utility>
+
+namespace AML
+{
+  // ============================================================
+  // MatrixN
+  //
+  // Represents an R x C double-precision matrix whose size is
+  // fixed at compile time.
+  //
+  // Intended use:
+  // - Estimator-sized linear algebra (e.g. the 6x6 covariance and
+  //   3x6 measurement Jacobian of a multiplicative EKF)
+  // - Building larger matrices out of Matrix33 / Vector3 blocks
+  //
+  // Storage lives inside the object (no dynamic allocation) and
+  // every loop bound is a compile-time constant, so products are
+  // fully unrolled for small sizes.
+  // ============================================================
+  template <std::size_t R, std::size_t C>
+  class MatrixN
+  {
+    static_assert(R > 0 && C > 0, "MatrixN dimensions must be non-zero");
+
+  public:
+    static constexpr std::size_t rows = R;
+    static constexpr std::size_t cols = C;
+
+    // ------------------------------------------------------------
+    // Storage
+    //
+    // data[row][col], row-major
+    // ------------------------------------------------------------
+    double data[R][C];
+
+    // ------------------------------------------------------------
+    // Constructors
+    // ------------------------------------------------------------
+
+    // Default constructor
+    // Initializes all elements to zero.
+    MatrixN();
+
+    // Scalar constructor
+    // Initializes all elements to the same scalar value.
+    explicit MatrixN(double val);
+
+    // Flat array constructor
+    // Interprets data as R*C elements in row-major order.
+    explicit MatrixN(const double data_[R * C]);
+
+    // Conversion from the 3x3 / 3x1 fixed types
+    explicit MatrixN(const Matrix33& m) requires (R == 3 && C == 3);
+    explicit MatrixN(const Vector3& v) requires (R == 3 && C == 1);
+
+    // ------------------------------------------------------------
+    // Element access
+    // ------------------------------------------------------------
+    double& operator()(std::size_t row, std::size_t col) { return data[row][col]; }
+    double operator()(std::size_t row, std::size_t col) const { return data[row][col]; }
+
+    // ------------------------------------------------------------
+    // Compound assignment operators
+    // ------------------------------------------------------------
+    MatrixN& operator+=(const MatrixN& rhs);
+    MatrixN& operator-=(const MatrixN& rhs);
+    MatrixN& operator*=(double rhs);
+    MatrixN& operator/=(double rhs);
+
+    // ------------------------------------------------------------
+    // Block access
+    //
+    // Reads or writes the BR x BC sub-matrix whose top-left
+    // element is (I, J). Offsets come first in both, and all
+    // arguments are template arguments so an out-of-range block is
+    // a compile error.
+    //
+    // The getters return copies, not views: the blocks are small
+    // and fixed-size, and edits go back through the setters.
+    //
+    // block33 / setBlock33 exchange a 3x3 block with Matrix33.
+    // vector3 / setVector3 exchange the 3x1 column segment
+    // starting at (I, J) with Vector3.
+    // ------------------------------------------------------------
+    template <std::size_t I, std::size_t J, std::size_t BR, std::size_t BC>
+    MatrixN<BR, BC> block() const;
+
+    template <std::size_t I, std::size_t J, std::size_t BR, std::size_t BC>
+    void setBlock(const MatrixN<BR, BC>& rhs);
+
+    template <std::size_t I, std::size_t J>
+    Matrix33 block33() const;
+
+    template <std::size_t I, std::size_t J>
+    void setBlock33(const Matrix33& rhs);
+
+    template <std::size_t I, std::size_t J = 0>
+    Vector3 vector3() const;
+
+    template <std::size_t I, std::size_t J = 0>
+    void setVector3(const Vector3& rhs);
+
+    // ------------------------------------------------------------
+    // Conversions back to the 3x3 / 3x1 fixed types
+    // ------------------------------------------------------------
+    Matrix33 toMatrix33() const requires (R == 3 && C == 3);
+    Vector3 toVector3() const requires (R == 3 && C == 1);
+
+    // ------------------------------------------------------------
+    // Identity matrix
+    // ------------------------------------------------------------
+    static MatrixN identity() requires (R == C);
+
+  }; // class MatrixN
+
+  // Common estimator sizes
+  using Matrix66 = MatrixN<6, 6>;
+  using Matrix36 = MatrixN<3, 6>;
+  using Matrix63 = MatrixN<6, 3>;
+  using Vector6 = MatrixN<6, 1>;
+
+  // ============================================================
+  // Unary operators
+  // ============================================================
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C> operator-(const MatrixN<R, C>& rhs);
+
+  // ============================================================
+  // Binary matrix-matrix operators
+  // ============================================================
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C> operator+(const MatrixN<R, C>& lhs, const MatrixN<R, C>& rhs);
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C> operator-(const MatrixN<R, C>& lhs, const MatrixN<R, C>& rhs);
+
+  // Matrix multiplication: (R x K) * (K x C) -> (R x C)
+  template <std::size_t R, std::size_t K, std::size_t C>
+  MatrixN<R, C> operator*(const MatrixN<R, K>& lhs, const MatrixN<K, C>& rhs);
+
+  // (R x 3) * Vector3 -> (R x 1)
+  template <std::size_t R>
+  MatrixN<R, 1> operator*(const MatrixN<R, 3>& lhs, const Vector3& rhs);
+
+  // ============================================================
+  // Matrix-scalar operators
+  // ============================================================
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C> operator*(const MatrixN<R, C>& lhs, double s);
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C> operator*(double s, const MatrixN<R, C>& rhs);
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C> operator/(const MatrixN<R, C>& lhs, double s);
+
+  // ============================================================
+  // Matrix utility functions
+  // ============================================================
+
+  // Returns the transpose of the matrix
+  template <std::size_t R, std::size_t C>
+  MatrixN<C, R> transpose(const MatrixN<R, C>& rhs);
+
+  // Cholesky factorization A = L * transpose(L).
+  // Only the lower triangle of A is read. L is lower triangular.
+  // Returns false (and leaves L partially written) when A is not
+  // positive definite.
+  template <std::size_t N>
+  bool cholesky(const MatrixN<N, N>& A, MatrixN<N, N>& L);
+
+  // Solves A * X = B given the Cholesky factor L of A.
+  template <std::size_t N, std::size_t C>
+  MatrixN<N, C> choleskySolve(const MatrixN<N, N>& L, const MatrixN<N, C>& B);
+
+  // Stream output
+  template <std::size_t R, std::size_t C>
+  std::ostream& operator<<(std::ostream& os, const MatrixN<R, C>& obj);
+
+  // ============================================================
+  // Implementation
+  // ============================================================
+
+  namespace detail
+  {
+    // Row i of lhs dotted with column j of rhs, expanded at
+    // compile time into K multiply-adds.
+    template <std::size_t R, std::size_t K, std::size_t C, std::size_t... k>
+    inline double rowColDot(const MatrixN<R, K>& lhs, const MatrixN<K, C>& rhs,
+                            std::size_t i, std::size_t j, std::index_sequence<k...>)
+    {
+      return ((lhs.data[i][k] * rhs.data[k][j]) + ...);
+    }
+  }
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C>::MatrixN()
+  {
+    for (std::size_t i = 0; i < R; ++i)
+      for (std::size_t j = 0; j < C; ++j)
+        data[i][j] = 0.0;
+  }
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C>::MatrixN(double val)
+  {
+    for (std::size_t i = 0; i < R; ++i)
+      for (std::size_t j = 0; j < C; ++j)
+        data[i][j] = val;
+  }
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C>::MatrixN(const double data_[R * C])
+  {
+    for (std::size_t i = 0; i < R; ++i)
+      for (std::size_t j = 0; j < C; ++j)
+        data[i][j] = data_[i * C + j];
+  }
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C>::MatrixN(const Matrix33& m) requires (R == 3 && C == 3)
+  {
+    for (std::size_t i = 0; i < 3; ++i)
+      for (std::size_t j = 0; j < 3; ++j)
+        data[i][j] = m.data[i][j];
+  }
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C>::MatrixN(const Vector3& v) requires (R == 3 && C == 1)
+  {
+    data[0][0] = v.x;
+    data[1][0] = v.y;
+    data[2][0] = v.z;
+  }
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C>& MatrixN<R, C>::operator+=(const MatrixN& rhs)
+  {
+    for (std::size_t i = 0; i < R; ++i)
+      for (std::size_t j = 0; j < C; ++j)
+        data[i][j] += rhs.data[i][j];
+    return *this;
+  }
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C>& MatrixN<R, C>::operator-=(const MatrixN& rhs)
+  {
+    for (std::size_t i = 0; i < R; ++i)
+      for (std::size_t j = 0; j < C; ++j)
+        data[i][j] -= rhs.data[i][j];
+    return *this;
+  }
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C>& MatrixN<R, C>::operator*=(double rhs)
+  {
+    for (std::size_t i = 0; i < R; ++i)
+      for (std::size_t j = 0; j < C; ++j)
+        data[i][j] *= rhs;
+    return *this;
+  }
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C>& MatrixN<R, C>::operator/=(double rhs)
+  {
+    for (std::size_t i = 0; i < R; ++i)
+      for (std::size_t j = 0; j < C; ++j)
+        data[i][j] /= rhs;
+    return *this;
+  }
+
+  template <std::size_t R, std::size_t C>
+  template <std::size_t I, std::size_t J, std::size_t BR, std::size_t BC>
+  MatrixN<BR, BC> MatrixN<R, C>::block() const
+  {
+    static_assert(I + BR <= R && J + BC <= C, "block out of range");
+    MatrixN<BR, BC> result;
+    for (std::size_t i = 0; i < BR; ++i)
+      for (std::size_t j = 0; j < BC; ++j)
+        result.data[i][j] = data[I + i][J + j];
+    return result;
+  }
+
+  template <std::size_t R, std::size_t C>
+  template <std::size_t I, std::size_t J, std::size_t BR, std::size_t BC>
+  void MatrixN<R, C>::setBlock(const MatrixN<BR, BC>& rhs)
+  {
+    static_assert(I + BR <= R && J + BC <= C, "block out of range");
+    for (std::size_t i = 0; i < BR; ++i)
+      for (std::size_t j = 0; j < BC; ++j)
+        data[I + i][J + j] = rhs.data[i][j];
+  }
+
+  template <std::size_t R, std::size_t C>
+  template <std::size_t I, std::size_t J>
+  Matrix33 MatrixN<R, C>::block33() const
+  {
+    static_assert(I + 3 <= R && J + 3 <= C, "block out of range");
+    Matrix33 result;
+    for (std::size_t i = 0; i < 3; ++i)
+      for (std::size_t j = 0; j < 3; ++j)
+        result.data[i][j] = data[I + i][J + j];
+    return result;
+  }
+
+  template <std::size_t R, std::size_t C>
+  template <std::size_t I, std::size_t J>
+  void MatrixN<R, C>::setBlock33(const Matrix33& rhs)
+  {
+    static_assert(I + 3 <= R && J + 3 <= C, "block out of range");
+    for (std::size_t i = 0; i < 3; ++i)
+      for (std::size_t j = 0; j < 3; ++j)
+        data[I + i][J + j] = rhs.data[i][j];
+  }
+
+  template <std::size_t R, std::size_t C>
+  template <std::size_t I, std::size_t J>
+  Vector3 MatrixN<R, C>::vector3() const
+  {
+    static_assert(I + 3 <= R && J < C, "segment out of range");
+    return Vector3(data[I][J], data[I + 1][J], data[I + 2][J]);
+  }
+
+  template <std::size_t R, std::size_t C>
+  template <std::size_t I, std::size_t J>
+  void MatrixN<R, C>::setVector3(const Vector3& rhs)
+  {
+    static_assert(I + 3 <= R && J < C, "segment out of range");
+    data[I][J] = rhs.x;
+    data[I + 1][J] = rhs.y;
+    data[I + 2][J] = rhs.z;
+  }
+
+  template <std::size_t R, std::size_t C>
+  Matrix33 MatrixN<R, C>::toMatrix33() const requires (R == 3 && C == 3)
+  {
+    return block33<0, 0>();
+  }
+
+  template <std::size_t R, std::size_t C>
+  Vector3 MatrixN<R, C>::toVector3() const requires (R == 3 && C == 1)
+  {
+    return vector3<0, 0>();
+  }
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C> MatrixN<R, C>::identity() requires (R == C)
+  {
+    MatrixN result;
+    for (std::size_t i = 0; i < R; ++i)
+      result.data[i][i] = 1.0;
+    return result;
+  }
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C> operator-(const MatrixN<R, C>& rhs)
+  {
+    return (MatrixN<R, C>(rhs) *= -1.0);
+  }
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C> operator+(const MatrixN<R, C>& lhs, const MatrixN<R, C>& rhs)
+  {
+    return (MatrixN<R, C>(lhs) += rhs);
+  }
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C> operator-(const MatrixN<R, C>& lhs, const MatrixN<R, C>& rhs)
+  {
+    return (MatrixN<R, C>(lhs) -= rhs);
+  }
+
+  template <std::size_t R, std::size_t K, std::size_t C>
+  MatrixN<R, C> operator*(const MatrixN<R, K>& lhs, const MatrixN<K, C>& rhs)
+  {
+    MatrixN<R, C> result;
+    for (std::size_t i = 0; i < R; ++i)
+      for (std::size_t j = 0; j < C; ++j)
+        result.data[i][j] = detail::rowColDot(lhs, rhs, i, j, std::make_index_sequence<K>());
+    return result;
+  }
+
+  template <std::size_t R>
+  MatrixN<R, 1> operator*(const MatrixN<R, 3>& lhs, const Vector3& rhs)
+  {
+    MatrixN<R, 1> result;
+    for (std::size_t i = 0; i < R; ++i)
+      result.data[i][0] = lhs.data[i][0] * rhs.x + lhs.data[i][1] * rhs.y + lhs.data[i][2] * rhs.z;
+    return result;
+  }
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C> operator*(const MatrixN<R, C>& lhs, double s)
+  {
+    return (MatrixN<R, C>(lhs) *= s);
+  }
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C> operator*(double s, const MatrixN<R, C>& rhs)
+  {
+    return (MatrixN<R, C>(rhs) *= s);
+  }
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<R, C> operator/(const MatrixN<R, C>& lhs, double s)
+  {
+    return (MatrixN<R, C>(lhs) /= s);
+  }
+
+  template <std::size_t R, std::size_t C>
+  MatrixN<C, R> transpose(const MatrixN<R, C>& rhs)
+  {
+    MatrixN<C, R> result;
+    for (std::size_t i = 0; i < R; ++i)
+      for (std::size_t j = 0; j < C; ++j)
+        result.data[j][i] = rhs.data[i][j];
+    return result;
+  }
+
+  template <std::size_t N>
+  bool cholesky(const MatrixN<N, N>& A, MatrixN<N, N>& L)
+  {
+    L = MatrixN<N, N>();
+    for (std::size_t j = 0; j < N; ++j)
+      {
+        double d = A.data[j][j];
+        for (std::size_t k = 0; k < j; ++k)
+          d -= L.data[j][k] * L.data[j][k];
+        if (!(d > 0.0))
+          {
+            return false;
+          }
+        const double ljj = std::sqrt(d);
+        L.data[j][j] = ljj;
+
+        for (std::size_t i = j + 1; i < N; ++i)
+          {
+            double s = A.data[i][j];
+            for (std::size_t k = 0; k < j; ++k)
+              s -= L.data[i][k] * L.data[j][k];
+            L.data[i][j] = s / ljj;
+          }
+      }
+    return true;
+  }
+
+  template <std::size_t N, std::size_t C>
+  MatrixN<N, C> choleskySolve(const MatrixN<N, N>& L, const MatrixN<N, C>& B)
+  {
+    // Forward substitution: L * Y = B
+    MatrixN<N, C> Y;
+    for (std::size_t c = 0; c < C; ++c)
+      for (std::size_t i = 0; i < N; ++i)
+        {
+          double s = B.data[i][c];
+          for (std::size_t k = 0; k < i; ++k)
+            s -= L.data[i][k] * Y.data[k][c];
+          Y.data[i][c] = s / L.data[i][i];
+        }
+
+    // Back substitution: transpose(L) * X = Y
+    MatrixN<N, C> X;
+    for (std::size_t c = 0; c < C; ++c)
+      for (std::size_t ii = N; ii-- > 0;)
+        {
+          double s = Y.data[ii][c];
+          for (std::size_t k = ii + 1; k < N; ++k)
+            s -= L.data[k][ii] * X.data[k][c];
+          X.data[ii][c] = s / L.data[ii][ii];
+        }
+    return X;
+  }
+
+  template <std::size_t R, std::size_t C>
+  std::ostream& operator<<(std::ostream& os, const MatrixN<R, C>& obj)
+  {
+    os << "[";
+    for (std::size_t i = 0; i < R; ++i)
+      {
+        os << (i ? ",[" : "[");
+        for (std::size_t j = 0; j < C; ++j)
+          os << (j ? "," : "") << obj.data[i][j];
+        os << "]";
+      }
+    os << "]";
+    return os;
+  }
+
+} // namespace AML
+
+#endif // AML_MATRIXN_H
@@ -0,0 +1,733 @@
+#include "AMLOrientationIndex.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <numbers>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace AML
+{
+
+  namespace
+  {
+    constexpr char fileMagic[8] = {'A', 'M', 'L', 'O', 'I', 'D', 'X', '\0'};
+    constexpr std::uint32_t fileVersion = 1;
+    constexpr std::size_t headerBytes = 32;
+    constexpr std::size_t pointBytes = 4 * 8 + 4;
+    constexpr std::size_t nodeBytes = 4 * 4 + 3 * 8;
+
+    constexpr std::size_t maxAttitudes = std::size_t(std::numeric_limits<std::int32_t>::max());
+
+    // Deepest tree a loaded file may describe. build() splits at
+    // the median, so a subtree holds at most half of its parent's
+    // points and the depth is about log2(n / leaf); twice that plus
+    // slack accepts every built tree while keeping the recursive
+    // searches shallow.
+    std::size_t maxDepth(std::size_t n, std::size_t leafSize)
+    {
+      return 2 * std::size_t(std::bit_width(n / leafSize)) + 8;
+    }
+
+    // Slack on the triangle-inequality pruning tests so rounding in
+    // the chords can never drop an attitude that brute force keeps
+    constexpr double pruneSlack = 1e-12;
+
+    // Vantage point selection: candidates tried and distances
+    // sampled per candidate
+    constexpr std::size_t vantageCandidates = 5;
+    constexpr std::size_t vantageSamples = 32;
+
+    // Squared chord min(|q - p|, |p + q|)^2. The component
+    // differences keep small distances accurate (2 - 2|q.p| would
+    // cancel).
+    inline double chord2(const double* __restrict q, const double* __restrict p)
+    {
+      double a0 = q[0] - p[0], a1 = q[1] - p[1], a2 = q[2] - p[2], a3 = q[3] - p[3];
+      double b0 = q[0] + p[0], b1 = q[1] + p[1], b2 = q[2] + p[2], b3 = q[3] + p[3];
+      double a = a0 * a0 + a1 * a1 + a2 * a2 + a3 * a3;
+      double b = b0 * b0 + b1 * b1 + b2 * b2 + b3 * b3;
+      return std::min(a, b);
+    }
+
+    // Rotation angle of a chord, and the chord of an angle
+    inline double chordAngle(double chord)
+    {
+      return 4.0 * std::asin(std::min(1.0, 0.5 * chord));
+    }
+
+    inline double angleChord(double angle)
+    {
+      return 2.0 * std::sin(0.25 * angle);
+    }
+
+    // Unit quaternion as 4 doubles; false for zero / non-finite
+    inline bool unitComponents(const Quaternion& q, double* out)
+    {
+      double n = std::sqrt(q.q0 * q.q0 + q.q1 * q.q1 + q.q2 * q.q2 + q.q3 * q.q3);
+      if (!(n > 0.0) || !std::isfinite(n))
+        return false;
+      double r = 1.0 / n;
+      for (int j = 0; j < 4; ++j)
+        out[j] = q.data[j] * r;
+      return true;
+    }
+
+    inline void queryComponents(const Quaternion& q, double* out)
+    {
+      if (!unitComponents(q, out))
+        throw std::invalid_argument("OrientationIndex: query must be a finite non-zero quaternion");
+    }
+
+    inline bool matchLess(const OrientationIndex::Match& lhs, const OrientationIndex::Match& rhs)
+    {
+      return lhs.angle < rhs.angle || (lhs.angle == rhs.angle && lhs.index < rhs.index);
+    }
+
+    // Runs work(begin, end) over contiguous ranges of [0, n) on up
+    // to threads workers and rethrows the first worker exception
+    template <typename F>
+    void parallelRanges(std::size_t n, unsigned threads, F&& work)
+    {
+      if (n == 0)
+        return;
+      if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+      std::size_t workers = std::min<std::size_t>(threads, n);
+      std::size_t perWorker = (n + workers - 1) / workers;
+
+      std::vector<std::exception_ptr> errors(workers);
+      auto run = [&](std::size_t w)
+      {
+        try
+          {
+            std::size_t begin = w * perWorker;
+            work(begin, std::min(n, begin + perWorker));
+          }
+        catch (...)
+          {
+            errors[w] = std::current_exception();
+          }
+      };
+
+      std::vector<std::thread> pool;
+      for (std::size_t w = 1; w < workers; ++w)
+        pool.emplace_back(run, w);
+      run(0);
+      for (std::thread& t : pool)
+        t.join();
+
+      for (std::exception_ptr& e : errors)
+        {
+          if (e)
+            std::rethrow_exception(e);
+        }
+    }
+
+    // ------------------------------------------------------------
+    // Little-endian file fields
+    // ------------------------------------------------------------
+    void putU32(std::vector<std::uint8_t>& out, std::uint32_t v)
+    {
+      for (int j = 0; j < 4; ++j)
+        out.push_back(std::uint8_t(v >> (8 * j)));
+    }
+
+    void putU64(std::vector<std::uint8_t>& out, std::uint64_t v)
+    {
+      for (int j = 0; j < 8; ++j)
+        out.push_back(std::uint8_t(v >> (8 * j)));
+    }
+
+    void putF64(std::vector<std::uint8_t>& out, double v)
+    {
+      putU64(out, std::bit_cast<std::uint64_t>(v));
+    }
+
+    struct FieldReader
+    {
+      const std::uint8_t* p;
+
+      std::uint32_t u32()
+      {
+        std::uint32_t v = 0;
+        for (int j = 0; j < 4; ++j)
+          v |= std::uint32_t(p[j]) << (8 * j);
+        p += 4;
+        return v;
+      }
+
+      std::uint64_t u64()
+      {
+        std::uint64_t v = 0;
+        for (int j = 0; j < 8; ++j)
+          v |= std::uint64_t(p[j]) << (8 * j);
+        p += 8;
+        return v;
+      }
+
+      double f64()
+      {
+        return std::bit_cast<double>(u64());
+      }
+    };
+
+    [[noreturn]] void malformed(const char* what)
+    {
+      throw std::runtime_error(std::string("OrientationIndex: malformed index file (") + what + ")");
+    }
+
+    // Reads "count" records of "bytes" bytes each and hands them to
+    // record() one at a time. The stream is read in bounded chunks,
+    // so a header claiming more records than the file holds fails
+    // on a short read instead of on a huge allocation.
+    template <typename Record>
+    void readRecords(std::istream& is, std::uint64_t count, std::size_t bytes, Record&& record)
+    {
+      constexpr std::size_t chunkBytes = std::size_t(1) << 16;
+      const std::size_t perChunk = chunkBytes / bytes;
+      std::vector<std::uint8_t> chunk(perChunk * bytes);
+      while (count > 0)
+        {
+          std::size_t k = std::size_t(std::min<std::uint64_t>(count, perChunk));
+          if (!is.read(reinterpret_cast<char*>(chunk.data()), std::streamsize(k * bytes)))
+            malformed("truncated data");
+          FieldReader reader{chunk.data()};
+          for (std::size_t i = 0; i < k; ++i)
+            record(reader);
+          count -= k;
+        }
+    }
+  }
+
+  // ------------------------------------------------------------
+  // Bounded max-heap of the k best (chord, library index) pairs
+  // ------------------------------------------------------------
+  struct OrientationIndex::Heap
+  {
+    explicit Heap(std::size_t k_) :
+      k(k_), bound(std::numeric_limits<double>::infinity()),
+      bound2(std::numeric_limits<double>::infinity())
+    {
+      items.reserve(k);
+    }
+
+    void offer(double d2, std::uint32_t id)
+    {
+      if (d2 > bound2)
+        return;
+      std::pair<double, std::uint32_t> item(std::sqrt(d2), id);
+      if (items.size() < k)
+        {
+          items.push_back(item);
+          std::push_heap(items.begin(), items.end());
+        }
+      else if (item < items.front())
+        {
+          std::pop_heap(items.begin(), items.end());
+          items.back() = item;
+          std::push_heap(items.begin(), items.end());
+        }
+      else
+        return;
+      if (items.size() == k)
+        {
+          bound = items.front().first;
+          bound2 = bound * bound;
+        }
+    }
+
+    std::size_t k;
+    double bound;
+    double bound2;
+    std::vector<std::pair<double, std::uint32_t>> items;
+  };
+
+  // Constructors
+  OrientationIndex::OrientationIndex() :
+    leaf(defaultLeafSize)
+  {}
+
+  OrientationIndex::OrientationIndex(const std::vector<Quaternion>& library, std::size_t leafSize_) :
+    leaf(defaultLeafSize)
+  {
+    build(library, leafSize_);
+  }
+
+  void OrientationIndex::build(const std::vector<Quaternion>& library, std::size_t leafSize_)
+  {
+    build(library.data(), library.size(), leafSize_);
+  }
+
+  void OrientationIndex::build(const Quaternion* library, std::size_t n, std::size_t leafSize_)
+  {
+    if (leafSize_ == 0)
+      throw std::invalid_argument("OrientationIndex: leaf size must be positive");
+    if (n > maxAttitudes)
+      throw std::invalid_argument("OrientationIndex: too many attitudes");
+
+    // Normalized copy in library order while the tree is built
+    std::vector<double> unit(4 * n);
+    for (std::size_t i = 0; i < n; ++i)
+      {
+        if (!unitComponents(library[i], &unit[4 * i]))
+          throw std::invalid_argument("OrientationIndex: attitude " + std::to_string(i)
+                                      + " must be a finite non-zero quaternion");
+      }
+
+    leaf = leafSize_;
+    points = std::move(unit);
+    ids.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+      ids[i] = std::uint32_t(i);
+    nodes.clear();
+
+    if (n > 0)
+      {
+        std::vector<std::pair<double, std::uint32_t>> scratch;
+        scratch.reserve(n);
+        buildNode(0, std::uint32_t(n), scratch);
+      }
+
+    // Store the attitudes in tree order
+    std::vector<double> ordered(4 * n);
+    slots.resize(n);
+    for (std::size_t s = 0; s < n; ++s)
+      {
+        std::memcpy(&ordered[4 * s], &points[4 * std::size_t(ids[s])], 4 * sizeof(double));
+        slots[ids[s]] = std::uint32_t(s);
+      }
+    points = std::move(ordered);
+  }
+
+  std::int32_t OrientationIndex::buildNode(std::uint32_t begin, std::uint32_t end,
+                                           std::vector<std::pair<double, std::uint32_t>>& scratch)
+  {
+    // Points are still in library order here, reached through ids
+    auto point = [&](std::uint32_t s) { return &points[4 * std::size_t(ids[s])]; };
+
+    std::int32_t self = std::int32_t(nodes.size());
+    nodes.push_back(Node{begin, end, -1, -1, 0.0, 0.0, 0.0});
+    std::uint32_t count = end - begin;
+    if (count <= leaf)
+      return self;
+
+    // Vantage point: the candidate whose distances to a sample are
+    // most spread out (it splits the set most cleanly)
+    std::minstd_rand gen(begin * 2654435761u + end);
+    std::uniform_int_distribution<std::uint32_t> pick(begin, end - 1);
+    std::uint32_t best = begin;
+    double bestSpread = -1.0;
+    std::size_t candidates = std::min<std::size_t>(vantageCandidates, count);
+    std::size_t samples = std::min<std::size_t>(vantageSamples, count);
+    for (std::size_t c = 0; c < candidates; ++c)
+      {
+        std::uint32_t v = pick(gen);
+        double sum = 0.0, sum2 = 0.0;
+        for (std::size_t j = 0; j < samples; ++j)
+          {
+            double d = std::sqrt(chord2(point(v), point(pick(gen))));
+            sum += d;
+            sum2 += d * d;
+          }
+        double spread = sum2 - sum * sum / double(samples);
+        if (spread > bestSpread)
+          {
+            bestSpread = spread;
+            best = v;
+          }
+      }
+    std::swap(ids[begin], ids[best]);
+
+    // Median split of the remaining points by distance
+    const double* vp = point(begin);
+    scratch.clear();
+    for (std::uint32_t s = begin + 1; s < end; ++s)
+      scratch.emplace_back(std::sqrt(chord2(vp, point(s))), ids[s]);
+    std::size_t half = scratch.size() / 2;
+    std::nth_element(scratch.begin(), scratch.begin() + half, scratch.end());
+
+    double innerMax = 0.0;
+    for (std::size_t j = 0; j < half; ++j)
+      innerMax = std::max(innerMax, scratch[j].first);
+    double outerMin = scratch[half].first;
+    double outerMax = outerMin;
+    for (std::size_t j = half; j < scratch.size(); ++j)
+      outerMax = std::max(outerMax, scratch[j].first);
+    for (std::size_t j = 0; j < scratch.size(); ++j)
+      ids[begin + 1 + j] = scratch[j].second;
+
+    std::uint32_t mid = begin + 1 + std::uint32_t(half);
+    std::int32_t inside = half > 0 ? buildNode(begin + 1, mid, scratch) : -1;
+    std::int32_t outside = buildNode(mid, end, scratch);
+
+    Node& node = nodes[self];
+    node.inside = inside;
+    node.outside = outside;
+    node.innerMax = half > 0 ? innerMax : -1.0;
+    node.outerMin = outerMin;
+    node.outerMax = outerMax;
+    return self;
+  }
+
+  std::size_t OrientationIndex::size() const
+  {
+    return ids.size();
+  }
+
+  bool OrientationIndex::empty() const
+  {
+    return ids.empty();
+  }
+
+  std::size_t OrientationIndex::leafSize() const
+  {
+    return leaf;
+  }
+
+  Quaternion OrientationIndex::attitude(std::size_t i) const
+  {
+    return Quaternion(&points[4 * std::size_t(slots.at(i))]);
+  }
+
+  // ------------------------------------------------------------
+  // Queries
+  // ------------------------------------------------------------
+  void OrientationIndex::searchNearest(std::int32_t index, const double* q, Heap& heap) const
+  {
+    const Node& node = nodes[index];
+    if (node.outside < 0)
+      {
+        for (std::uint32_t s = node.begin; s < node.end; ++s)
+          heap.offer(chord2(q, &points[4 * std::size_t(s)]), ids[s]);
+        return;
+      }
+
+    double d2 = chord2(q, &points[4 * std::size_t(node.begin)]);
+    heap.offer(d2, ids[node.begin]);
+    double d = std::sqrt(d2);
+
+    // Closer subtree first so the bound shrinks early
+    bool insideFirst = d < 0.5 * (node.innerMax + node.outerMin);
+    for (int pass = 0; pass < 2; ++pass)
+      {
+        double tau = heap.bound + pruneSlack;
+        if (insideFirst == (pass == 0))
+          {
+            if (node.inside >= 0 && d - tau <= node.innerMax)
+              searchNearest(node.inside, q, heap);
+          }
+        else
+          {
+            if (d + tau >= node.outerMin && d - tau <= node.outerMax)
+              searchNearest(node.outside, q, heap);
+          }
+      }
+  }
+
+  void OrientationIndex::searchRadius(std::int32_t index, const double* q, double chord,
+                                      std::vector<Match>& out) const
+  {
+    const double chord2Max = chord * chord;
+    const Node& node = nodes[index];
+    if (node.outside < 0)
+      {
+        for (std::uint32_t s = node.begin; s < node.end; ++s)
+          {
+            double d2 = chord2(q, &points[4 * std::size_t(s)]);
+            if (d2 <= chord2Max)
+              out.push_back(Match{ids[s], std::sqrt(d2)});
+          }
+        return;
+      }
+
+    double d2 = chord2(q, &points[4 * std::size_t(node.begin)]);
+    if (d2 <= chord2Max)
+      out.push_back(Match{ids[node.begin], std::sqrt(d2)});
+    double d = std::sqrt(d2);
+    double tau = chord + pruneSlack;
+    if (node.inside >= 0 && d - tau <= node.innerMax)
+      searchRadius(node.inside, q, chord, out);
+    if (d + tau >= node.outerMin && d - tau <= node.outerMax)
+      searchRadius(node.outside, q, chord, out);
+  }
+
+  std::vector<OrientationIndex::Match> OrientationIndex::nearest(const Quaternion& q, std::size_t k) const
+  {
+    double u[4];
+    queryComponents(q, u);
+    k = std::min(k, size());
+    std::vector<Match> out;
+    if (k == 0)
+      return out;
+
+    Heap heap(k);
+    searchNearest(0, u, heap);
+    out.reserve(k);
+    for (const auto& item : heap.items)
+      out.push_back(Match{item.second, chordAngle(item.first)});
+    std::sort(out.begin(), out.end(), matchLess);
+    return out;
+  }
+
+  std::vector<OrientationIndex::Match> OrientationIndex::withinAngle(const Quaternion& q, double radius) const
+  {
+    double u[4];
+    queryComponents(q, u);
+    if (!(radius >= 0.0))
+      throw std::invalid_argument("OrientationIndex: radius must be non-negative");
+
+    std::vector<Match> out;
+    if (empty())
+      return out;
+    if (radius >= std::numbers::pi)
+      {
+        // Every attitude is within pi; no chord test, so rounding
+        // at the antipode cannot drop any
+        out.reserve(size());
+        for (std::size_t s = 0; s < size(); ++s)
+          out.push_back(Match{ids[s], std::sqrt(chord2(u, &points[4 * s]))});
+      }
+    else
+      searchRadius(0, u, angleChord(radius), out);
+
+    for (Match& m : out)
+      m.angle = chordAngle(m.angle);
+    std::sort(out.begin(), out.end(), matchLess);
+    return out;
+  }
+
+  std::vector<OrientationIndex::Match> OrientationIndex::nearest(const std::vector<Quaternion>& queries,
+                                                                 std::size_t k, unsigned threads) const
+  {
+    std::size_t row = std::min(k, size());
+    std::vector<Match> out(queries.size() * row);
+    if (row == 0)
+      {
+        // Still validate the queries
+        for (const Quaternion& q : queries)
+          {
+            double u[4];
+            queryComponents(q, u);
+          }
+        return out;
+      }
+
+    parallelRanges(queries.size(), threads, [&](std::size_t begin, std::size_t end)
+    {
+      for (std::size_t i = begin; i < end; ++i)
+        {
+          std::vector<Match> matches = nearest(queries[i], row);
+          std::copy(matches.begin(), matches.end(), out.begin() + i * row);
+        }
+    });
+    return out;
+  }
+
+  std::vector<std::vector<OrientationIndex::Match>>
+  OrientationIndex::withinAngle(const std::vector<Quaternion>& queries, double radius, unsigned threads) const
+  {
+    if (!(radius >= 0.0))
+      throw std::invalid_argument("OrientationIndex: radius must be non-negative");
+
+    std::vector<std::vector<Match>> out(queries.size());
+    parallelRanges(queries.size(), threads, [&](std::size_t begin, std::size_t end)
+    {
+      for (std::size_t i = begin; i < end; ++i)
+        out[i] = withinAngle(queries[i], radius);
+    });
+    return out;
+  }
+
+  // ------------------------------------------------------------
+  // Index files
+  // ------------------------------------------------------------
+  void OrientationIndex::save(std::ostream& os) const
+  {
+    std::size_t n = size();
+    std::vector<std::uint8_t> bytes;
+    bytes.reserve(headerBytes + n * pointBytes + nodes.size() * nodeBytes);
+
+    bytes.insert(bytes.end(), fileMagic, fileMagic + 8);
+    putU32(bytes, fileVersion);
+    putU32(bytes, std::uint32_t(leaf));
+    putU64(bytes, n);
+    putU64(bytes, nodes.size());
+    for (double x : points)
+      putF64(bytes, x);
+    for (std::uint32_t id : ids)
+      putU32(bytes, id);
+    for (const Node& node : nodes)
+      {
+        putU32(bytes, node.begin);
+        putU32(bytes, node.end);
+        putU32(bytes, std::uint32_t(node.inside));
+        putU32(bytes, std::uint32_t(node.outside));
+        putF64(bytes, node.innerMax);
+        putF64(bytes, node.outerMin);
+        putF64(bytes, node.outerMax);
+      }
+
+    os.write(reinterpret_cast<const char*>(bytes.data()), std::streamsize(bytes.size()));
+    if (!os)
+      throw std::runtime_error("OrientationIndex: failed to write index");
+  }
+
+  void OrientationIndex::save(const std::string& path) const
+  {
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+      throw std::runtime_error("OrientationIndex: cannot open " + path);
+    save(file);
+  }
+
+  OrientationIndex OrientationIndex::load(std::istream& is)
+  {
+    std::uint8_t header[headerBytes];
+    if (!is.read(reinterpret_cast<char*>(header), headerBytes))
+      malformed("truncated header");
+    if (std::memcmp(header, fileMagic, 8) != 0)
+      malformed("bad magic");
+
+    FieldReader reader{header + 8};
+    std::uint32_t version = reader.u32();
+    std::uint32_t leafSize_ = reader.u32();
+    std::uint64_t n = reader.u64();
+    std::uint64_t m = reader.u64();
+    if (version != fileVersion)
+      malformed("unsupported version");
+    if (leafSize_ == 0 || n > maxAttitudes || m > n)
+      malformed("bad sizes");
+
+    // The containers grow with the data actually read
+    OrientationIndex index;
+    index.leaf = leafSize_;
+    readRecords(is, n, 4 * 8, [&](FieldReader& reader)
+    {
+      for (int j = 0; j < 4; ++j)
+        index.points.push_back(reader.f64());
+    });
+    readRecords(is, n, 4, [&](FieldReader& reader)
+    {
+      index.ids.push_back(reader.u32());
+    });
+    readRecords(is, m, nodeBytes, [&](FieldReader& reader)
+    {
+      Node node;
+      node.begin = reader.u32();
+      node.end = reader.u32();
+      node.inside = std::int32_t(reader.u32());
+      node.outside = std::int32_t(reader.u32());
+      node.innerMax = reader.f64();
+      node.outerMin = reader.f64();
+      node.outerMax = reader.f64();
+      index.nodes.push_back(node);
+    });
+
+    index.checkStructure();
+    return index;
+  }
+
+  OrientationIndex OrientationIndex::load(const std::string& path)
+  {
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+      throw std::runtime_error("OrientationIndex: cannot open " + path);
+    return load(file);
+  }
+
+  // Validates a loaded tree (so queries cannot loop, read out of
+  // range or recurse deeper than a built tree) and rebuilds the
+  // slot table
+  void OrientationIndex::checkStructure()
+  {
+    std::size_t n = ids.size();
+    for (double x : points)
+      {
+        if (!std::isfinite(x))
+          malformed("non-finite attitude");
+      }
+
+    slots.assign(n, std::uint32_t(n));
+    for (std::size_t s = 0; s < n; ++s)
+      {
+        if (ids[s] >= n || slots[ids[s]] != n)
+          malformed("library indices are not a permutation");
+        slots[ids[s]] = std::uint32_t(s);
+      }
+
+    if (n == 0)
+      {
+        if (!nodes.empty())
+          malformed("nodes in an empty index");
+        return;
+      }
+    if (nodes.empty())
+      malformed("missing root");
+
+    // Every node is reached exactly once from the root, covers the
+    // range its parent expects, has children after it and is no
+    // deeper than build() could have placed it
+    struct Pending
+    {
+      std::int32_t index;
+      std::uint32_t begin;
+      std::uint32_t end;
+      std::size_t depth;
+    };
+    const std::size_t depthLimit = maxDepth(n, leaf);
+    std::vector<bool> seen(nodes.size(), false);
+    std::vector<Pending> stack;
+    stack.push_back({0, 0, std::uint32_t(n), 0});
+    std::size_t visited = 0;
+    while (!stack.empty())
+      {
+        Pending pending = stack.back();
+        stack.pop_back();
+        std::int32_t index = pending.index;
+        if (index < 0 || std::size_t(index) >= nodes.size() || seen[index])
+          malformed("bad node link");
+        if (pending.depth > depthLimit)
+          malformed("tree too deep");
+        seen[index] = true;
+        ++visited;
+
+        const Node& node = nodes[index];
+        if (node.begin != pending.begin || node.end != pending.end || node.begin >= node.end)
+          malformed("bad node range");
+        if (node.outside < 0)
+          {
+            if (node.inside != -1)
+              malformed("bad leaf");
+            continue;
+          }
+        if (node.outside <= index || (node.inside >= 0 && node.inside <= index) || node.inside < -1)
+          malformed("bad node link");
+        if (std::isnan(node.innerMax) || std::isnan(node.outerMin) || std::isnan(node.outerMax))
+          malformed("bad node bounds");
+
+        std::uint32_t mid = node.begin + 1;
+        if (node.inside >= 0)
+          {
+            if (std::size_t(node.inside) >= nodes.size())
+              malformed("bad node link");
+            mid = nodes[node.inside].end;
+            if (mid <= node.begin + 1 || mid >= node.end)
+              malformed("bad node range");
+            stack.push_back({node.inside, node.begin + 1, mid, pending.depth + 1});
+          }
+        stack.push_back({node.outside, mid, node.end, pending.depth + 1});
+      }
+    if (visited != nodes.size())
+      malformed("unreachable nodes");
+  }
+
+} // namespace AML
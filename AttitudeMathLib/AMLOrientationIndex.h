@@ -0,0 +1,167 @@
+#ifndef AML_ORIENTATIONINDEX_H
+#define AML_ORIENTATIONINDEX_H
+
+#include "AMLQuaternion.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace AML
+{
+  // ============================================================
+  // OrientationIndex
+  //
+  // Nearest-orientation search over a fixed library of attitudes.
+  //
+  // Distances are geodesic rotation angles in [0, pi]. q and -q
+  // are the same attitude and are at distance 0.
+  //
+  // Internally the index is a vantage-point tree under the chord
+  // metric min(|p - q|, |p + q|) on unit quaternions. That is a
+  // true metric on attitudes (so triangle-inequality pruning is
+  // exact) and is monotonic in the angle:
+  //
+  //   chord = 2 * sin(angle / 4)
+  //
+  // Each node keeps the distance bounds of both of its subtrees.
+  // Leaves hold up to leafSize attitudes stored contiguously in
+  // tree order, so a query scans a few short runs of memory
+  // instead of the whole library.
+  //
+  // The index is immutable after build() and queries are const,
+  // so any number of threads may query one index concurrently.
+  // ============================================================
+  class OrientationIndex
+  {
+  public:
+    // Library attitude and its angle to the query (radians)
+    struct Match
+    {
+      std::size_t index;
+      double angle;
+    };
+
+    static constexpr std::size_t defaultLeafSize = 16;
+
+    // ------------------------------------------------------------
+    // Construction
+    //
+    // The library is copied and normalized; Match::index is the
+    // position in the library passed to build(). Throws
+    // std::invalid_argument for a zero or non-finite attitude, a
+    // zero leafSize or more than 2^31 - 1 attitudes.
+    // ------------------------------------------------------------
+    OrientationIndex();
+    explicit OrientationIndex(const std::vector<Quaternion>& library,
+                              std::size_t leafSize_ = defaultLeafSize);
+
+    void build(const Quaternion* library, std::size_t n, std::size_t leafSize_ = defaultLeafSize);
+    void build(const std::vector<Quaternion>& library, std::size_t leafSize_ = defaultLeafSize);
+
+    std::size_t size() const;
+    bool empty() const;
+    std::size_t leafSize() const;
+
+    // Normalized library attitude i
+    Quaternion attitude(std::size_t i) const;
+
+    // ------------------------------------------------------------
+    // Queries
+    //
+    // Results are sorted by angle (ties by index). Queries are
+    // normalized; a zero or non-finite query throws
+    // std::invalid_argument.
+    //
+    // nearest() returns the min(k, size()) closest attitudes.
+    // withinAngle() returns every attitude within radius (radius
+    // >= pi returns the whole library; a negative or NaN radius
+    // throws std::invalid_argument).
+    // ------------------------------------------------------------
+    std::vector<Match> nearest(const Quaternion& q, std::size_t k) const;
+    std::vector<Match> withinAngle(const Quaternion& q, double radius) const;
+
+    // ------------------------------------------------------------
+    // Batched queries
+    //
+    // The queries are split into contiguous ranges over worker
+    // threads (0 = std::thread::hardware_concurrency).
+    //
+    // nearest() returns queries.size() rows of min(k, size())
+    // matches, row i at [i * min(k, size()), (i + 1) * ...).
+    // ------------------------------------------------------------
+    std::vector<Match> nearest(const std::vector<Quaternion>& queries, std::size_t k,
+                               unsigned threads = 0) const;
+    std::vector<std::vector<Match>> withinAngle(const std::vector<Quaternion>& queries, double radius,
+                                                unsigned threads = 0) const;
+
+    // ------------------------------------------------------------
+    // Index files
+    //
+    // The built tree is stored as is, so loading does not repeat
+    // the build. Layout (all little-endian):
+    //
+    //   char[8]   magic "AMLOIDX" + '\0'
+    //   uint32    format version (1)
+    //   uint32    leaf size
+    //   uint64    attitude count n
+    //   uint64    node count m
+    //   n x       double q0, q1, q2, q3   (tree order)
+    //   n x       uint32 library index   (tree order)
+    //   m x       uint32 begin, end; int32 inside, outside;
+    //             double innerMax, outerMin, outerMax
+    //
+    // load() checks the header and the tree structure and throws
+    // std::runtime_error for a malformed file; save() and load()
+    // throw std::runtime_error on stream failure.
+    // ------------------------------------------------------------
+    void save(std::ostream& os) const;
+    void save(const std::string& path) const;
+    static OrientationIndex load(std::istream& is);
+    static OrientationIndex load(const std::string& path);
+
+  private:
+    // Attitudes [begin, end) in tree order. An internal node's
+    // vantage point is at begin, its inside subtree (chord <=
+    // innerMax from the vantage point) follows, then the outside
+    // subtree (chord in [outerMin, outerMax]). An empty inside
+    // subtree is -1; leaves have inside = outside = -1.
+    struct Node
+    {
+      std::uint32_t begin;
+      std::uint32_t end;
+      std::int32_t inside;
+      std::int32_t outside;
+      double innerMax;
+      double outerMin;
+      double outerMax;
+    };
+
+    struct Heap;
+
+    std::int32_t buildNode(std::uint32_t begin, std::uint32_t end,
+                           std::vector<std::pair<double, std::uint32_t>>& scratch);
+    void searchNearest(std::int32_t node, const double* q, Heap& heap) const;
+    void searchRadius(std::int32_t node, const double* q, double chord, std::vector<Match>& out) const;
+    void checkStructure();
+
+    std::size_t leaf;
+
+    // 4 doubles per attitude, tree order
+    std::vector<double> points;
+
+    // Library index of each tree slot and tree slot of each
+    // library index
+    std::vector<std::uint32_t> ids;
+    std::vector<std::uint32_t> slots;
+
+    // nodes[0] is the root; children always follow their parent
+    std::vector<Node> nodes;
+  };
+
+} // namespace AML
+
+#endif // AML_ORIENTATIONINDEX_H
@@ -0,0 +1,415 @@
+#include "AMLPipeline.h"
+#include "AMLRingBuffer.h"
+
+#include <bit>
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace AML
+{
+
+  namespace
+  {
+    std::int64_t nowNs()
+    {
+      using namespace std::chrono;
+      return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+  }
+
+  // ============================================================
+  // LatencyHistogram
+  // ============================================================
+
+  LatencyHistogram::LatencyHistogram() :
+    total(0), maxNs(0)
+  {
+    for (std::size_t i = 0; i < bucketCount; ++i)
+      {
+        buckets[i].store(0, std::memory_order_relaxed);
+      }
+  }
+
+  void LatencyHistogram::record(std::int64_t nanoseconds)
+  {
+    const std::uint64_t ns = (nanoseconds > 0) ? static_cast<std::uint64_t>(nanoseconds) : 0;
+    const std::size_t i = (ns > 1) ? static_cast<std::size_t>(std::bit_width(ns) - 1) : 0;
+    buckets[i].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    if (nanoseconds > maxNs.load(std::memory_order_relaxed))
+      {
+        maxNs.store(nanoseconds, std::memory_order_relaxed);
+      }
+  }
+
+  void LatencyHistogram::reset()
+  {
+    for (std::size_t i = 0; i < bucketCount; ++i)
+      {
+        buckets[i].store(0, std::memory_order_relaxed);
+      }
+    total.store(0, std::memory_order_relaxed);
+    maxNs.store(0, std::memory_order_relaxed);
+  }
+
+  std::uint64_t LatencyHistogram::count() const
+  {
+    return total.load(std::memory_order_relaxed);
+  }
+
+  std::uint64_t LatencyHistogram::bucket(std::size_t i) const
+  {
+    return (i < bucketCount) ? buckets[i].load(std::memory_order_relaxed) : 0;
+  }
+
+  std::int64_t LatencyHistogram::max() const
+  {
+    return maxNs.load(std::memory_order_relaxed);
+  }
+
+  std::int64_t LatencyHistogram::percentile(double p) const
+  {
+    const std::uint64_t n = count();
+    if (n == 0)
+      {
+        return 0;
+      }
+
+    const double clamped = (p < 0.0) ? 0.0 : ((p > 1.0) ? 1.0 : p);
+    std::uint64_t target = static_cast<std::uint64_t>(clamped * static_cast<double>(n));
+    if (target == 0)
+      {
+        target = 1;
+      }
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < bucketCount; ++i)
+      {
+        seen += bucket(i);
+        if (seen >= target)
+          {
+            // Upper edge of bucket i, capped by the observed maximum
+            const std::int64_t edge = (i < 62) ? (std::int64_t(2) << i) : max();
+            return (edge < max()) ? edge : max();
+          }
+      }
+    return max();
+  }
+
+  // ============================================================
+  // Pipeline
+  // ============================================================
+
+  namespace
+  {
+    // Queue element: the record plus the time it was handed off,
+    // used for the per-stage latency histogram.
+    struct Slot
+    {
+      AttitudeRecord record;
+      std::int64_t enqueuedNs = 0;
+    };
+  }
+
+  struct Pipeline::StageState
+  {
+    StageState(const std::string& name_, Stage fn_, int cpu_, std::size_t capacity) :
+      name(name_), fn(std::move(fn_)), cpu(cpu_), input(capacity),
+      backpressure(0), processed(0)
+    {}
+
+    std::string name;
+    Stage fn;
+    int cpu;
+    RingBuffer<Slot> input;
+    LatencyHistogram latency;
+    std::atomic<std::uint64_t> backpressure;
+    std::atomic<std::uint64_t> processed;
+    std::exception_ptr error;
+  };
+
+  namespace
+  {
+    // Pushes all "count" slots, waiting while the queue is full.
+    // Each wait is counted as one backpressure event. Gives up
+    // when a stop is requested, so a consumer that stopped
+    // draining cannot block the producer forever.
+    void pushAll(RingBuffer<Slot>& queue, const Slot* slots, std::size_t count,
+                 std::atomic<std::uint64_t>& backpressure, const std::atomic<bool>& stopRequested)
+    {
+      std::size_t done = 0;
+      while (done < count)
+        {
+          const std::size_t n = queue.pushBatch(slots + done, count - done);
+          done += n;
+          if (done < count)
+            {
+              if (stopRequested.load(std::memory_order_relaxed))
+                {
+                  return;
+                }
+              backpressure.fetch_add(1, std::memory_order_relaxed);
+              std::this_thread::yield();
+            }
+        }
+    }
+  }
+
+  Pipeline::Pipeline(std::size_t queueCapacity_, std::size_t batchSize_) :
+    queueCapacity(queueCapacity_), batchSize(batchSize_),
+    sourceCpu(-1), stopRequested(false)
+  {
+    if (queueCapacity == 0 || batchSize == 0)
+      {
+        throw std::invalid_argument("Pipeline: queue capacity and batch size must be non-zero");
+      }
+  }
+
+  Pipeline::~Pipeline()
+  {
+    if (!threads.empty())
+      {
+        stop();
+        try
+          {
+            wait();
+          }
+        catch (...)
+          {
+            // Errors are reported by wait(); a destructor must not throw
+          }
+      }
+  }
+
+  void Pipeline::setSource(Source source_, int cpu)
+  {
+    if (!threads.empty())
+      {
+        throw std::logic_error("Pipeline: cannot set the source while running");
+      }
+    source = std::move(source_);
+    sourceCpu = cpu;
+  }
+
+  void Pipeline::addStage(const std::string& name, Stage stage, int cpu)
+  {
+    if (!threads.empty())
+      {
+        throw std::logic_error("Pipeline: cannot add a stage while running");
+      }
+    stages.push_back(std::make_unique<StageState>(name, std::move(stage), cpu, queueCapacity));
+  }
+
+  void Pipeline::start()
+  {
+    if (!source || stages.empty())
+      {
+        throw std::logic_error("Pipeline: a source and at least one stage are required");
+      }
+    if (!threads.empty())
+      {
+        throw std::logic_error("Pipeline: already running");
+      }
+
+    // Fresh queues and statistics for this run
+    stopRequested.store(false, std::memory_order_relaxed);
+    sourceError = nullptr;
+    for (const std::unique_ptr<StageState>& stage : stages)
+      {
+        stage->input.reset();
+        stage->latency.reset();
+        stage->backpressure.store(0, std::memory_order_relaxed);
+        stage->processed.store(0, std::memory_order_relaxed);
+        stage->error = nullptr;
+      }
+
+    for (std::size_t i = 0; i < stages.size(); ++i)
+      {
+        threads.emplace_back(&Pipeline::stageLoop, this, i);
+      }
+    threads.emplace_back(&Pipeline::sourceLoop, this);
+  }
+
+  void Pipeline::wait()
+  {
+    for (std::thread& t : threads)
+      {
+        if (t.joinable())
+          {
+            t.join();
+          }
+      }
+    threads.clear();
+
+    if (sourceError)
+      {
+        std::rethrow_exception(sourceError);
+      }
+    for (const std::unique_ptr<StageState>& stage : stages)
+      {
+        if (stage->error)
+          {
+            std::rethrow_exception(stage->error);
+          }
+      }
+  }
+
+  void Pipeline::run()
+  {
+    start();
+    wait();
+  }
+
+  void Pipeline::stop()
+  {
+    stopRequested.store(true, std::memory_order_relaxed);
+  }
+
+  void Pipeline::sourceLoop()
+  {
+    pinCurrentThread(sourceCpu);
+
+    StageState& first = *stages.front();
+    std::vector<AttitudeRecord> records(batchSize);
+    std::vector<Slot> slots(batchSize);
+
+    try
+      {
+        while (!stopRequested.load(std::memory_order_relaxed))
+          {
+            const std::size_t n = source(records.data(), batchSize);
+            if (n == 0)
+              {
+                break;
+              }
+
+            const std::int64_t t = nowNs();
+            for (std::size_t i = 0; i < n; ++i)
+              {
+                slots[i].record = records[i];
+                slots[i].enqueuedNs = t;
+              }
+            pushAll(first.input, slots.data(), n, first.backpressure, stopRequested);
+          }
+      }
+    catch (...)
+      {
+        sourceError = std::current_exception();
+        stop();
+      }
+    first.input.close();
+  }
+
+  void Pipeline::stageLoop(std::size_t index)
+  {
+    StageState& self = *stages[index];
+    StageState* next = (index + 1 < stages.size()) ? stages[index + 1].get() : nullptr;
+    pinCurrentThread(self.cpu);
+
+    std::vector<Slot> batch(batchSize);
+    for (;;)
+      {
+        std::size_t n = self.input.popBatch(batch.data(), batchSize);
+        if (n == 0)
+          {
+            // Re-check after seeing "closed": items pushed before
+            // close() are guaranteed to be visible now.
+            if (self.input.isClosed())
+              {
+                n = self.input.popBatch(batch.data(), batchSize);
+                if (n == 0)
+                  {
+                    break;
+                  }
+              }
+            else
+              {
+                std::this_thread::yield();
+                continue;
+              }
+          }
+
+        // A failing stage stops the pipeline; wait() rethrows
+        try
+          {
+            for (std::size_t i = 0; i < n; ++i)
+              {
+                self.fn(batch[i].record);
+              }
+          }
+        catch (...)
+          {
+            self.error = std::current_exception();
+            stop();
+            break;
+          }
+
+        // One clock read per batch
+        const std::int64_t t = nowNs();
+        for (std::size_t i = 0; i < n; ++i)
+          {
+            self.latency.record(t - batch[i].enqueuedNs);
+            batch[i].enqueuedNs = t;
+          }
+        self.processed.fetch_add(n, std::memory_order_relaxed);
+
+        if (next)
+          {
+            pushAll(next->input, batch.data(), n, next->backpressure, stopRequested);
+          }
+      }
+
+    if (next)
+      {
+        next->input.close();
+      }
+  }
+
+  std::size_t Pipeline::stageCount() const
+  {
+    return stages.size();
+  }
+
+  const std::string& Pipeline::stageName(std::size_t stage) const
+  {
+    return stages.at(stage)->name;
+  }
+
+  const LatencyHistogram& Pipeline::stageLatency(std::size_t stage) const
+  {
+    return stages.at(stage)->latency;
+  }
+
+  std::uint64_t Pipeline::backpressureEvents(std::size_t stage) const
+  {
+    return stages.at(stage)->backpressure.load(std::memory_order_relaxed);
+  }
+
+  std::uint64_t Pipeline::processed(std::size_t stage) const
+  {
+    return stages.at(stage)->processed.load(std::memory_order_relaxed);
+  }
+
+  bool pinCurrentThread(int cpu)
+  {
+    if (cpu < 0)
+      {
+        return false;
+      }
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+  }
+
+}; // namespace AML
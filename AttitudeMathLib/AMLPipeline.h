@@ -0,0 +1,207 @@
+#ifndef AML_PIPELINE_H
+#define AML_PIPELINE_H
+
+#include "AMLVector3.h"
+#include "AMLMatrix33.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace AML
+{
+  // ============================================================
+  // AttitudeRecord
+  //
+  // Fixed-size sample passed between pipeline stages.
+  //
+  // - sequence: monotonically increasing sample counter
+  // - timestampNs: sensor time of the sample
+  // - angularRate / acceleration / magneticField: raw IMU data
+  // - attitude: current attitude estimate (filled by the
+  //   attitude update stage)
+  //
+  // Plain data only, so records can be copied through the ring
+  // buffers without allocation.
+  // ============================================================
+  struct AttitudeRecord
+  {
+    std::uint64_t sequence = 0;
+    std::int64_t timestampNs = 0;
+    Vector3 angularRate;
+    Vector3 acceleration;
+    Vector3 magneticField;
+    Matrix33 attitude;
+  };
+
+  // ============================================================
+  // LatencyHistogram
+  //
+  // Log2-bucketed histogram of latencies in nanoseconds.
+  // Bucket i counts samples in [2^i, 2^(i+1)); bucket 0 also
+  // holds 0 ns samples.
+  //
+  // One thread records, any thread may read. Counters are
+  // relaxed atomics, so a concurrent read is a close snapshot.
+  // ============================================================
+  class LatencyHistogram
+  {
+  public:
+    static constexpr std::size_t bucketCount = 64;
+
+    LatencyHistogram();
+
+    // Adds one sample
+    void record(std::int64_t nanoseconds);
+
+    // Clears all samples
+    void reset();
+
+    // Number of recorded samples
+    std::uint64_t count() const;
+
+    // Number of samples in bucket i
+    std::uint64_t bucket(std::size_t i) const;
+
+    // Largest recorded sample
+    std::int64_t max() const;
+
+    // Upper bound of the bucket holding the p-th fraction of
+    // samples, p in [0, 1]. Returns 0 when empty.
+    std::int64_t percentile(double p) const;
+
+  private:
+    std::atomic<std::uint64_t> buckets[bucketCount];
+    std::atomic<std::uint64_t> total;
+    std::atomic<std::int64_t> maxNs;
+
+  }; // class LatencyHistogram
+
+  // ============================================================
+  // Pipeline
+  //
+  // Chain of stages connected by bounded lock-free SPSC ring
+  // buffers of AttitudeRecord:
+  //
+  //   source -> [queue] -> stage 0 -> [queue] -> stage 1 -> ...
+  //
+  // Each stage (and the source) runs on its own thread and can be
+  // pinned to a CPU. Records are handed off in batches of up to
+  // "batchSize" to amortize synchronization. When a queue is full
+  // the upstream thread waits (backpressure) and the event is
+  // counted. Each stage keeps a latency histogram measured from
+  // the time a record is queued for the stage until the stage has
+  // processed it.
+  //
+  // Typical use:
+  //   Pipeline p(1024, 32);
+  //   p.setSource(imuSource);
+  //   p.addStage("attitude", updateAttitude, 1);
+  //   p.addStage("publish", publish, 2);
+  //   p.run();
+  // ============================================================
+  class Pipeline
+  {
+  public:
+
+    // Writes up to maxCount records and returns how many were
+    // written. Returning 0 ends the stream.
+    using Source = std::function<std::size_t(AttitudeRecord* records, std::size_t maxCount)>;
+
+    // Processes one record in place. The last stage acts as sink.
+    using Stage = std::function<void(AttitudeRecord& record)>;
+
+    // ------------------------------------------------------------
+    // Constructor
+    // - queueCapacity: records per inter-stage queue (rounded up
+    //   to a power of two)
+    // - batchSize: maximum records moved per handoff
+    // ------------------------------------------------------------
+    explicit Pipeline(std::size_t queueCapacity = 1024, std::size_t batchSize = 32);
+
+    // Stops and joins any running threads
+    ~Pipeline();
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    // ------------------------------------------------------------
+    // Configuration (before start)
+    //
+    // cpu < 0 leaves the thread unpinned. Both throw
+    // std::logic_error between start() and the end of wait().
+    // ------------------------------------------------------------
+    void setSource(Source source, int cpu = -1);
+    void addStage(const std::string& name, Stage stage, int cpu = -1);
+
+    // ------------------------------------------------------------
+    // Execution
+    //
+    // start() launches all threads and returns immediately.
+    // wait() blocks until the source is exhausted (or stop() was
+    // called) and every queued record has been processed.
+    // run() is start() followed by wait().
+    // stop() asks the source to end the stream early. Records that
+    // are waiting for room in a full queue at that point are
+    // dropped, so a stalled stage cannot block the shutdown.
+    //
+    // If the source or a stage throws, the pipeline stops and
+    // wait() rethrows the exception (the source's first, then the
+    // stages' in order).
+    //
+    // A pipeline can be started again once wait() has returned;
+    // queues, counters and histograms start from zero.
+    // ------------------------------------------------------------
+    void start();
+    void wait();
+    void run();
+    void stop();
+
+    // ------------------------------------------------------------
+    // Statistics (valid during and after a run)
+    // ------------------------------------------------------------
+    std::size_t stageCount() const;
+    const std::string& stageName(std::size_t stage) const;
+
+    // Queue-to-completion latency of a stage
+    const LatencyHistogram& stageLatency(std::size_t stage) const;
+
+    // Number of times the thread feeding a stage found its input
+    // queue full and had to wait
+    std::uint64_t backpressureEvents(std::size_t stage) const;
+
+    // Records processed by a stage
+    std::uint64_t processed(std::size_t stage) const;
+
+  private:
+    struct StageState;
+
+    void sourceLoop();
+    void stageLoop(std::size_t index);
+
+    std::size_t queueCapacity;
+    std::size_t batchSize;
+
+    Source source;
+    int sourceCpu;
+
+    std::vector<std::unique_ptr<StageState>> stages;
+    std::vector<std::thread> threads;
+    std::atomic<bool> stopRequested;
+    std::exception_ptr sourceError;
+
+  }; // class Pipeline
+
+  // Pins the calling thread to a CPU.
+  // Returns false if the platform does not support it or the call fails.
+  bool pinCurrentThread(int cpu);
+
+} // namespace AML
+
+#endif // AML_PIPELINE_H
@@ -0,0 +1,225 @@
+#include "AMLQuaternion.h"
+#include "AMLVector3.h"
+#include "AMLMatrix33.h"
+
+#include <cmath>
+
+namespace AML
+{
+
+  // Default constructor
+  Quaternion::Quaternion() :
+    q0(1.0), q1(0.0), q2(0.0), q3(0.0)
+  {}
+
+  // Component-wise constructor
+  Quaternion::Quaternion(double q0_, double q1_, double q2_, double q3_) :
+    q0(q0_), q1(q1_), q2(q2_), q3(q3_)
+  {}
+
+  // Scalar / vector constructor
+  Quaternion::Quaternion(double scalar, const Vector3& vector) :
+    q0(scalar), q1(vector.x), q2(vector.y), q3(vector.z)
+  {}
+
+  // Array constructor
+  Quaternion::Quaternion(const double data_[4]) :
+    q0(data_[0]), q1(data_[1]), q2(data_[2]), q3(data_[3])
+  {}
+
+  // Compound assignment operators
+  Quaternion& Quaternion::operator+=(const Quaternion& rhs)
+  {
+    q0 += rhs.q0;
+    q1 += rhs.q1;
+    q2 += rhs.q2;
+    q3 += rhs.q3;
+    return *this;
+  }
+  Quaternion& Quaternion::operator-=(const Quaternion& rhs)
+  {
+    q0 -= rhs.q0;
+    q1 -= rhs.q1;
+    q2 -= rhs.q2;
+    q3 -= rhs.q3;
+    return *this;
+  }
+  Quaternion& Quaternion::operator*=(const Quaternion& rhs)
+  {
+    double r0 = q0 * rhs.q0 - q1 * rhs.q1 - q2 * rhs.q2 - q3 * rhs.q3;
+    double r1 = q0 * rhs.q1 + q1 * rhs.q0 + q2 * rhs.q3 - q3 * rhs.q2;
+    double r2 = q0 * rhs.q2 - q1 * rhs.q3 + q2 * rhs.q0 + q3 * rhs.q1;
+    double r3 = q0 * rhs.q3 + q1 * rhs.q2 - q2 * rhs.q1 + q3 * rhs.q0;
+
+    q0 = r0;
+    q1 = r1;
+    q2 = r2;
+    q3 = r3;
+    return *this;
+  }
+  Quaternion& Quaternion::operator*=(double s)
+  {
+    q0 *= s;
+    q1 *= s;
+    q2 *= s;
+    q3 *= s;
+    return *this;
+  }
+  Quaternion& Quaternion::operator/=(double s)
+  {
+    q0 /= s;
+    q1 /= s;
+    q2 /= s;
+    q3 /= s;
+    return *this;
+  }
+
+  // Identity rotation
+  const Quaternion Quaternion::identity()
+  {
+    return Quaternion(1.0, 0.0, 0.0, 0.0);
+  }
+
+  // Unary minus
+  Quaternion operator-(const Quaternion& rhs)
+  {
+    return Quaternion(-rhs.q0, -rhs.q1, -rhs.q2, -rhs.q3);
+  }
+
+  // Binary operators
+  Quaternion operator+(const Quaternion& lhs, const Quaternion& rhs) {return Quaternion(lhs) += rhs;}
+  Quaternion operator-(const Quaternion& lhs, const Quaternion& rhs) {return Quaternion(lhs) -= rhs;}
+  Quaternion operator*(const Quaternion& lhs, const Quaternion& rhs) {return Quaternion(lhs) *= rhs;}
+  Quaternion operator*(const Quaternion& lhs, double s) {return Quaternion(lhs) *= s;}
+  Quaternion operator*(double s, const Quaternion& rhs) {return Quaternion(rhs) *= s;}
+  Quaternion operator/(const Quaternion& lhs, double s) {return Quaternion(lhs) /= s;}
+
+  // Euclidean length of the four components
+  double norm(const Quaternion& rhs)
+  {
+    return sqrt(rhs.q0 * rhs.q0 + rhs.q1 * rhs.q1 + rhs.q2 * rhs.q2 + rhs.q3 * rhs.q3);
+  }
+
+  // Normalizes the quaternion in place
+  void normalize(Quaternion& rhs)
+  {
+    double mag = norm(rhs);
+    if (mag > 0.0)
+      {
+        rhs /= mag;
+      }
+  }
+
+  // Returns a normalized copy
+  Quaternion unit(const Quaternion& rhs)
+  {
+    Quaternion result(rhs);
+    normalize(result);
+    return result;
+  }
+
+  Quaternion conjugate(const Quaternion& rhs)
+  {
+    return Quaternion(rhs.q0, -rhs.q1, -rhs.q2, -rhs.q3);
+  }
+
+  Quaternion inverse(const Quaternion& rhs)
+  {
+    return conjugate(rhs) / dot(rhs, rhs);
+  }
+
+  double dot(const Quaternion& lhs, const Quaternion& rhs)
+  {
+    return lhs.q0 * rhs.q0 + lhs.q1 * rhs.q1 + lhs.q2 * rhs.q2 + lhs.q3 * rhs.q3;
+  }
+
+  Vector3 rotate(const Quaternion& q, const Vector3& v)
+  {
+    Quaternion r = q * Quaternion(0.0, v) * conjugate(q);
+    return Vector3(r.q1, r.q2, r.q3);
+  }
+
+  // Quaternion to rotation matrix
+  Matrix33 quat2dcm(const Quaternion& q)
+  {
+    double q0q0 = q.q0 * q.q0;
+    double q1q1 = q.q1 * q.q1;
+    double q2q2 = q.q2 * q.q2;
+    double q3q3 = q.q3 * q.q3;
+    double q0q1 = q.q0 * q.q1;
+    double q0q2 = q.q0 * q.q2;
+    double q0q3 = q.q0 * q.q3;
+    double q1q2 = q.q1 * q.q2;
+    double q1q3 = q.q1 * q.q3;
+    double q2q3 = q.q2 * q.q3;
+
+    double result[9];
+    result[0] = q0q0 + q1q1 - q2q2 - q3q3;
+    result[1] = 2.0 * (q1q2 - q0q3);
+    result[2] = 2.0 * (q1q3 + q0q2);
+    result[3] = 2.0 * (q1q2 + q0q3);
+    result[4] = q0q0 - q1q1 + q2q2 - q3q3;
+    result[5] = 2.0 * (q2q3 - q0q1);
+    result[6] = 2.0 * (q1q3 - q0q2);
+    result[7] = 2.0 * (q2q3 + q0q1);
+    result[8] = q0q0 - q1q1 - q2q2 + q3q3;
+    return Matrix33(result);
+  }
+
+  // Rotation matrix to quaternion (Shepperd's method)
+  // Picks the largest of 4q0^2, 4q1^2, 4q2^2, 4q3^2 as the pivot
+  // so the division is always well conditioned.
+  Quaternion dcm2quat(const Matrix33& R)
+  {
+    double trace = R.m11 + R.m22 + R.m33;
+    Quaternion q;
+
+    if (trace >= R.m11 && trace >= R.m22 && trace >= R.m33)
+      {
+        double s = 2.0 * sqrt(1.0 + trace);
+        q = Quaternion(0.25 * s,
+                       (R.m32 - R.m23) / s,
+                       (R.m13 - R.m31) / s,
+                       (R.m21 - R.m12) / s);
+      }
+    else if (R.m11 >= R.m22 && R.m11 >= R.m33)
+      {
+        double s = 2.0 * sqrt(1.0 + R.m11 - R.m22 - R.m33);
+        q = Quaternion((R.m32 - R.m23) / s,
+                       0.25 * s,
+                       (R.m12 + R.m21) / s,
+                       (R.m13 + R.m31) / s);
+      }
+    else if (R.m22 >= R.m33)
+      {
+        double s = 2.0 * sqrt(1.0 - R.m11 + R.m22 - R.m33);
+        q = Quaternion((R.m13 - R.m31) / s,
+                       (R.m12 + R.m21) / s,
+                       0.25 * s,
+                       (R.m23 + R.m32) / s);
+      }
+    else
+      {
+        double s = 2.0 * sqrt(1.0 - R.m11 - R.m22 + R.m33);
+        q = Quaternion((R.m21 - R.m12) / s,
+                       (R.m13 + R.m31) / s,
+                       (R.m23 + R.m32) / s,
+                       0.25 * s);
+      }
+
+    if (q.q0 < 0.0)
+      {
+        q = -q;
+      }
+    normalize(q);
+    return q;
+  }
+
+  // Stream output
+  std::ostream& operator<<(std::ostream& os, const Quaternion& obj)
+  {
+    os << "[" << obj.q0 << ", " << obj.q1 << ", " << obj.q2 << ", " << obj.q3 << "]";
+    return os;
+  }
+
+} // namespace AML
@@ -0,0 +1,138 @@
+#ifndef AML_QUATERNION_H
+#define AML_QUATERNION_H
+
+#include <iostream>
+
+namespace AML
+{
+  // Forward declarations
+  class Vector3;
+  class Matrix33;
+
+  // ============================================================
+  // Quaternion
+  //
+  // Represents a double-precision quaternion q0 + q1 i + q2 j + q3 k
+  // with the scalar part first.
+  //
+  // Intended use:
+  // - Unit quaternions as a compact attitude representation
+  // - Hamilton product composition: (p * q) applies q, then p
+  //
+  // A unit quaternion q maps a vector v to q * v * conjugate(q),
+  // which is the same rotation as quat2dcm(q) * v.
+  // ============================================================
+  class Quaternion
+  {
+  public:
+
+    // ------------------------------------------------------------
+    // Storage
+    //
+    // A union is used so the same memory can be accessed as:
+    //   - data[0] ... data[3]
+    //   - q0 (scalar), q1, q2, q3 (vector)
+    // ------------------------------------------------------------
+    union
+    {
+      double data[4];
+      struct { double q0, q1, q2, q3; };
+    };
+
+    // ------------------------------------------------------------
+    // Constructors
+    // ------------------------------------------------------------
+
+    // Default constructor
+    // Initializes to the identity rotation (1, 0, 0, 0).
+    Quaternion();
+
+    // Component-wise constructor
+    Quaternion(double q0, double q1, double q2, double q3);
+
+    // Scalar / vector constructor
+    Quaternion(double scalar, const Vector3& vector);
+
+    // Array constructor
+    // Copies values from a raw double[4], scalar first.
+    explicit Quaternion(const double data[4]);
+
+    // ------------------------------------------------------------
+    // Compound assignment operators
+    //
+    // += and -= are component-wise, *= is the Hamilton product.
+    // ------------------------------------------------------------
+    Quaternion& operator+=(const Quaternion& rhs);
+    Quaternion& operator-=(const Quaternion& rhs);
+    Quaternion& operator*=(const Quaternion& rhs);
+
+    // Applies the scalar to each component
+    Quaternion& operator*=(double s);
+    Quaternion& operator/=(double s);
+
+    // ------------------------------------------------------------
+    // Identity rotation
+    // ------------------------------------------------------------
+    static const Quaternion identity();
+
+  }; // class Quaternion
+
+  // ============================================================
+  // Unary operators
+  // ============================================================
+  Quaternion operator-(const Quaternion& rhs);
+
+  // ============================================================
+  // Binary operators
+  // ============================================================
+  Quaternion operator+(const Quaternion& lhs, const Quaternion& rhs);
+  Quaternion operator-(const Quaternion& lhs, const Quaternion& rhs);
+
+  // Hamilton product
+  Quaternion operator*(const Quaternion& lhs, const Quaternion& rhs);
+
+  Quaternion operator*(const Quaternion& lhs, double s);
+  Quaternion operator*(double s, const Quaternion& rhs);
+  Quaternion operator/(const Quaternion& lhs, double s);
+
+  // ============================================================
+  // Quaternion utilities
+  // ============================================================
+
+  // Euclidean length of the four components
+  double norm(const Quaternion& rhs);
+
+  // Normalizes the quaternion in place
+  void normalize(Quaternion& rhs);
+
+  // Returns a normalized copy
+  Quaternion unit(const Quaternion& rhs);
+
+  // Returns (q0, -q1, -q2, -q3)
+  Quaternion conjugate(const Quaternion& rhs);
+
+  // Returns conjugate(q) / |q|^2
+  Quaternion inverse(const Quaternion& rhs);
+
+  // Four-component dot product
+  double dot(const Quaternion& lhs, const Quaternion& rhs);
+
+  // Rotates a vector: q * v * conjugate(q) for a unit quaternion
+  Vector3 rotate(const Quaternion& q, const Vector3& v);
+
+  // ============================================================
+  // Conversions
+  //
+  // quat2dcm returns the rotation matrix R with R * v equal to
+  // rotate(q, v). dcm2quat is its inverse (Shepperd's method) and
+  // returns the quaternion with q0 >= 0.
+  // ============================================================
+  Matrix33 quat2dcm(const Quaternion& q);
+  Quaternion dcm2quat(const Matrix33& R);
+
+  // Stream output
+  std::ostream& operator<<(std::ostream& os, const Quaternion& obj);
+
+} // namespace AML
+
+#endif // AML_QUATERNION_H
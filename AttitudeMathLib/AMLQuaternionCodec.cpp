@@ -0,0 +1,501 @@
+#include "AMLQuaternionCodec.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <stdexcept>
+
+namespace AML
+{
+
+  namespace
+  {
+    // ------------------------------------------------------------
+    // Smallest-three layout for B bits per kept component
+    // ------------------------------------------------------------
+    template <int B>
+    struct Layout
+    {
+      static constexpr std::size_t bytes = (3 * B + 2 + 7) / 8;
+      static constexpr std::uint64_t mask = (std::uint64_t(1) << B) - 1;
+      // Even number of intervals so 0 has an exact code
+      static constexpr double levels = double(mask - 1);
+      static constexpr double range = std::numbers::sqrt2 / 2.0;
+      static constexpr double step = 2.0 * range / levels;
+      static constexpr double scale = levels / (2.0 * range);
+    };
+
+    // Uniform quantizer on [-range, range] with `levels` intervals.
+    // The clamp keeps out-of-range inputs (rounding, or deltas just
+    // past the limit) on the nearest code.
+    inline std::int32_t quantize(double x, double range, double scale, double levels)
+    {
+      double y = (x + range) * scale + 0.5;
+      y = std::min(std::max(y, 0.0), levels);
+      return std::int32_t(y);
+    }
+
+    // ------------------------------------------------------------
+    // Kernels
+    //
+    // Work on 32-bit fields (dropped index k and the three kept
+    // components) with the index held as a double, so every select
+    // is a double compare and the loops vectorize; fields are only
+    // combined into 64-bit codes when packing bytes.
+    // ------------------------------------------------------------
+    template <int B>
+    inline void encodeFields(double a, double b, double c, double d,
+                             std::int32_t& k, std::int32_t& c0, std::int32_t& c1, std::int32_t& c2)
+    {
+      using L = Layout<B>;
+
+      // Index of the largest magnitude
+      double fa = std::fabs(a), fb = std::fabs(b), fc = std::fabs(c), fd = std::fabs(d);
+      bool hi01 = fb > fa;
+      bool hi23 = fd > fc;
+      double m01 = hi01 ? fb : fa;
+      double m23 = hi23 ? fd : fc;
+      bool upper = m23 > m01;
+      double kd = upper ? (hi23 ? 3.0 : 2.0) : (hi01 ? 1.0 : 0.0);
+      double largest = upper ? (hi23 ? d : c) : (hi01 ? b : a);
+
+      // Kept components in order, sign-flipped so the dropped one is
+      // positive
+      double s = (largest < 0.0) ? -1.0 : 1.0;
+      double o0 = ((kd == 0.0) ? b : a) * s;
+      double o1 = ((kd <= 1.0) ? c : b) * s;
+      double o2 = ((kd <= 2.0) ? d : c) * s;
+
+      k = std::int32_t(kd);
+      c0 = quantize(o0, L::range, L::scale, L::levels);
+      c1 = quantize(o1, L::range, L::scale, L::levels);
+      c2 = quantize(o2, L::range, L::scale, L::levels);
+    }
+
+    template <int B>
+    inline void decodeFields(std::int32_t k, std::int32_t c0, std::int32_t c1, std::int32_t c2,
+                             double& a, double& b, double& c, double& d)
+    {
+      using L = Layout<B>;
+
+      double kd = double(k);
+      double o0 = double(c0) * L::step - L::range;
+      double o1 = double(c1) * L::step - L::range;
+      double o2 = double(c2) * L::step - L::range;
+
+      // Recovered component; renormalize if a corrupt code puts the
+      // kept part outside the unit ball
+      double sum = o0 * o0 + o1 * o1 + o2 * o2;
+      double l = std::sqrt(std::max(0.0, 1.0 - sum));
+      double r = 1.0 / std::sqrt(std::max(1.0, sum));
+
+      a = ((kd == 0.0) ? l : o0) * r;
+      b = ((kd == 1.0) ? l : ((kd == 0.0) ? o0 : o1)) * r;
+      c = ((kd == 2.0) ? l : ((kd <= 1.0) ? o1 : o2)) * r;
+      d = ((kd == 3.0) ? l : o2) * r;
+    }
+
+    template <int B>
+    inline std::uint64_t joinCode(std::int32_t k, std::int32_t c0, std::int32_t c1, std::int32_t c2)
+    {
+      return std::uint64_t(c0)
+        | (std::uint64_t(c1) << B)
+        | (std::uint64_t(c2) << (2 * B))
+        | (std::uint64_t(k) << (3 * B));
+    }
+
+    template <int B>
+    inline void splitCode(std::uint64_t code, std::int32_t& k, std::int32_t& c0, std::int32_t& c1, std::int32_t& c2)
+    {
+      using L = Layout<B>;
+      k = std::int32_t((code >> (3 * B)) & 3);
+      c0 = std::int32_t(code & L::mask);
+      c1 = std::int32_t((code >> B) & L::mask);
+      c2 = std::int32_t((code >> (2 * B)) & L::mask);
+    }
+
+    template <int B>
+    std::uint64_t encodeOne(const Quaternion& q)
+    {
+      std::int32_t k, c0, c1, c2;
+      encodeFields<B>(q.q0, q.q1, q.q2, q.q3, k, c0, c1, c2);
+      return joinCode<B>(k, c0, c1, c2);
+    }
+
+    template <int B>
+    Quaternion decodeOne(std::uint64_t code)
+    {
+      std::int32_t k, c0, c1, c2;
+      splitCode<B>(code, k, c0, c1, c2);
+      Quaternion q;
+      decodeFields<B>(k, c0, c1, c2, q.q0, q.q1, q.q2, q.q3);
+      return q;
+    }
+
+    // Little-endian W-byte words; a plain copy on little-endian hosts
+    template <std::size_t W>
+    inline void storeWord(std::uint64_t word, std::uint8_t* dst)
+    {
+      if constexpr (std::endian::native == std::endian::little)
+        std::memcpy(dst, &word, W);
+      else
+        for (std::size_t j = 0; j < W; ++j)
+          dst[j] = std::uint8_t(word >> (8 * j));
+    }
+
+    template <std::size_t W>
+    inline std::uint64_t loadWord(const std::uint8_t* src)
+    {
+      std::uint64_t word = 0;
+      if constexpr (std::endian::native == std::endian::little)
+        std::memcpy(&word, src, W);
+      else
+        for (std::size_t j = 0; j < W; ++j)
+          word |= std::uint64_t(src[j]) << (8 * j);
+      return word;
+    }
+
+    template <int B>
+    void encodeBatch(const Quaternion* q, std::size_t n, std::uint8_t* out)
+    {
+      constexpr std::size_t W = Layout<B>::bytes;
+      constexpr std::size_t chunk = 64;
+      std::int32_t k[chunk], c0[chunk], c1[chunk], c2[chunk];
+
+      for (std::size_t base = 0; base < n; base += chunk)
+        {
+          std::size_t m = std::min(chunk, n - base);
+
+          // Quantization (vectorized)
+          const Quaternion* src = q + base;
+          for (std::size_t i = 0; i < m; ++i)
+            encodeFields<B>(src[i].q0, src[i].q1, src[i].q2, src[i].q3, k[i], c0[i], c1[i], c2[i]);
+
+          // Byte packing
+          std::uint8_t* dst = out + base * W;
+          for (std::size_t i = 0; i < m; ++i)
+            {
+              std::uint64_t code = joinCode<B>(k[i], c0[i], c1[i], c2[i]);
+              storeWord<W>(code, dst + i * W);
+            }
+        }
+    }
+
+    template <int B>
+    void decodeBatch(const std::uint8_t* in, std::size_t n, Quaternion* q)
+    {
+      constexpr std::size_t W = Layout<B>::bytes;
+      constexpr std::size_t chunk = 64;
+      std::int32_t k[chunk], c0[chunk], c1[chunk], c2[chunk];
+
+      for (std::size_t base = 0; base < n; base += chunk)
+        {
+          std::size_t m = std::min(chunk, n - base);
+
+          // Byte unpacking
+          const std::uint8_t* src = in + base * W;
+          for (std::size_t i = 0; i < m; ++i)
+            {
+              splitCode<B>(loadWord<W>(src + i * W), k[i], c0[i], c1[i], c2[i]);
+            }
+
+          // Reconstruction (vectorized)
+          Quaternion* dst = q + base;
+          for (std::size_t i = 0; i < m; ++i)
+            {
+              double a, b, c, d;
+              decodeFields<B>(k[i], c0[i], c1[i], c2[i], a, b, c, d);
+              dst[i].q0 = a;
+              dst[i].q1 = b;
+              dst[i].q2 = c;
+              dst[i].q3 = d;
+            }
+        }
+    }
+
+    int bitsOf(QuaternionCodec::Width w)
+    {
+      switch (w)
+        {
+        case QuaternionCodec::Width::Bits32: return 10;
+        case QuaternionCodec::Width::Bits48: return 15;
+        case QuaternionCodec::Width::Bits64: return 20;
+        }
+      throw std::invalid_argument("QuaternionCodec: unsupported width");
+    }
+
+    // Delta codes: three components of the step's vector part,
+    // uniform on [-range, range]
+    std::uint64_t encodeDelta(double x, double y, double z, double range, int bits)
+    {
+      double levels = double((std::uint64_t(1) << bits) - 2);
+      double scale = levels / (2.0 * range);
+      return std::uint64_t(quantize(x, range, scale, levels))
+        | (std::uint64_t(quantize(y, range, scale, levels)) << bits)
+        | (std::uint64_t(quantize(z, range, scale, levels)) << (2 * bits));
+    }
+
+    // Applies a delta code to ref: normalize(ref * (s, v))
+    Quaternion applyDelta(const Quaternion& ref, std::uint64_t code, double range, int bits)
+    {
+      std::uint64_t mask = (std::uint64_t(1) << bits) - 1;
+      double step = 2.0 * range / double(mask - 1);
+      double x = double(code & mask) * step - range;
+      double y = double((code >> bits) & mask) * step - range;
+      double z = double((code >> (2 * bits)) & mask) * step - range;
+      double w = std::sqrt(std::max(0.0, 1.0 - x * x - y * y - z * z));
+
+      double q0 = ref.q0 * w - ref.q1 * x - ref.q2 * y - ref.q3 * z;
+      double q1 = ref.q0 * x + ref.q1 * w + ref.q2 * z - ref.q3 * y;
+      double q2 = ref.q0 * y - ref.q1 * z + ref.q2 * w + ref.q3 * x;
+      double q3 = ref.q0 * z + ref.q1 * y - ref.q2 * x + ref.q3 * w;
+      double r = 1.0 / std::sqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+      return Quaternion(q0 * r, q1 * r, q2 * r, q3 * r);
+    }
+
+    double deltaRange(double maxStep)
+    {
+      if (!(maxStep > 0.0 && maxStep <= std::numbers::pi))
+        {
+          throw std::invalid_argument("QuaternionDelta: maxStep must be in (0, pi]");
+        }
+      return std::sin(0.5 * maxStep);
+    }
+
+    std::uint64_t wordMask(std::size_t bytes)
+    {
+      return (bytes >= 8) ? ~std::uint64_t(0) : ((std::uint64_t(1) << (8 * bytes)) - 1);
+    }
+
+    void appendWord(std::uint64_t word, std::size_t bytes, std::vector<std::uint8_t>& out)
+    {
+      for (std::size_t j = 0; j < bytes; ++j)
+        out.push_back(std::uint8_t(word >> (8 * j)));
+    }
+  }
+
+  // ------------------------------------------------------------
+  // QuaternionCodec
+  // ------------------------------------------------------------
+  QuaternionCodec::QuaternionCodec(Width width_) :
+    size(width_)
+  {
+    bitsOf(size);
+  }
+
+  QuaternionCodec::Width QuaternionCodec::width() const
+  {
+    return size;
+  }
+
+  std::size_t QuaternionCodec::bytes() const
+  {
+    return std::size_t(size) / 8;
+  }
+
+  int QuaternionCodec::componentBits() const
+  {
+    return bitsOf(size);
+  }
+
+  double QuaternionCodec::maxAngularError() const
+  {
+    double step = std::numbers::sqrt2 / double((std::uint64_t(1) << componentBits()) - 2);
+    return 2.0 * std::sqrt(3.0) * step;
+  }
+
+  std::uint64_t QuaternionCodec::encode(const Quaternion& q) const
+  {
+    Quaternion u = unit(q);
+    switch (size)
+      {
+      case Width::Bits32: return encodeOne<10>(u);
+      case Width::Bits48: return encodeOne<15>(u);
+      case Width::Bits64: return encodeOne<20>(u);
+      }
+    return 0;
+  }
+
+  Quaternion QuaternionCodec::decode(std::uint64_t code) const
+  {
+    switch (size)
+      {
+      case Width::Bits32: return decodeOne<10>(code);
+      case Width::Bits48: return decodeOne<15>(code);
+      case Width::Bits64: return decodeOne<20>(code);
+      }
+    return Quaternion();
+  }
+
+  void QuaternionCodec::encode(const Quaternion* q, std::size_t n, std::uint8_t* out) const
+  {
+    switch (size)
+      {
+      case Width::Bits32: encodeBatch<10>(q, n, out); break;
+      case Width::Bits48: encodeBatch<15>(q, n, out); break;
+      case Width::Bits64: encodeBatch<20>(q, n, out); break;
+      }
+  }
+
+  void QuaternionCodec::decode(const std::uint8_t* in, std::size_t n, Quaternion* q) const
+  {
+    switch (size)
+      {
+      case Width::Bits32: decodeBatch<10>(in, n, q); break;
+      case Width::Bits48: decodeBatch<15>(in, n, q); break;
+      case Width::Bits64: decodeBatch<20>(in, n, q); break;
+      }
+  }
+
+  std::vector<std::uint8_t> QuaternionCodec::encode(const std::vector<Quaternion>& q) const
+  {
+    std::vector<std::uint8_t> out(q.size() * bytes());
+    encode(q.data(), q.size(), out.data());
+    return out;
+  }
+
+  std::vector<Quaternion> QuaternionCodec::decode(const std::vector<std::uint8_t>& in) const
+  {
+    if (in.size() % bytes() != 0)
+      {
+        throw std::invalid_argument("QuaternionCodec: input is not a whole number of words");
+      }
+    std::vector<Quaternion> q(in.size() / bytes());
+    decode(in.data(), q.size(), q.data());
+    return q;
+  }
+
+  // ------------------------------------------------------------
+  // QuaternionDeltaEncoder
+  // ------------------------------------------------------------
+  QuaternionDeltaEncoder::QuaternionDeltaEncoder(QuaternionCodec::Width width, double maxStep, std::size_t keyInterval_) :
+    codec(width),
+    range(deltaRange(maxStep)),
+    keyInterval(keyInterval_),
+    samples(0),
+    keys(0),
+    sinceKey(0)
+  {}
+
+  void QuaternionDeltaEncoder::push(const Quaternion& q, std::vector<std::uint8_t>& out)
+  {
+    const std::size_t bytes = codec.bytes();
+    const int bits = codec.componentBits();
+    Quaternion u = unit(q);
+
+    bool key = (samples == 0) || (keyInterval > 0 && sinceKey >= keyInterval);
+    double dx = 0.0, dy = 0.0, dz = 0.0;
+    if (!key)
+      {
+        // Step from the decoder's attitude, conjugate(ref) * u, on
+        // the positive-scalar side
+        const Quaternion& r = ref;
+        double d0 = r.q0 * u.q0 + r.q1 * u.q1 + r.q2 * u.q2 + r.q3 * u.q3;
+        double sign = (d0 < 0.0) ? -1.0 : 1.0;
+        dx = sign * (r.q0 * u.q1 - r.q1 * u.q0 - r.q2 * u.q3 + r.q3 * u.q2);
+        dy = sign * (r.q0 * u.q2 - r.q2 * u.q0 - r.q3 * u.q1 + r.q1 * u.q3);
+        dz = sign * (r.q0 * u.q3 - r.q3 * u.q0 - r.q1 * u.q2 + r.q2 * u.q1);
+        key = std::fabs(dx) > range || std::fabs(dy) > range || std::fabs(dz) > range;
+      }
+
+    if (key)
+      {
+        std::uint64_t code = codec.encode(u);
+        if (samples > 0)
+          appendWord(wordMask(bytes), bytes, out);
+        appendWord(code, bytes, out);
+        ref = codec.decode(code);
+        ++keys;
+        sinceKey = 1;
+      }
+    else
+      {
+        std::uint64_t code = encodeDelta(dx, dy, dz, range, bits);
+        appendWord(code, bytes, out);
+        ref = applyDelta(ref, code, range, bits);
+        ++sinceKey;
+      }
+    ++samples;
+  }
+
+  Quaternion QuaternionDeltaEncoder::reference() const
+  {
+    return ref;
+  }
+
+  std::size_t QuaternionDeltaEncoder::count() const
+  {
+    return samples;
+  }
+
+  std::size_t QuaternionDeltaEncoder::keyCount() const
+  {
+    return keys;
+  }
+
+  void QuaternionDeltaEncoder::reset()
+  {
+    ref = Quaternion();
+    samples = 0;
+    keys = 0;
+    sinceKey = 0;
+  }
+
+  // ------------------------------------------------------------
+  // QuaternionDeltaDecoder
+  // ------------------------------------------------------------
+  QuaternionDeltaDecoder::QuaternionDeltaDecoder(QuaternionCodec::Width width, double maxStep) :
+    codec(width),
+    range(deltaRange(maxStep)),
+    started(false),
+    escaped(false)
+  {}
+
+  std::size_t QuaternionDeltaDecoder::decode(const std::uint8_t* in, std::size_t size, std::vector<Quaternion>& out)
+  {
+    const std::size_t bytes = codec.bytes();
+    const int bits = codec.componentBits();
+    if (size % bytes != 0)
+      {
+        throw std::invalid_argument("QuaternionDeltaDecoder: input is not a whole number of words");
+      }
+
+    const std::uint64_t escape = wordMask(bytes);
+    std::size_t decoded = 0;
+    for (std::size_t pos = 0; pos < size; pos += bytes)
+      {
+        std::uint64_t word = 0;
+        for (std::size_t j = 0; j < bytes; ++j)
+          word |= std::uint64_t(in[pos + j]) << (8 * j);
+
+        if (!started || escaped)
+          {
+            ref = codec.decode(word);
+            started = true;
+            escaped = false;
+          }
+        else if (word == escape)
+          {
+            escaped = true;
+            continue;
+          }
+        else
+          {
+            ref = applyDelta(ref, word, range, bits);
+          }
+        out.push_back(ref);
+        ++decoded;
+      }
+    return decoded;
+  }
+
+  void QuaternionDeltaDecoder::reset()
+  {
+    ref = Quaternion();
+    started = false;
+    escaped = false;
+  }
+
+} // namespace AML
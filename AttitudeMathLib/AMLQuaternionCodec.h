@@ -0,0 +1,172 @@
+#ifndef AML_QUATERNIONCODEC_H
+#define AML_QUATERNIONCODEC_H
+
+#include "AMLQuaternion.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AML
+{
+  // ============================================================
+  // QuaternionCodec
+  //
+  // Smallest-three quantization of unit quaternions.
+  //
+  // q and -q are the same attitude, so the largest-magnitude
+  // component can be made positive and dropped: it is recovered as
+  // sqrt(1 - a^2 - b^2 - c^2). The other three lie in
+  // [-1/sqrt(2), 1/sqrt(2)] and are quantized uniformly with
+  // 2^b - 2 steps (even, so zero components are exact).
+  //
+  //   Width   index  components  bytes  step (delta)   max error
+  //   Bits32  2      3 x 10      4      1.38e-3        4.8e-3 rad (0.27 deg)
+  //   Bits48  2      3 x 15      6      4.32e-5        1.5e-4 rad (0.0086 deg)
+  //   Bits64  2      3 x 20      8      1.35e-6        4.7e-6 rad (0.00027 deg)
+  //
+  // Error bound: each component is off by at most delta / 2, so the
+  // three-vector is off by at most sqrt(3) / 2 * delta. The dropped
+  // component is >= 1/2, which limits how much that error grows
+  // when it is recovered (slope <= sqrt(3)), giving a 4D chord of at
+  // most sqrt(3) * delta and a rotation angle of at most
+  // 2 * sqrt(3) * delta (first order; see maxAngularError()).
+  //
+  // Code layout (little-endian, low bits first):
+  //   bits [0, b)      first kept component
+  //   bits [b, 2b)     second kept component
+  //   bits [2b, 3b)    third kept component
+  //   bits [3b, 3b+2)  index of the dropped component
+  // Kept components are in q0..q3 order with the dropped one
+  // skipped. Decoded quaternions have a positive largest component.
+  // ============================================================
+  class QuaternionCodec
+  {
+  public:
+    enum class Width
+    {
+      Bits32 = 32,
+      Bits48 = 48,
+      Bits64 = 64
+    };
+
+    explicit QuaternionCodec(Width width_ = Width::Bits32);
+
+    Width width() const;
+
+    // Bytes per encoded attitude (4, 6 or 8)
+    std::size_t bytes() const;
+
+    // Bits per kept component (10, 15 or 20)
+    int componentBits() const;
+
+    // Worst-case rotation angle between an attitude and its decoded
+    // value, in radians
+    double maxAngularError() const;
+
+    // ------------------------------------------------------------
+    // Single attitude
+    //
+    // The input is normalized first. The code occupies the low
+    // 8 * bytes() bits.
+    // ------------------------------------------------------------
+    std::uint64_t encode(const Quaternion& q) const;
+    Quaternion decode(std::uint64_t code) const;
+
+    // ------------------------------------------------------------
+    // Batches
+    //
+    // Packed little-endian, bytes() per attitude with no padding
+    // (out / in hold n * bytes() bytes). Inputs are expected to be
+    // unit quaternions (not renormalized). The kernels are branch-
+    // free so the quantization vectorizes. The vector decode throws
+    // std::invalid_argument unless in.size() is a multiple of
+    // bytes().
+    // ------------------------------------------------------------
+    void encode(const Quaternion* q, std::size_t n, std::uint8_t* out) const;
+    void decode(const std::uint8_t* in, std::size_t n, Quaternion* q) const;
+
+    std::vector<std::uint8_t> encode(const std::vector<Quaternion>& q) const;
+    std::vector<Quaternion> decode(const std::vector<std::uint8_t>& in) const;
+
+  private:
+    Width size;
+  };
+
+  // ============================================================
+  // Delta streams
+  //
+  // Slowly varying attitude streams are coded as the rotation from
+  // the previous decoded attitude, d = conjugate(prev) * q. Its
+  // vector part is at most sin(maxStep / 2) in magnitude, so the
+  // same number of bits gives a much finer step than the absolute
+  // code:
+  //
+  //   step = 2 * sin(maxStep / 2) / (2^b - 2)
+  //
+  // e.g. Bits32 with maxStep = 0.05 rad: about 4.9e-5 per component
+  // (vs 1.38e-3 absolute). The encoder works from the decoded
+  // attitude, so quantization errors do not accumulate.
+  //
+  // Stream layout: words of QuaternionCodec::bytes() bytes. The
+  // first word is an absolute code. Each following word is a delta
+  // code (low 3b bits), or the escape word (all ones, which no
+  // delta code can be) followed by an absolute code. Absolute
+  // codes are emitted when the step exceeds maxStep, and every
+  // keyInterval samples when keyInterval > 0 (so a reader can
+  // resynchronize).
+  // ============================================================
+  class QuaternionDeltaEncoder
+  {
+  public:
+    QuaternionDeltaEncoder(QuaternionCodec::Width width, double maxStep, std::size_t keyInterval = 0);
+
+    // Appends the code of q to out
+    void push(const Quaternion& q, std::vector<std::uint8_t>& out);
+
+    // Attitude the decoder will reconstruct for the last sample
+    Quaternion reference() const;
+
+    // Samples pushed and absolute codes emitted since construction
+    // or reset()
+    std::size_t count() const;
+    std::size_t keyCount() const;
+
+    // Starts a new stream (next sample is absolute)
+    void reset();
+
+  private:
+    QuaternionCodec codec;
+    double range;
+    std::size_t keyInterval;
+    Quaternion ref;
+    std::size_t samples;
+    std::size_t keys;
+    std::size_t sinceKey;
+  };
+
+  class QuaternionDeltaDecoder
+  {
+  public:
+    QuaternionDeltaDecoder(QuaternionCodec::Width width, double maxStep);
+
+    // Decodes whole words of in[0, size) and appends the attitudes
+    // to out. Streams may be fed in pieces; size must be a multiple
+    // of the word size (std::invalid_argument otherwise). Returns
+    // the number of attitudes appended.
+    std::size_t decode(const std::uint8_t* in, std::size_t size, std::vector<Quaternion>& out);
+
+    // Starts a new stream
+    void reset();
+
+  private:
+    QuaternionCodec codec;
+    double range;
+    Quaternion ref;
+    bool started;
+    bool escaped;
+  };
+
+} // namespace AML
+
+#endif // AML_QUATERNIONCODEC_H
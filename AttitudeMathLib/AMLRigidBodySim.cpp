@@ -0,0 +1,574 @@
+#include "AMLRigidBodySim.h"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace AML
+{
+
+  namespace
+  {
+    // Bodies advanced together through all steps of a run, sized
+    // so the working set of a block stays in L1/L2
+    constexpr std::size_t blockSize = 256;
+
+    // Inertia (6), state / stage / rate (3 x 7) and torque (3)
+    constexpr std::size_t arrayCount = 30;
+
+    // Whole cache lines per array plus one line of stagger
+    constexpr std::size_t arrayStride(std::size_t count)
+    {
+      return (count + 7) / 8 * 8 + 8;
+    }
+
+    inline void normalizeQuaternion(double& a, double& b, double& c, double& d)
+    {
+      double r = 1.0 / std::sqrt(a * a + b * b + c * c + d * d);
+      a *= r;
+      b *= r;
+      c *= r;
+      d *= r;
+    }
+
+    // ------------------------------------------------------------
+    // RK4 stage kernel
+    //
+    // Evaluates the rate at the stage state s (the current state y
+    // for Stage 0), accumulates it into k with the RK4 weight and
+    // writes the next stage state. The last stage writes the new
+    // state into y instead.
+    // ------------------------------------------------------------
+    template <int Stage, bool HasTorque>
+    void rk4Stage(std::size_t begin, std::size_t end, double h,
+                  double* __restrict y0, double* __restrict y1, double* __restrict y2, double* __restrict y3,
+                  double* __restrict ywx, double* __restrict ywy, double* __restrict ywz,
+                  double* __restrict s0, double* __restrict s1, double* __restrict s2, double* __restrict s3,
+                  double* __restrict swx, double* __restrict swy, double* __restrict swz,
+                  double* __restrict k0, double* __restrict k1, double* __restrict k2, double* __restrict k3,
+                  double* __restrict kwx, double* __restrict kwy, double* __restrict kwz,
+                  const double* __restrict ix, const double* __restrict iy, const double* __restrict iz,
+                  const double* __restrict invIx, const double* __restrict invIy, const double* __restrict invIz,
+                  const double* __restrict tx, const double* __restrict ty, const double* __restrict tz)
+    {
+      // Step to the next stage state and weight of this stage
+      constexpr double next = (Stage == 2) ? 1.0 : 0.5;
+      constexpr double weight = (Stage == 0 || Stage == 3) ? 1.0 : 2.0;
+
+      for (std::size_t i = begin; i < end; ++i)
+        {
+          double a, b, c, d, wx, wy, wz;
+          if constexpr (Stage == 0)
+            {
+              a = y0[i]; b = y1[i]; c = y2[i]; d = y3[i];
+              wx = ywx[i]; wy = ywy[i]; wz = ywz[i];
+            }
+          else
+            {
+              a = s0[i]; b = s1[i]; c = s2[i]; d = s3[i];
+              wx = swx[i]; wy = swy[i]; wz = swz[i];
+            }
+
+          // dq/dt = 0.5 * q * (0, w)
+          double da = -0.5 * (b * wx + c * wy + d * wz);
+          double db = 0.5 * (a * wx + c * wz - d * wy);
+          double dc = 0.5 * (a * wy + d * wx - b * wz);
+          double dd = 0.5 * (a * wz + b * wy - c * wx);
+
+          // dw/dt = I^-1 (tau - w x I w)
+          double ex = (iz[i] - iy[i]) * wy * wz;
+          double ey = (ix[i] - iz[i]) * wz * wx;
+          double ez = (iy[i] - ix[i]) * wx * wy;
+          if constexpr (HasTorque)
+            {
+              ex -= tx[i];
+              ey -= ty[i];
+              ez -= tz[i];
+            }
+          double dwx = -ex * invIx[i];
+          double dwy = -ey * invIy[i];
+          double dwz = -ez * invIz[i];
+
+          if constexpr (Stage == 0)
+            {
+              k0[i] = da; k1[i] = db; k2[i] = dc; k3[i] = dd;
+              kwx[i] = dwx; kwy[i] = dwy; kwz[i] = dwz;
+            }
+          else
+            {
+              k0[i] += weight * da; k1[i] += weight * db; k2[i] += weight * dc; k3[i] += weight * dd;
+              kwx[i] += weight * dwx; kwy[i] += weight * dwy; kwz[i] += weight * dwz;
+            }
+
+          if constexpr (Stage < 3)
+            {
+              double hs = next * h;
+              s0[i] = y0[i] + hs * da; s1[i] = y1[i] + hs * db;
+              s2[i] = y2[i] + hs * dc; s3[i] = y3[i] + hs * dd;
+              swx[i] = ywx[i] + hs * dwx; swy[i] = ywy[i] + hs * dwy; swz[i] = ywz[i] + hs * dwz;
+            }
+          else
+            {
+              double h6 = h / 6.0;
+              double na = y0[i] + h6 * k0[i], nb = y1[i] + h6 * k1[i];
+              double nc = y2[i] + h6 * k2[i], nd = y3[i] + h6 * k3[i];
+              normalizeQuaternion(na, nb, nc, nd);
+              y0[i] = na; y1[i] = nb; y2[i] = nc; y3[i] = nd;
+              ywx[i] += h6 * kwx[i]; ywy[i] += h6 * kwy[i]; ywz[i] += h6 * kwz[i];
+            }
+        }
+    }
+
+    // ------------------------------------------------------------
+    // Free rigid-body sub-flows
+    //
+    // Exact flow of H_a = m_a^2 / (2 I_a) for time h: the body
+    // turns about principal axis a by theta = h * m_a / I_a, so the
+    // body-frame momentum m rotates by -theta and q is multiplied
+    // on the right by the axis-a rotation.
+    // ------------------------------------------------------------
+    template <int Axis>
+    inline void freeFlow(double h, double invI,
+                         double& mx, double& my, double& mz,
+                         double& a, double& b, double& c, double& d)
+    {
+      double m = (Axis == 0) ? mx : ((Axis == 1) ? my : mz);
+      double halfTheta = 0.5 * h * m * invI;
+      double c2 = std::cos(halfTheta);
+      double s2 = std::sin(halfTheta);
+      double co = 1.0 - 2.0 * s2 * s2;
+      double si = 2.0 * s2 * c2;
+
+      double na, nb, nc, nd;
+      if constexpr (Axis == 0)
+        {
+          double ny = co * my + si * mz;
+          mz = co * mz - si * my;
+          my = ny;
+          na = a * c2 - b * s2; nb = b * c2 + a * s2;
+          nc = c * c2 + d * s2; nd = d * c2 - c * s2;
+        }
+      else if constexpr (Axis == 1)
+        {
+          double nx = co * mx - si * mz;
+          mz = si * mx + co * mz;
+          mx = nx;
+          na = a * c2 - c * s2; nb = b * c2 - d * s2;
+          nc = c * c2 + a * s2; nd = d * c2 + b * s2;
+        }
+      else
+        {
+          double nx = co * mx + si * my;
+          my = co * my - si * mx;
+          mx = nx;
+          na = a * c2 - d * s2; nb = b * c2 + c * s2;
+          nc = c * c2 - b * s2; nd = d * c2 + a * s2;
+        }
+      a = na; b = nb; c = nc; d = nd;
+    }
+
+    // Half kick (when HasTorque) followed by the symmetric drift
+    // x(h/2) y(h/2) z(h) y(h/2) x(h/2)
+    template <bool HasTorque>
+    void symplecticDrift(std::size_t begin, std::size_t end, double h,
+                         double* __restrict q0, double* __restrict q1, double* __restrict q2, double* __restrict q3,
+                         double* __restrict wx, double* __restrict wy, double* __restrict wz,
+                         const double* __restrict ix, const double* __restrict iy, const double* __restrict iz,
+                         const double* __restrict invIx, const double* __restrict invIy, const double* __restrict invIz,
+                         const double* __restrict tx, const double* __restrict ty, const double* __restrict tz)
+    {
+      const double half = 0.5 * h;
+      for (std::size_t i = begin; i < end; ++i)
+        {
+          double mx = ix[i] * wx[i];
+          double my = iy[i] * wy[i];
+          double mz = iz[i] * wz[i];
+          if constexpr (HasTorque)
+            {
+              mx += half * tx[i];
+              my += half * ty[i];
+              mz += half * tz[i];
+            }
+
+          double a = q0[i], b = q1[i], c = q2[i], d = q3[i];
+          freeFlow<0>(half, invIx[i], mx, my, mz, a, b, c, d);
+          freeFlow<1>(half, invIy[i], mx, my, mz, a, b, c, d);
+          freeFlow<2>(h, invIz[i], mx, my, mz, a, b, c, d);
+          freeFlow<1>(half, invIy[i], mx, my, mz, a, b, c, d);
+          freeFlow<0>(half, invIx[i], mx, my, mz, a, b, c, d);
+          normalizeQuaternion(a, b, c, d);
+
+          q0[i] = a; q1[i] = b; q2[i] = c; q3[i] = d;
+          wx[i] = mx * invIx[i];
+          wy[i] = my * invIy[i];
+          wz[i] = mz * invIz[i];
+        }
+    }
+
+    // Closing half kick
+    void symplecticKick(std::size_t begin, std::size_t end, double h,
+                        double* __restrict wx, double* __restrict wy, double* __restrict wz,
+                        const double* __restrict invIx, const double* __restrict invIy, const double* __restrict invIz,
+                        const double* __restrict tx, const double* __restrict ty, const double* __restrict tz)
+    {
+      const double half = 0.5 * h;
+      for (std::size_t i = begin; i < end; ++i)
+        {
+          wx[i] += half * tx[i] * invIx[i];
+          wy[i] += half * ty[i] * invIy[i];
+          wz[i] += half * tz[i] * invIz[i];
+        }
+    }
+  }
+
+  // ------------------------------------------------------------
+  // StateView / StateArrays
+  // ------------------------------------------------------------
+  Quaternion RigidBodySimulator::StateView::attitude(std::size_t i) const
+  {
+    return Quaternion(q0[i], q1[i], q2[i], q3[i]);
+  }
+
+  Vector3 RigidBodySimulator::StateView::angularVelocity(std::size_t i) const
+  {
+    return Vector3(wx[i], wy[i], wz[i]);
+  }
+
+  RigidBodySimulator::StateView RigidBodySimulator::StateArrays::view() const
+  {
+    return StateView{q0, q1, q2, q3, wx, wy, wz};
+  }
+
+  // ------------------------------------------------------------
+  // RigidBodySimulator
+  // ------------------------------------------------------------
+  RigidBodySimulator::RigidBodySimulator(std::size_t count_, Integrator integrator_, unsigned threads_) :
+    count(count_),
+    threads(threads_),
+    method(integrator_),
+    simTime(0.0)
+  {
+    if (threads == 0)
+      threads = std::max(1u, std::thread::hardware_concurrency());
+
+    storage.assign(arrayCount * arrayStride(count), 0.0);
+    bindArrays();
+
+    std::fill(ix, ix + count, 1.0);
+    std::fill(iy, iy + count, 1.0);
+    std::fill(iz, iz + count, 1.0);
+    std::fill(invIx, invIx + count, 1.0);
+    std::fill(invIy, invIy + count, 1.0);
+    std::fill(invIz, invIz + count, 1.0);
+    std::fill(state.q0, state.q0 + count, 1.0);
+  }
+
+  RigidBodySimulator::RigidBodySimulator(RigidBodySimulator&& other) noexcept :
+    count(other.count),
+    threads(other.threads),
+    method(other.method),
+    simTime(other.simTime),
+    torque(std::move(other.torque)),
+    storage(std::move(other.storage))
+  {
+    bindArrays();
+    other.count = 0;
+    other.storage.clear();
+    other.bindArrays();
+  }
+
+  RigidBodySimulator& RigidBodySimulator::operator=(RigidBodySimulator&& other) noexcept
+  {
+    if (this != &other)
+      {
+        count = other.count;
+        threads = other.threads;
+        method = other.method;
+        simTime = other.simTime;
+        torque = std::move(other.torque);
+        storage = std::move(other.storage);
+        bindArrays();
+        other.count = 0;
+        other.storage.clear();
+        other.bindArrays();
+      }
+    return *this;
+  }
+
+  // Points the arrays into storage, or at nothing when it is empty
+  void RigidBodySimulator::bindArrays()
+  {
+    const std::size_t stride = arrayStride(count);
+    double* next = storage.empty() ? nullptr : storage.data();
+    auto take = [&]()
+    {
+      double* p = next;
+      if (next)
+        next += stride;
+      return p;
+    };
+
+    ix = take(); iy = take(); iz = take();
+    invIx = take(); invIy = take(); invIz = take();
+    for (StateArrays* a : {&state, &stage, &rate})
+      *a = StateArrays{take(), take(), take(), take(), take(), take(), take()};
+    tx = take(); ty = take(); tz = take();
+  }
+
+  std::size_t RigidBodySimulator::size() const
+  {
+    return count;
+  }
+
+  unsigned RigidBodySimulator::threadCount() const
+  {
+    return threads;
+  }
+
+  RigidBodySimulator::Integrator RigidBodySimulator::integrator() const
+  {
+    return method;
+  }
+
+  void RigidBodySimulator::setIntegrator(Integrator integrator_)
+  {
+    method = integrator_;
+  }
+
+  double RigidBodySimulator::time() const
+  {
+    return simTime;
+  }
+
+  void RigidBodySimulator::setTime(double t)
+  {
+    simTime = t;
+  }
+
+  void RigidBodySimulator::setBody(std::size_t i, const DiagMatrix33& inertia_, const Quaternion& q, const Vector3& w)
+  {
+    setInertia(i, inertia_);
+    setAttitude(i, q);
+    setAngularVelocity(i, w);
+  }
+
+  void RigidBodySimulator::setInertia(std::size_t i, const DiagMatrix33& inertia_)
+  {
+    if (!(inertia_.d1 > 0.0 && inertia_.d2 > 0.0 && inertia_.d3 > 0.0))
+      {
+        throw std::invalid_argument("RigidBodySimulator: principal moments of inertia must be positive");
+      }
+    ix[i] = inertia_.d1;
+    iy[i] = inertia_.d2;
+    iz[i] = inertia_.d3;
+    invIx[i] = 1.0 / inertia_.d1;
+    invIy[i] = 1.0 / inertia_.d2;
+    invIz[i] = 1.0 / inertia_.d3;
+  }
+
+  void RigidBodySimulator::setAttitude(std::size_t i, const Quaternion& q)
+  {
+    Quaternion u = unit(q);
+    state.q0[i] = u.q0;
+    state.q1[i] = u.q1;
+    state.q2[i] = u.q2;
+    state.q3[i] = u.q3;
+  }
+
+  void RigidBodySimulator::setAngularVelocity(std::size_t i, const Vector3& w)
+  {
+    state.wx[i] = w.x;
+    state.wy[i] = w.y;
+    state.wz[i] = w.z;
+  }
+
+  DiagMatrix33 RigidBodySimulator::inertia(std::size_t i) const
+  {
+    return DiagMatrix33(ix[i], iy[i], iz[i]);
+  }
+
+  Quaternion RigidBodySimulator::attitude(std::size_t i) const
+  {
+    return state.view().attitude(i);
+  }
+
+  Vector3 RigidBodySimulator::angularVelocity(std::size_t i) const
+  {
+    return state.view().angularVelocity(i);
+  }
+
+  double RigidBodySimulator::kineticEnergy(std::size_t i) const
+  {
+    Vector3 w = angularVelocity(i);
+    return 0.5 * dot(w, inertia(i) * w);
+  }
+
+  Vector3 RigidBodySimulator::bodyAngularMomentum(std::size_t i) const
+  {
+    return inertia(i) * angularVelocity(i);
+  }
+
+  Vector3 RigidBodySimulator::angularMomentum(std::size_t i) const
+  {
+    return rotate(attitude(i), bodyAngularMomentum(i));
+  }
+
+  void RigidBodySimulator::setTorque(TorqueFunction torque_)
+  {
+    torque = std::move(torque_);
+  }
+
+  void RigidBodySimulator::setBodyTorque(BodyTorqueFunction torque_)
+  {
+    if (!torque_)
+      {
+        torque = nullptr;
+        return;
+      }
+    torque = [fn = std::move(torque_)](double t, std::size_t begin, std::size_t end,
+                                       const StateView& s, double* x, double* y, double* z)
+    {
+      for (std::size_t i = begin; i < end; ++i)
+        {
+          Vector3 tau = fn(t, i, s.attitude(i), s.angularVelocity(i));
+          x[i] = tau.x;
+          y[i] = tau.y;
+          z[i] = tau.z;
+        }
+    };
+  }
+
+  void RigidBodySimulator::step(double dt)
+  {
+    run(dt, 1);
+  }
+
+  void RigidBodySimulator::run(double dt, std::size_t steps)
+  {
+    if (count == 0 || steps == 0)
+      return;
+
+    // Contiguous whole blocks per thread
+    std::size_t blocks = (count + blockSize - 1) / blockSize;
+    std::size_t workers = std::min<std::size_t>(threads, blocks);
+    std::size_t perWorker = (blocks + workers - 1) / workers * blockSize;
+
+    std::vector<std::exception_ptr> errors(workers);
+    auto work = [&](std::size_t w)
+    {
+      try
+        {
+          std::size_t begin = w * perWorker;
+          advance(begin, std::min(count, begin + perWorker), dt, steps);
+        }
+      catch (...)
+        {
+          errors[w] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (std::size_t w = 1; w < workers; ++w)
+      pool.emplace_back(work, w);
+    work(0);
+    for (std::thread& t : pool)
+      t.join();
+
+    for (std::exception_ptr& e : errors)
+      {
+        if (e)
+          std::rethrow_exception(e);
+      }
+
+    simTime += double(steps) * dt;
+  }
+
+  void RigidBodySimulator::advance(std::size_t begin, std::size_t end, double dt, std::size_t steps)
+  {
+    for (std::size_t b = begin; b < end; b += blockSize)
+      {
+        std::size_t e = std::min(end, b + blockSize);
+        for (std::size_t k = 0; k < steps; ++k)
+          {
+            double t = simTime + double(k) * dt;
+            if (method == Integrator::RK4)
+              stepRK4(b, e, t, dt);
+            else
+              stepSymplectic(b, e, t, dt);
+          }
+      }
+  }
+
+  void RigidBodySimulator::evaluateTorque(double t, std::size_t begin, std::size_t end, const StateView& s)
+  {
+    torque(t, begin, end, s, tx, ty, tz);
+  }
+
+  void RigidBodySimulator::stepRK4(std::size_t begin, std::size_t end, double t, double dt)
+  {
+#define AML_RK4_ARGS                                                    \
+    begin, end, dt,                                                     \
+      state.q0, state.q1, state.q2, state.q3, \
+      state.wx, state.wy, state.wz,                \
+      stage.q0, stage.q1, stage.q2, stage.q3, \
+      stage.wx, stage.wy, stage.wz,                \
+      rate.q0, rate.q1, rate.q2, rate.q3,   \
+      rate.wx, rate.wy, rate.wz,                   \
+      ix, iy, iz,                                  \
+      invIx, invIy, invIz,                         \
+      tx, ty, tz
+
+    if (torque)
+      {
+        evaluateTorque(t, begin, end, state.view());
+        rk4Stage<0, true>(AML_RK4_ARGS);
+        evaluateTorque(t + 0.5 * dt, begin, end, stage.view());
+        rk4Stage<1, true>(AML_RK4_ARGS);
+        evaluateTorque(t + 0.5 * dt, begin, end, stage.view());
+        rk4Stage<2, true>(AML_RK4_ARGS);
+        evaluateTorque(t + dt, begin, end, stage.view());
+        rk4Stage<3, true>(AML_RK4_ARGS);
+      }
+    else
+      {
+        rk4Stage<0, false>(AML_RK4_ARGS);
+        rk4Stage<1, false>(AML_RK4_ARGS);
+        rk4Stage<2, false>(AML_RK4_ARGS);
+        rk4Stage<3, false>(AML_RK4_ARGS);
+      }
+
+#undef AML_RK4_ARGS
+  }
+
+  void RigidBodySimulator::stepSymplectic(std::size_t begin, std::size_t end, double t, double dt)
+  {
+    double* q0 = state.q0;
+    double* q1 = state.q1;
+    double* q2 = state.q2;
+    double* q3 = state.q3;
+    double* wx = state.wx;
+    double* wy = state.wy;
+    double* wz = state.wz;
+
+    if (torque)
+      {
+        evaluateTorque(t, begin, end, state.view());
+        symplecticDrift<true>(begin, end, dt, q0, q1, q2, q3, wx, wy, wz,
+                              ix, iy, iz, invIx, invIy, invIz,
+                              tx, ty, tz);
+        evaluateTorque(t + dt, begin, end, state.view());
+        symplecticKick(begin, end, dt, wx, wy, wz, invIx, invIy, invIz,
+                       tx, ty, tz);
+      }
+    else
+      {
+        symplecticDrift<false>(begin, end, dt, q0, q1, q2, q3, wx, wy, wz,
+                               ix, iy, iz, invIx, invIy, invIz,
+                               tx, ty, tz);
+      }
+  }
+
+} // namespace AML
@@ -0,0 +1,215 @@
+#ifndef AML_RIGIDBODYSIM_H
+#define AML_RIGIDBODYSIM_H
+
+#include "AMLVector3.h"
+#include "AMLQuaternion.h"
+#include "AMLDiagMatrix33.h"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace AML
+{
+  // ============================================================
+  // RigidBodySimulator
+  //
+  // Fixed-step integration of the rotational dynamics of many
+  // independent rigid bodies:
+  //
+  //   I * dw/dt = tau - w x (I * w)      (Euler's equations)
+  //   dq/dt     = 0.5 * q * (0, w)       (attitude kinematics)
+  //
+  // - w: angular velocity in the body frame (rad/s)
+  // - q: attitude, rotates body-frame vectors into the inertial
+  //   frame (same convention as quat2dcm / rotate)
+  // - I: principal moments of inertia; the body frame is the
+  //   principal-axis frame (use congruence() to move a full
+  //   SymMatrix33 tensor into it)
+  // - tau: external torque in the body frame
+  //
+  // State is stored as structure of arrays. Bodies are split into
+  // contiguous ranges, one per worker thread, and each range is
+  // advanced in cache-sized blocks, so bodies never interact.
+  //
+  // Integrators:
+  // - RK4: classic 4th order Runge-Kutta on (q, w), q renormalized
+  //   after each step.
+  // - Symplectic: 2nd order kick-drift-kick splitting. The drift
+  //   is the exact flow of each principal-axis term of the free
+  //   rigid-body Hamiltonian (rotations about x, y, z composed
+  //   symmetrically), so the body angular momentum magnitude is
+  //   preserved to rounding and the energy error stays bounded
+  //   over long runs instead of drifting.
+  // ============================================================
+  class RigidBodySimulator
+  {
+  public:
+    enum class Integrator
+    {
+      RK4,
+      Symplectic
+    };
+
+    // ------------------------------------------------------------
+    // Torque callbacks
+    //
+    // StateView gives read access to the state the torque is
+    // evaluated at (an intermediate stage state for RK4), indexed
+    // by body number.
+    //
+    // TorqueFunction is called for a range [begin, end) of bodies
+    // and writes the body-frame torque of body i to
+    // tx[i], ty[i], tz[i]. It is called concurrently from the
+    // worker threads on disjoint ranges, so it must be thread-safe.
+    //
+    // BodyTorqueFunction is the per-body convenience form.
+    // ------------------------------------------------------------
+    struct StateView
+    {
+      const double* q0;
+      const double* q1;
+      const double* q2;
+      const double* q3;
+      const double* wx;
+      const double* wy;
+      const double* wz;
+
+      Quaternion attitude(std::size_t i) const;
+      Vector3 angularVelocity(std::size_t i) const;
+    };
+
+    using TorqueFunction = std::function<void(double t, std::size_t begin, std::size_t end,
+                                              const StateView& state,
+                                              double* tx, double* ty, double* tz)>;
+
+    using BodyTorqueFunction = std::function<Vector3(double t, std::size_t i,
+                                                     const Quaternion& q, const Vector3& w)>;
+
+    // ------------------------------------------------------------
+    // Constructor
+    //
+    // - count: number of bodies (unit inertia, identity attitude,
+    //   at rest)
+    // - threads: worker threads, 0 = std::thread::hardware_concurrency
+    // ------------------------------------------------------------
+    explicit RigidBodySimulator(std::size_t count,
+                                Integrator integrator = Integrator::RK4,
+                                unsigned threads = 0);
+
+    // The arrays point into shared storage: movable, not copyable.
+    // A moved-from simulator is left empty (no bodies).
+    RigidBodySimulator(const RigidBodySimulator&) = delete;
+    RigidBodySimulator& operator=(const RigidBodySimulator&) = delete;
+    RigidBodySimulator(RigidBodySimulator&& other) noexcept;
+    RigidBodySimulator& operator=(RigidBodySimulator&& other) noexcept;
+
+    std::size_t size() const;
+    unsigned threadCount() const;
+    Integrator integrator() const;
+    void setIntegrator(Integrator integrator_);
+
+    // Simulation time, advanced by step() / run()
+    double time() const;
+    void setTime(double t);
+
+    // ------------------------------------------------------------
+    // Per-body state
+    //
+    // setInertia throws std::invalid_argument unless every
+    // principal moment is positive.
+    // ------------------------------------------------------------
+    void setBody(std::size_t i, const DiagMatrix33& inertia, const Quaternion& q, const Vector3& w);
+    void setInertia(std::size_t i, const DiagMatrix33& inertia);
+    void setAttitude(std::size_t i, const Quaternion& q);
+    void setAngularVelocity(std::size_t i, const Vector3& w);
+
+    DiagMatrix33 inertia(std::size_t i) const;
+    Quaternion attitude(std::size_t i) const;
+    Vector3 angularVelocity(std::size_t i) const;
+
+    // Rotational kinetic energy 0.5 * w . (I * w)
+    double kineticEnergy(std::size_t i) const;
+
+    // Angular momentum I * w, in the body or inertial frame
+    Vector3 bodyAngularMomentum(std::size_t i) const;
+    Vector3 angularMomentum(std::size_t i) const;
+
+    // ------------------------------------------------------------
+    // Torque
+    //
+    // Without a torque function the bodies are torque-free.
+    // Passing an empty function removes the torque.
+    // ------------------------------------------------------------
+    void setTorque(TorqueFunction torque_);
+    void setBodyTorque(BodyTorqueFunction torque_);
+
+    // ------------------------------------------------------------
+    // Integration
+    //
+    // run() advances every body by steps * dt on the worker
+    // threads. Exceptions thrown by the torque function are
+    // rethrown here (the state is then unspecified).
+    //
+    // Each call starts the worker threads and joins them before
+    // returning, and each block of bodies stays in cache for all
+    // steps of one call. Advance many steps with one run(dt, steps):
+    // step() in a loop pays the thread start-up every step.
+    // ------------------------------------------------------------
+    void step(double dt);
+    void run(double dt, std::size_t steps);
+
+  private:
+    // One array per state component
+    struct StateArrays
+    {
+      double* q0;
+      double* q1;
+      double* q2;
+      double* q3;
+      double* wx;
+      double* wy;
+      double* wz;
+
+      StateView view() const;
+    };
+
+    void bindArrays();
+    void advance(std::size_t begin, std::size_t end, double dt, std::size_t steps);
+    void stepRK4(std::size_t begin, std::size_t end, double t, double dt);
+    void stepSymplectic(std::size_t begin, std::size_t end, double t, double dt);
+    void evaluateTorque(double t, std::size_t begin, std::size_t end, const StateView& state);
+
+    std::size_t count;
+    unsigned threads;
+    Integrator method;
+    double simTime;
+    TorqueFunction torque;
+
+    // Every per-body array lives in one allocation, staggered by a
+    // cache line so the many streams of a kernel do not share the
+    // same 4 KiB page offset (separate large allocations do, and
+    // the resulting store/load aliasing costs ~3x in the kernels)
+    std::vector<double> storage;
+
+    // Principal moments and their reciprocals
+    double* ix;
+    double* iy;
+    double* iz;
+    double* invIx;
+    double* invIy;
+    double* invIz;
+
+    StateArrays state;
+
+    // Scratch: RK4 stage state and rate accumulator, torque output
+    StateArrays stage;
+    StateArrays rate;
+    double* tx;
+    double* ty;
+    double* tz;
+  };
+
+} // namespace AML
+
+#endif // AML_RIGIDBODYSIM_H
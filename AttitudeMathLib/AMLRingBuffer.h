@@ -0,0 +1,217 @@
+#ifndef AML_RINGBUFFER_H
+#define AML_RINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace AML
+{
+  // Size used to keep the producer and consumer indices on separate
+  // cache lines so the two threads do not invalidate each other.
+  inline constexpr std::size_t cacheLineSize = 64;
+
+  // ============================================================
+  // RingBuffer
+  //
+  // Bounded lock-free single-producer / single-consumer queue.
+  //
+  // Intended use:
+  // - Handing fixed-size records from one pipeline stage thread
+  //   to the next without locks
+  // - Batch handoff: pushBatch / popBatch publish many elements
+  //   with a single atomic store
+  //
+  // Exactly one thread may push and exactly one thread may pop.
+  // Capacity is rounded up to the next power of two and the
+  // storage is allocated once in the constructor.
+  // ============================================================
+  template <typename T>
+  class RingBuffer
+  {
+  public:
+
+    // ------------------------------------------------------------
+    // Constructor
+    // Allocates room for at least "capacity" elements.
+    // ------------------------------------------------------------
+    explicit RingBuffer(std::size_t capacity);
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    // ------------------------------------------------------------
+    // Producer side
+    //
+    // tryPush returns false when the queue is full.
+    // pushBatch copies as many of "count" items as fit and returns
+    // the number copied (0 when full).
+    // close marks the end of the stream; no push may follow it.
+    // ------------------------------------------------------------
+    bool tryPush(const T& item);
+    std::size_t pushBatch(const T* items, std::size_t count);
+    void close();
+
+    // ------------------------------------------------------------
+    // Consumer side
+    //
+    // tryPop returns false when the queue is empty.
+    // popBatch moves up to "maxCount" items into "items" and
+    // returns the number moved (0 when empty).
+    // ------------------------------------------------------------
+    bool tryPop(T& item);
+    std::size_t popBatch(T* items, std::size_t maxCount);
+
+    // True once the producer has called close(). Items pushed
+    // before close() are still available to popBatch.
+    bool isClosed() const;
+
+    // Empties the queue and clears the closed flag so it can carry
+    // a new stream. Neither thread may be using the queue.
+    void reset();
+
+    // ------------------------------------------------------------
+    // Queries
+    //
+    // size() is a snapshot and may be stale by the time it returns
+    // when called while the other thread is active.
+    // ------------------------------------------------------------
+    std::size_t capacity() const;
+    std::size_t size() const;
+    bool empty() const;
+
+  private:
+    std::vector<T> buffer;
+    std::size_t mask;
+
+    // Consumer-owned line: read position and its view of the writer
+    alignas(cacheLineSize) std::atomic<std::size_t> readIndex;
+    std::size_t cachedWrite;
+
+    // Producer-owned line: write position and its view of the reader
+    alignas(cacheLineSize) std::atomic<std::size_t> writeIndex;
+    std::size_t cachedRead;
+
+    alignas(cacheLineSize) std::atomic<bool> closed;
+
+  }; // class RingBuffer
+
+  // ============================================================
+  // Implementation
+  //
+  // Indices increase monotonically and are reduced with "mask"
+  // on access, so full and empty are distinguished without
+  // sacrificing a slot.
+  // ============================================================
+
+  template <typename T>
+  RingBuffer<T>::RingBuffer(std::size_t capacity) :
+    mask(0), readIndex(0), cachedWrite(0),
+    writeIndex(0), cachedRead(0), closed(false)
+  {
+    std::size_t size = 1;
+    while (size < capacity)
+      {
+        size <<= 1;
+      }
+    buffer.resize(size);
+    mask = size - 1;
+  }
+
+  template <typename T>
+  bool RingBuffer<T>::tryPush(const T& item)
+  {
+    return pushBatch(&item, 1) == 1;
+  }
+
+  template <typename T>
+  std::size_t RingBuffer<T>::pushBatch(const T* items, std::size_t count)
+  {
+    const std::size_t write = writeIndex.load(std::memory_order_relaxed);
+    std::size_t space = buffer.size() - (write - cachedRead);
+    if (space < count)
+      {
+        cachedRead = readIndex.load(std::memory_order_acquire);
+        space = buffer.size() - (write - cachedRead);
+      }
+
+    const std::size_t n = (count < space) ? count : space;
+    for (std::size_t i = 0; i < n; ++i)
+      {
+        buffer[(write + i) & mask] = items[i];
+      }
+    writeIndex.store(write + n, std::memory_order_release);
+    return n;
+  }
+
+  template <typename T>
+  void RingBuffer<T>::close()
+  {
+    closed.store(true, std::memory_order_release);
+  }
+
+  template <typename T>
+  bool RingBuffer<T>::tryPop(T& item)
+  {
+    return popBatch(&item, 1) == 1;
+  }
+
+  template <typename T>
+  std::size_t RingBuffer<T>::popBatch(T* items, std::size_t maxCount)
+  {
+    const std::size_t read = readIndex.load(std::memory_order_relaxed);
+    std::size_t available = cachedWrite - read;
+    if (available < maxCount)
+      {
+        cachedWrite = writeIndex.load(std::memory_order_acquire);
+        available = cachedWrite - read;
+      }
+
+    const std::size_t n = (maxCount < available) ? maxCount : available;
+    for (std::size_t i = 0; i < n; ++i)
+      {
+        items[i] = buffer[(read + i) & mask];
+      }
+    readIndex.store(read + n, std::memory_order_release);
+    return n;
+  }
+
+  template <typename T>
+  bool RingBuffer<T>::isClosed() const
+  {
+    return closed.load(std::memory_order_acquire);
+  }
+
+  template <typename T>
+  void RingBuffer<T>::reset()
+  {
+    readIndex.store(0, std::memory_order_relaxed);
+    writeIndex.store(0, std::memory_order_relaxed);
+    cachedWrite = 0;
+    cachedRead = 0;
+    closed.store(false, std::memory_order_release);
+  }
+
+  template <typename T>
+  std::size_t RingBuffer<T>::capacity() const
+  {
+    return buffer.size();
+  }
+
+  template <typename T>
+  std::size_t RingBuffer<T>::size() const
+  {
+    const std::size_t read = readIndex.load(std::memory_order_acquire);
+    const std::size_t write = writeIndex.load(std::memory_order_acquire);
+    return write - read;
+  }
+
+  template <typename T>
+  bool RingBuffer<T>::empty() const
+  {
+    return size() == 0;
+  }
+
+} // namespace AML
+
+#endif // AML_RINGBUFFER_H
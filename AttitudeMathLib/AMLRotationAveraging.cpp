@@ -0,0 +1,521 @@
+#include "AMLRotationAveraging.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace AML
+{
+
+  namespace
+  {
+    // Samples summed plainly before folding into the compensated
+    // totals; short enough that the block sum loses nothing useful
+    constexpr std::size_t blockSize = 256;
+
+    void checkWeight(double w)
+    {
+      if (!(w >= 0.0) || !std::isfinite(w))
+        throw std::invalid_argument("rotation averaging: weights must be finite and non-negative");
+    }
+
+    void checkWeights(const double* weights, std::size_t n)
+    {
+      if (weights == nullptr)
+        return;
+      for (std::size_t i = 0; i < n; ++i)
+        checkWeight(weights[i]);
+    }
+
+    // Neumaier compensated addition of x to (sum, carry)
+    inline void addCompensated(double& sum, double& carry, double x)
+    {
+      double t = sum + x;
+      if (std::fabs(sum) >= std::fabs(x))
+        carry += (sum - t) + x;
+      else
+        carry += (x - t) + sum;
+      sum = t;
+    }
+
+    // Weighted rotation matrix of a unit quaternion, row-major
+    inline void quaternionMatrixTerms(const Quaternion& q, double w, double* m)
+    {
+      double a = q.q0, b = q.q1, c = q.q2, d = q.q3;
+      m[0] += w * (a * a + b * b - c * c - d * d);
+      m[1] += w * 2.0 * (b * c - a * d);
+      m[2] += w * 2.0 * (b * d + a * c);
+      m[3] += w * 2.0 * (b * c + a * d);
+      m[4] += w * (a * a - b * b + c * c - d * d);
+      m[5] += w * 2.0 * (c * d - a * b);
+      m[6] += w * 2.0 * (b * d - a * c);
+      m[7] += w * 2.0 * (c * d + a * b);
+      m[8] += w * (a * a - b * b - c * c + d * d);
+      m[9] += w;
+    }
+
+    inline void matrixTerms(const Matrix33& R, double w, double* m)
+    {
+      const double* r = &R.data[0][0];
+      for (int j = 0; j < 9; ++j)
+        m[j] += w * r[j];
+      m[9] += w;
+    }
+
+    // Weighted q * q^T upper triangle of a unit quaternion
+    inline void quaternionOuterTerms(const Quaternion& q, double w, double* a)
+    {
+      double q0 = w * q.q0, q1 = w * q.q1, q2 = w * q.q2, q3 = w * q.q3;
+      a[0] += q0 * q.q0;
+      a[1] += q0 * q.q1;
+      a[2] += q0 * q.q2;
+      a[3] += q0 * q.q3;
+      a[4] += q1 * q.q1;
+      a[5] += q1 * q.q2;
+      a[6] += q1 * q.q3;
+      a[7] += q2 * q.q2;
+      a[8] += q2 * q.q3;
+      a[9] += q3 * q.q3;
+      a[10] += w;
+    }
+
+    // The same outer product from the rotation matrix: q * q^T is
+    // linear in R, so no square root or branch is needed
+    inline void matrixOuterTerms(const Matrix33& R, double w, double* a)
+    {
+      double t = R.m11 + R.m22 + R.m33;
+      double h = 0.25 * w;
+      a[0] += h * (1.0 + t);
+      a[1] += h * (R.m32 - R.m23);
+      a[2] += h * (R.m13 - R.m31);
+      a[3] += h * (R.m21 - R.m12);
+      a[4] += h * (1.0 - t + 2.0 * R.m11);
+      a[5] += h * (R.m12 + R.m21);
+      a[6] += h * (R.m13 + R.m31);
+      a[7] += h * (1.0 - t + 2.0 * R.m22);
+      a[8] += h * (R.m23 + R.m32);
+      a[9] += h * (1.0 - t + 2.0 * R.m33);
+      a[10] += w;
+    }
+
+    // Sums Terms(x(i), w_i, block) over blocks of the batch and
+    // hands each block total to fold (Terms is a template argument
+    // so it is inlined into the loop). x reads sample i from an
+    // array or a strided view.
+    template <std::size_t N, auto Terms, typename Input, typename Fold>
+    void sumBlocks(Input x, std::size_t n, const double* weights, Fold fold)
+    {
+      for (std::size_t begin = 0; begin < n; begin += blockSize)
+        {
+          std::size_t end = std::min(n, begin + blockSize);
+          double block[N] = {};
+          if (weights != nullptr)
+            for (std::size_t i = begin; i < end; ++i)
+              Terms(x(i), weights[i], block);
+          else
+            for (std::size_t i = begin; i < end; ++i)
+              Terms(x(i), 1.0, block);
+          fold(block, end - begin);
+        }
+    }
+
+    // Sample readers for sumBlocks
+    template <typename T>
+    auto reader(const T* x)
+    {
+      return [x](std::size_t i) -> const T& { return x[i]; };
+    }
+
+    auto reader(ConstMatrix33View R)
+    {
+      return [R](std::size_t i) { return R.get(i); };
+    }
+
+    // ------------------------------------------------------------
+    // Eigenvector of the largest eigenvalue of a symmetric 4x4
+    // matrix (upper triangle a00, a01, a02, a03, a11, a12, a13,
+    // a22, a23, a33) by cyclic Jacobi rotations. Jacobi is
+    // accurate even for nearly repeated eigenvalues, which occur
+    // whenever the samples are widely spread.
+    // ------------------------------------------------------------
+    Quaternion dominantEigenvector(const double* upper)
+    {
+      double a[4][4];
+      for (int i = 0, k = 0; i < 4; ++i)
+        for (int j = i; j < 4; ++j, ++k)
+          a[i][j] = a[j][i] = upper[k];
+      double v[4][4] = {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}};
+
+      for (int sweep = 0; sweep < 50; ++sweep)
+        {
+          double off = 0.0, norm2 = 0.0;
+          for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+              {
+                norm2 += a[i][j] * a[i][j];
+                if (i < j)
+                  off += a[i][j] * a[i][j];
+              }
+          if (off <= 1e-32 * norm2)
+            break;
+
+          for (int p = 0; p < 3; ++p)
+            for (int q = p + 1; q < 4; ++q)
+              {
+                if (a[p][q] == 0.0)
+                  continue;
+                double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                double t = std::copysign(1.0, theta) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                double c = 1.0 / std::sqrt(t * t + 1.0);
+                double s = t * c;
+                for (int r = 0; r < 4; ++r)
+                  {
+                    double arp = a[r][p], arq = a[r][q];
+                    a[r][p] = c * arp - s * arq;
+                    a[r][q] = s * arp + c * arq;
+                  }
+                for (int r = 0; r < 4; ++r)
+                  {
+                    double apr = a[p][r], aqr = a[q][r];
+                    a[p][r] = c * apr - s * aqr;
+                    a[q][r] = s * apr + c * aqr;
+                  }
+                for (int r = 0; r < 4; ++r)
+                  {
+                    double vrp = v[r][p], vrq = v[r][q];
+                    v[r][p] = c * vrp - s * vrq;
+                    v[r][q] = s * vrp + c * vrq;
+                  }
+              }
+        }
+
+      int k = 0;
+      for (int i = 1; i < 4; ++i)
+        {
+          if (a[i][i] > a[k][k])
+            k = i;
+        }
+      Quaternion q(v[0][k], v[1][k], v[2][k], v[3][k]);
+      normalize(q);
+      if (q.q0 < 0.0)
+        q = -q;
+      return q;
+    }
+
+    Quaternion nanQuaternion()
+    {
+      return Quaternion(NAN, NAN, NAN, NAN);
+    }
+  }
+
+  // ============================================================
+  // ChordalMeanAccumulator
+  // ============================================================
+  ChordalMeanAccumulator::ChordalMeanAccumulator()
+  {
+    reset();
+  }
+
+  void ChordalMeanAccumulator::fold(const double* block, double sign, std::size_t samples_)
+  {
+    if (sign < 0.0 && samples_ > samples)
+      throw std::logic_error("ChordalMeanAccumulator: remove() of more samples than were added");
+    samples = sign < 0.0 ? samples - samples_ : samples + samples_;
+    if (samples == 0)
+      {
+        reset();
+        return;
+      }
+    for (int j = 0; j < 10; ++j)
+      addCompensated(total[j], carry[j], sign * block[j]);
+  }
+
+  void ChordalMeanAccumulator::add(const Matrix33& R, double weight)
+  {
+    checkWeight(weight);
+    double block[10] = {};
+    matrixTerms(R, weight, block);
+    fold(block, 1.0, 1);
+  }
+
+  void ChordalMeanAccumulator::add(const Quaternion& q, double weight)
+  {
+    checkWeight(weight);
+    double block[10] = {};
+    quaternionMatrixTerms(q, weight, block);
+    fold(block, 1.0, 1);
+  }
+
+  void ChordalMeanAccumulator::remove(const Matrix33& R, double weight)
+  {
+    checkWeight(weight);
+    double block[10] = {};
+    matrixTerms(R, weight, block);
+    fold(block, -1.0, 1);
+  }
+
+  void ChordalMeanAccumulator::remove(const Quaternion& q, double weight)
+  {
+    checkWeight(weight);
+    double block[10] = {};
+    quaternionMatrixTerms(q, weight, block);
+    fold(block, -1.0, 1);
+  }
+
+  void ChordalMeanAccumulator::add(const Matrix33* R, std::size_t n, const double* weights)
+  {
+    checkWeights(weights, n);
+    sumBlocks<10, matrixTerms>(reader(R), n, weights, [this](const double* block, std::size_t m) { fold(block, 1.0, m); });
+  }
+
+  void ChordalMeanAccumulator::add(const Quaternion* q, std::size_t n, const double* weights)
+  {
+    checkWeights(weights, n);
+    sumBlocks<10, quaternionMatrixTerms>(reader(q), n, weights, [this](const double* block, std::size_t m) { fold(block, 1.0, m); });
+  }
+
+  void ChordalMeanAccumulator::remove(const Matrix33* R, std::size_t n, const double* weights)
+  {
+    checkWeights(weights, n);
+    if (n > samples)
+      throw std::logic_error("ChordalMeanAccumulator: remove() of more samples than were added");
+    sumBlocks<10, matrixTerms>(reader(R), n, weights, [this](const double* block, std::size_t m) { fold(block, -1.0, m); });
+  }
+
+  void ChordalMeanAccumulator::remove(const Quaternion* q, std::size_t n, const double* weights)
+  {
+    checkWeights(weights, n);
+    if (n > samples)
+      throw std::logic_error("ChordalMeanAccumulator: remove() of more samples than were added");
+    sumBlocks<10, quaternionMatrixTerms>(reader(q), n, weights, [this](const double* block, std::size_t m) { fold(block, -1.0, m); });
+  }
+
+  void ChordalMeanAccumulator::add(ConstMatrix33View R, const double* weights)
+  {
+    checkWeights(weights, R.size());
+    sumBlocks<10, matrixTerms>(reader(R), R.size(), weights, [this](const double* block, std::size_t m) { fold(block, 1.0, m); });
+  }
+
+  void ChordalMeanAccumulator::remove(ConstMatrix33View R, const double* weights)
+  {
+    checkWeights(weights, R.size());
+    if (R.size() > samples)
+      throw std::logic_error("ChordalMeanAccumulator: remove() of more samples than were added");
+    sumBlocks<10, matrixTerms>(reader(R), R.size(), weights, [this](const double* block, std::size_t m) { fold(block, -1.0, m); });
+  }
+
+  void ChordalMeanAccumulator::merge(const ChordalMeanAccumulator& other)
+  {
+    for (int j = 0; j < 10; ++j)
+      {
+        addCompensated(total[j], carry[j], other.total[j]);
+        carry[j] += other.carry[j];
+      }
+    samples += other.samples;
+  }
+
+  ChordalMeanAccumulator& ChordalMeanAccumulator::operator+=(const ChordalMeanAccumulator& other)
+  {
+    merge(other);
+    return *this;
+  }
+
+  void ChordalMeanAccumulator::reset()
+  {
+    for (int j = 0; j < 10; ++j)
+      total[j] = carry[j] = 0.0;
+    samples = 0;
+  }
+
+  std::size_t ChordalMeanAccumulator::count() const
+  {
+    return samples;
+  }
+
+  double ChordalMeanAccumulator::weight() const
+  {
+    return total[9] + carry[9];
+  }
+
+  Matrix33 ChordalMeanAccumulator::sum() const
+  {
+    double m[9];
+    for (int j = 0; j < 9; ++j)
+      m[j] = total[j] + carry[j];
+    return Matrix33(m);
+  }
+
+  Quaternion ChordalMeanAccumulator::mean() const
+  {
+    if (!(weight() > 0.0))
+      return nanQuaternion();
+
+    // The rotation maximizing trace(R^T * M) is the dominant
+    // eigenvector of Davenport's matrix
+    //   K = [ tr(M)  z^T              ]
+    //       [ z      M + M^T - tr(M) I ]
+    // with z = (m32 - m23, m13 - m31, m21 - m12)
+    Matrix33 m = sum();
+    double t = m.m11 + m.m22 + m.m33;
+    double k[10] = {t, m.m32 - m.m23, m.m13 - m.m31, m.m21 - m.m12,
+                    2.0 * m.m11 - t, m.m12 + m.m21, m.m13 + m.m31,
+                    2.0 * m.m22 - t, m.m23 + m.m32,
+                    2.0 * m.m33 - t};
+    return dominantEigenvector(k);
+  }
+
+  Matrix33 ChordalMeanAccumulator::meanMatrix() const
+  {
+    return quat2dcm(mean());
+  }
+
+  // ============================================================
+  // QuaternionMeanAccumulator
+  // ============================================================
+  QuaternionMeanAccumulator::QuaternionMeanAccumulator()
+  {
+    reset();
+  }
+
+  void QuaternionMeanAccumulator::fold(const double* block, double sign, std::size_t samples_)
+  {
+    if (sign < 0.0 && samples_ > samples)
+      throw std::logic_error("QuaternionMeanAccumulator: remove() of more samples than were added");
+    samples = sign < 0.0 ? samples - samples_ : samples + samples_;
+    if (samples == 0)
+      {
+        reset();
+        return;
+      }
+    for (int j = 0; j < 11; ++j)
+      addCompensated(total[j], carry[j], sign * block[j]);
+  }
+
+  void QuaternionMeanAccumulator::add(const Quaternion& q, double weight)
+  {
+    checkWeight(weight);
+    double block[11] = {};
+    quaternionOuterTerms(q, weight, block);
+    fold(block, 1.0, 1);
+  }
+
+  void QuaternionMeanAccumulator::add(const Matrix33& R, double weight)
+  {
+    checkWeight(weight);
+    double block[11] = {};
+    matrixOuterTerms(R, weight, block);
+    fold(block, 1.0, 1);
+  }
+
+  void QuaternionMeanAccumulator::remove(const Quaternion& q, double weight)
+  {
+    checkWeight(weight);
+    double block[11] = {};
+    quaternionOuterTerms(q, weight, block);
+    fold(block, -1.0, 1);
+  }
+
+  void QuaternionMeanAccumulator::remove(const Matrix33& R, double weight)
+  {
+    checkWeight(weight);
+    double block[11] = {};
+    matrixOuterTerms(R, weight, block);
+    fold(block, -1.0, 1);
+  }
+
+  void QuaternionMeanAccumulator::add(const Quaternion* q, std::size_t n, const double* weights)
+  {
+    checkWeights(weights, n);
+    sumBlocks<11, quaternionOuterTerms>(reader(q), n, weights, [this](const double* block, std::size_t m) { fold(block, 1.0, m); });
+  }
+
+  void QuaternionMeanAccumulator::add(const Matrix33* R, std::size_t n, const double* weights)
+  {
+    checkWeights(weights, n);
+    sumBlocks<11, matrixOuterTerms>(reader(R), n, weights, [this](const double* block, std::size_t m) { fold(block, 1.0, m); });
+  }
+
+  void QuaternionMeanAccumulator::remove(const Quaternion* q, std::size_t n, const double* weights)
+  {
+    checkWeights(weights, n);
+    if (n > samples)
+      throw std::logic_error("QuaternionMeanAccumulator: remove() of more samples than were added");
+    sumBlocks<11, quaternionOuterTerms>(reader(q), n, weights, [this](const double* block, std::size_t m) { fold(block, -1.0, m); });
+  }
+
+  void QuaternionMeanAccumulator::remove(const Matrix33* R, std::size_t n, const double* weights)
+  {
+    checkWeights(weights, n);
+    if (n > samples)
+      throw std::logic_error("QuaternionMeanAccumulator: remove() of more samples than were added");
+    sumBlocks<11, matrixOuterTerms>(reader(R), n, weights, [this](const double* block, std::size_t m) { fold(block, -1.0, m); });
+  }
+
+  void QuaternionMeanAccumulator::add(ConstMatrix33View R, const double* weights)
+  {
+    checkWeights(weights, R.size());
+    sumBlocks<11, matrixOuterTerms>(reader(R), R.size(), weights, [this](const double* block, std::size_t m) { fold(block, 1.0, m); });
+  }
+
+  void QuaternionMeanAccumulator::remove(ConstMatrix33View R, const double* weights)
+  {
+    checkWeights(weights, R.size());
+    if (R.size() > samples)
+      throw std::logic_error("QuaternionMeanAccumulator: remove() of more samples than were added");
+    sumBlocks<11, matrixOuterTerms>(reader(R), R.size(), weights, [this](const double* block, std::size_t m) { fold(block, -1.0, m); });
+  }
+
+  void QuaternionMeanAccumulator::merge(const QuaternionMeanAccumulator& other)
+  {
+    for (int j = 0; j < 11; ++j)
+      {
+        addCompensated(total[j], carry[j], other.total[j]);
+        carry[j] += other.carry[j];
+      }
+    samples += other.samples;
+  }
+
+  QuaternionMeanAccumulator& QuaternionMeanAccumulator::operator+=(const QuaternionMeanAccumulator& other)
+  {
+    merge(other);
+    return *this;
+  }
+
+  void QuaternionMeanAccumulator::reset()
+  {
+    for (int j = 0; j < 11; ++j)
+      total[j] = carry[j] = 0.0;
+    samples = 0;
+  }
+
+  std::size_t QuaternionMeanAccumulator::count() const
+  {
+    return samples;
+  }
+
+  double QuaternionMeanAccumulator::weight() const
+  {
+    return total[10] + carry[10];
+  }
+
+  MatrixN<4, 4> QuaternionMeanAccumulator::secondMoment() const
+  {
+    MatrixN<4, 4> a;
+    for (int i = 0, k = 0; i < 4; ++i)
+      for (int j = i; j < 4; ++j, ++k)
+        a(i, j) = a(j, i) = total[k] + carry[k];
+    return a;
+  }
+
+  Quaternion QuaternionMeanAccumulator::mean() const
+  {
+    if (!(weight() > 0.0))
+      return nanQuaternion();
+
+    double a[10];
+    for (int j = 0; j < 10; ++j)
+      a[j] = total[j] + carry[j];
+    return dominantEigenvector(a);
+  }
+
+} // namespace AML
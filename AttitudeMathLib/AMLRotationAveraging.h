@@ -0,0 +1,146 @@
+#ifndef AML_ROTATIONAVERAGING_H
+#define AML_ROTATIONAVERAGING_H
+
+#include "AMLMatrix33.h"
+#include "AMLQuaternion.h"
+#include "AMLMatrixN.h"
+#include "AMLStridedView.h"
+
+#include <cstddef>
+
+namespace AML
+{
+  // ============================================================
+  // Streaming rotation averaging
+  //
+  // Element-wise averages of rotation matrices are not rotations.
+  // The accumulators below keep a constant-size weighted sum and
+  // return the rotation that minimizes
+  //
+  //   sum_i w_i * |R - R_i|_F^2      (chordal L2 mean)
+  //
+  // on demand. Both classes compute that mean; they differ in the
+  // state they keep and so in which input is cheaper to add:
+  //
+  // - ChordalMeanAccumulator keeps M = sum w_i * R_i (9 values)
+  //   and projects M onto SO(3).
+  // - QuaternionMeanAccumulator keeps A = sum w_i * q_i * q_i^T
+  //   (10 values) and takes its dominant eigenvector (Markley's
+  //   quaternion average). q and -q add the same term, so input
+  //   signs do not matter.
+  //
+  // For a unit quaternion, 4 * q * q^T - I is a linear function
+  // of quat2dcm(q), which is why the two means agree.
+  //
+  // Shared behaviour:
+  // - Weights must be finite and non-negative
+  //   (std::invalid_argument). Unweighted inputs have weight 1.
+  // - remove() subtracts a sample that was added earlier (sliding
+  //   windows); it throws std::logic_error when empty.
+  // - merge() / += combine partial accumulators, e.g. one per
+  //   thread of a parallel reduction.
+  // - Sums are compensated (Neumaier), so millions of adds and
+  //   removes do not drift. Batches are summed in blocks and each
+  //   block total is folded into the compensated sums.
+  // - mean() returns a unit quaternion with q0 >= 0, or NaN when
+  //   the total weight is zero. The mean is not unique when the
+  //   samples are spread symmetrically (e.g. two attitudes pi
+  //   apart with equal weight); one of the minimizers is returned.
+  // - Quaternion inputs are expected to be unit quaternions (not
+  //   renormalized); Matrix33 inputs rotation matrices.
+  // ============================================================
+  class ChordalMeanAccumulator
+  {
+  public:
+    ChordalMeanAccumulator();
+
+    void add(const Matrix33& R, double weight = 1.0);
+    void add(const Quaternion& q, double weight = 1.0);
+    void remove(const Matrix33& R, double weight = 1.0);
+    void remove(const Quaternion& q, double weight = 1.0);
+
+    // Batches; weights (n values) may be null for unit weights
+    void add(const Matrix33* R, std::size_t n, const double* weights = nullptr);
+    void add(const Quaternion* q, std::size_t n, const double* weights = nullptr);
+    void remove(const Matrix33* R, std::size_t n, const double* weights = nullptr);
+    void remove(const Quaternion* q, std::size_t n, const double* weights = nullptr);
+
+    // Rotation matrices in an external buffer; weights (R.size()
+    // values) may be null for unit weights
+    void add(ConstMatrix33View R, const double* weights = nullptr);
+    void remove(ConstMatrix33View R, const double* weights = nullptr);
+
+    void merge(const ChordalMeanAccumulator& other);
+    ChordalMeanAccumulator& operator+=(const ChordalMeanAccumulator& other);
+
+    void reset();
+
+    // Samples currently accumulated and their total weight
+    std::size_t count() const;
+    double weight() const;
+
+    // Weighted sum M of the rotation matrices
+    Matrix33 sum() const;
+
+    // Chordal mean rotation (the closest rotation to M)
+    Quaternion mean() const;
+    Matrix33 meanMatrix() const;
+
+  private:
+    void fold(const double* block, double sign, std::size_t samples_);
+
+    // Compensated sums: M row-major, then the total weight
+    double total[10];
+    double carry[10];
+    std::size_t samples;
+  };
+
+  class QuaternionMeanAccumulator
+  {
+  public:
+    QuaternionMeanAccumulator();
+
+    void add(const Quaternion& q, double weight = 1.0);
+    void add(const Matrix33& R, double weight = 1.0);
+    void remove(const Quaternion& q, double weight = 1.0);
+    void remove(const Matrix33& R, double weight = 1.0);
+
+    // Batches; weights (n values) may be null for unit weights
+    void add(const Quaternion* q, std::size_t n, const double* weights = nullptr);
+    void add(const Matrix33* R, std::size_t n, const double* weights = nullptr);
+    void remove(const Quaternion* q, std::size_t n, const double* weights = nullptr);
+    void remove(const Matrix33* R, std::size_t n, const double* weights = nullptr);
+
+    // Rotation matrices in an external buffer; weights (R.size()
+    // values) may be null for unit weights
+    void add(ConstMatrix33View R, const double* weights = nullptr);
+    void remove(ConstMatrix33View R, const double* weights = nullptr);
+
+    void merge(const QuaternionMeanAccumulator& other);
+    QuaternionMeanAccumulator& operator+=(const QuaternionMeanAccumulator& other);
+
+    void reset();
+
+    // Samples currently accumulated and their total weight
+    std::size_t count() const;
+    double weight() const;
+
+    // Weighted second moment A = sum w_i * q_i * q_i^T
+    MatrixN<4, 4> secondMoment() const;
+
+    // Eigenvector of the largest eigenvalue of A
+    Quaternion mean() const;
+
+  private:
+    void fold(const double* block, double sign, std::size_t samples_);
+
+    // Compensated sums: upper triangle of A (a00, a01, a02, a03,
+    // a11, a12, a13, a22, a23, a33), then the total weight
+    double total[11];
+    double carry[11];
+    std::size_t samples;
+  };
+
+} // namespace AML
+
+#endif // AML_ROTATIONAVERAGING_H
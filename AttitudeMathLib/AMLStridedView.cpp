@@ -0,0 +1,206 @@
+#include "AMLStridedView.h"
+
+#include <cmath>
+
+namespace AML
+{
+
+  namespace
+  {
+    void checkSizes(std::size_t a, std::size_t b)
+    {
+      if (a != b)
+        throw std::invalid_argument("strided views: batch sizes differ");
+    }
+
+    // Elements of matrix i, row-major, read before anything is
+    // written so in-place outputs are safe
+    struct Elements
+    {
+      double m[9];
+    };
+
+    inline Elements load(const ConstMatrix33View& A, std::size_t i)
+    {
+      Elements e;
+      for (std::size_t r = 0; r < 3; ++r)
+        for (std::size_t c = 0; c < 3; ++c)
+          e.m[3 * r + c] = A(i, r, c);
+      return e;
+    }
+
+    inline void store(const Matrix33View& out, std::size_t i, const Elements& e)
+    {
+      for (std::size_t r = 0; r < 3; ++r)
+        for (std::size_t c = 0; c < 3; ++c)
+          out(i, r, c) = e.m[3 * r + c];
+    }
+
+    inline void store(const Vector3View& out, std::size_t i, double x, double y, double z)
+    {
+      out(i, 0) = x;
+      out(i, 1) = y;
+      out(i, 2) = z;
+    }
+  }
+
+  // ------------------------------------------------------------
+  // Matrix-vector
+  // ------------------------------------------------------------
+  void multiply(ConstMatrix33View A, ConstVector3View x, Vector3View out)
+  {
+    checkSizes(A.size(), x.size());
+    checkSizes(A.size(), out.size());
+    for (std::size_t i = 0; i < out.size(); ++i)
+      {
+        Elements a = load(A, i);
+        double x0 = x(i, 0), x1 = x(i, 1), x2 = x(i, 2);
+        store(out, i,
+              a.m[0] * x0 + a.m[1] * x1 + a.m[2] * x2,
+              a.m[3] * x0 + a.m[4] * x1 + a.m[5] * x2,
+              a.m[6] * x0 + a.m[7] * x1 + a.m[8] * x2);
+      }
+  }
+
+  void multiply(const Matrix33& A, ConstVector3View x, Vector3View out)
+  {
+    checkSizes(x.size(), out.size());
+    for (std::size_t i = 0; i < out.size(); ++i)
+      {
+        double x0 = x(i, 0), x1 = x(i, 1), x2 = x(i, 2);
+        store(out, i,
+              A.m11 * x0 + A.m12 * x1 + A.m13 * x2,
+              A.m21 * x0 + A.m22 * x1 + A.m23 * x2,
+              A.m31 * x0 + A.m32 * x1 + A.m33 * x2);
+      }
+  }
+
+  void transposeMultiply(ConstMatrix33View A, ConstVector3View x, Vector3View out)
+  {
+    checkSizes(A.size(), x.size());
+    checkSizes(A.size(), out.size());
+    for (std::size_t i = 0; i < out.size(); ++i)
+      {
+        Elements a = load(A, i);
+        double x0 = x(i, 0), x1 = x(i, 1), x2 = x(i, 2);
+        store(out, i,
+              a.m[0] * x0 + a.m[3] * x1 + a.m[6] * x2,
+              a.m[1] * x0 + a.m[4] * x1 + a.m[7] * x2,
+              a.m[2] * x0 + a.m[5] * x1 + a.m[8] * x2);
+      }
+  }
+
+  // ------------------------------------------------------------
+  // Matrix-matrix
+  // ------------------------------------------------------------
+  void multiply(ConstMatrix33View A, ConstMatrix33View B, Matrix33View out)
+  {
+    checkSizes(A.size(), B.size());
+    checkSizes(A.size(), out.size());
+    for (std::size_t i = 0; i < out.size(); ++i)
+      {
+        Elements a = load(A, i);
+        Elements b = load(B, i);
+        Elements p;
+        for (int r = 0; r < 3; ++r)
+          for (int c = 0; c < 3; ++c)
+            p.m[3 * r + c] = a.m[3 * r] * b.m[c] + a.m[3 * r + 1] * b.m[3 + c] + a.m[3 * r + 2] * b.m[6 + c];
+        store(out, i, p);
+      }
+  }
+
+  void transpose(ConstMatrix33View A, Matrix33View out)
+  {
+    checkSizes(A.size(), out.size());
+    for (std::size_t i = 0; i < out.size(); ++i)
+      {
+        Elements a = load(A, i);
+        Elements t;
+        for (int r = 0; r < 3; ++r)
+          for (int c = 0; c < 3; ++c)
+            t.m[3 * r + c] = a.m[3 * c + r];
+        store(out, i, t);
+      }
+  }
+
+  // ------------------------------------------------------------
+  // Vector
+  // ------------------------------------------------------------
+  void add(ConstVector3View a, ConstVector3View b, Vector3View out)
+  {
+    checkSizes(a.size(), b.size());
+    checkSizes(a.size(), out.size());
+    for (std::size_t i = 0; i < out.size(); ++i)
+      store(out, i, a(i, 0) + b(i, 0), a(i, 1) + b(i, 1), a(i, 2) + b(i, 2));
+  }
+
+  void subtract(ConstVector3View a, ConstVector3View b, Vector3View out)
+  {
+    checkSizes(a.size(), b.size());
+    checkSizes(a.size(), out.size());
+    for (std::size_t i = 0; i < out.size(); ++i)
+      store(out, i, a(i, 0) - b(i, 0), a(i, 1) - b(i, 1), a(i, 2) - b(i, 2));
+  }
+
+  void scale(ConstVector3View a, double s, Vector3View out)
+  {
+    checkSizes(a.size(), out.size());
+    for (std::size_t i = 0; i < out.size(); ++i)
+      store(out, i, a(i, 0) * s, a(i, 1) * s, a(i, 2) * s);
+  }
+
+  void cross(ConstVector3View a, ConstVector3View b, Vector3View out)
+  {
+    checkSizes(a.size(), b.size());
+    checkSizes(a.size(), out.size());
+    for (std::size_t i = 0; i < out.size(); ++i)
+      {
+        double a0 = a(i, 0), a1 = a(i, 1), a2 = a(i, 2);
+        double b0 = b(i, 0), b1 = b(i, 1), b2 = b(i, 2);
+        store(out, i, a1 * b2 - a2 * b1, a2 * b0 - a0 * b2, a0 * b1 - a1 * b0);
+      }
+  }
+
+  void dot(ConstVector3View a, ConstVector3View b, double* out)
+  {
+    checkSizes(a.size(), b.size());
+    for (std::size_t i = 0; i < a.size(); ++i)
+      out[i] = a(i, 0) * b(i, 0) + a(i, 1) * b(i, 1) + a(i, 2) * b(i, 2);
+  }
+
+  void norm(ConstVector3View a, double* out)
+  {
+    for (std::size_t i = 0; i < a.size(); ++i)
+      out[i] = std::sqrt(a(i, 0) * a(i, 0) + a(i, 1) * a(i, 1) + a(i, 2) * a(i, 2));
+  }
+
+  void normalize(ConstVector3View a, Vector3View out)
+  {
+    checkSizes(a.size(), out.size());
+    for (std::size_t i = 0; i < out.size(); ++i)
+      {
+        double x = a(i, 0), y = a(i, 1), z = a(i, 2);
+        double mag = std::sqrt(x * x + y * y + z * z);
+        double d = mag > 0.0 ? mag : 1.0;
+        store(out, i, x / d, y / d, z / d);
+      }
+  }
+
+  // ------------------------------------------------------------
+  // Layout conversion
+  // ------------------------------------------------------------
+  void copy(ConstVector3View from, Vector3View to)
+  {
+    checkSizes(from.size(), to.size());
+    for (std::size_t i = 0; i < to.size(); ++i)
+      store(to, i, from(i, 0), from(i, 1), from(i, 2));
+  }
+
+  void copy(ConstMatrix33View from, Matrix33View to)
+  {
+    checkSizes(from.size(), to.size());
+    for (std::size_t i = 0; i < to.size(); ++i)
+      store(to, i, load(from, i));
+  }
+
+} // namespace AML
@@ -0,0 +1,407 @@
+#ifndef AML_STRIDEDVIEW_H
+#define AML_STRIDEDVIEW_H
+
+#include "AMLVector3.h"
+#include "AMLMatrix33.h"
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace AML
+{
+  // ============================================================
+  // Strided views
+  //
+  // Non-owning views of Vector3 / Matrix33 batches stored in
+  // external double buffers (telemetry frames, other components'
+  // arrays), so batch math runs on the buffer itself instead of
+  // copying through the Vector3(const double[3]) /
+  // Matrix33(const double[9]) constructors and back.
+  //
+  // A view is a base pointer, a count and strides in doubles:
+  //
+  //   Vector3View:  component k of vector i at
+  //                 base[i * stride + k * componentStride]
+  //   Matrix33View: element (r, c) of matrix i at
+  //                 base[i * stride + r * rowStride + c * colStride]
+  //
+  // which covers packed arrays (stride 3 / 9), vectors or
+  // matrices embedded in larger records (stride = record size),
+  // structure-of-arrays buffers (stride 1, componentStride = n)
+  // and row- or column-major matrices (MatrixLayout).
+  //
+  // BasicVector3View<const double> (ConstVector3View) reads only;
+  // a mutable view converts to it implicitly. Views are cheap to
+  // copy and are passed by value. The caller keeps the buffer
+  // alive and correctly sized; only the std::span constructors
+  // can check the size.
+  //
+  // Besides the element-wise operations below, the batch APIs
+  // that read or write Vector3 / Matrix33 samples take views next
+  // to their owning containers: symmetricEigen / svd
+  // (AMLDecomposition33.h), the IMU filter updates
+  // (AMLImuFilters.h) and the rotation-averaging accumulators
+  // (AMLRotationAveraging.h). Matrix33Batch and ImuBatch remain
+  // the structure-of-arrays containers those kernels are tuned
+  // for; views are for data that already lives elsewhere. There
+  // is no quaternion view: QuaternionCodec, OrientationIndex and
+  // the Quaternion* batch overloads keep taking Quaternion arrays.
+  // ============================================================
+
+  enum class MatrixLayout
+  {
+    RowMajor,
+    ColumnMajor
+  };
+
+  template <typename T>
+  class BasicVector3View
+  {
+    static_assert(std::is_same_v<std::remove_const_t<T>, double>, "views are over double or const double");
+
+  public:
+
+    // Empty view
+    BasicVector3View();
+
+    // count vectors starting at data
+    BasicVector3View(T* data, std::size_t count, std::ptrdiff_t stride = 3, std::ptrdiff_t componentStride = 1);
+
+    // Packed x, y, z triples; the size must be a multiple of 3
+    explicit BasicVector3View(std::span<T> packed);
+
+    // Mutable view to read-only view
+    template <typename U>
+      requires (std::is_same_v<const U, T> && !std::is_same_v<U, T>)
+    BasicVector3View(const BasicVector3View<U>& other);
+
+    std::size_t size() const;
+    bool empty() const;
+
+    T* data() const;
+    std::ptrdiff_t stride() const;
+    std::ptrdiff_t componentStride() const;
+
+    // Component k (0..2) of vector i
+    T& operator()(std::size_t i, std::size_t k) const;
+
+    Vector3 get(std::size_t i) const;
+    void set(std::size_t i, const Vector3& v) const
+      requires (!std::is_const_v<T>);
+
+    // count vectors starting at vector begin (std::out_of_range)
+    BasicVector3View subview(std::size_t begin, std::size_t count) const;
+
+  private:
+    T* base;
+    std::size_t n;
+    std::ptrdiff_t step;
+    std::ptrdiff_t componentStep;
+
+  }; // class BasicVector3View
+
+  template <typename T>
+  class BasicMatrix33View
+  {
+    static_assert(std::is_same_v<std::remove_const_t<T>, double>, "views are over double or const double");
+
+  public:
+
+    // Empty view
+    BasicMatrix33View();
+
+    // count matrices of 9 elements in the given layout, stride
+    // doubles apart
+    BasicMatrix33View(T* data, std::size_t count, MatrixLayout layout = MatrixLayout::RowMajor,
+                      std::ptrdiff_t stride = 9);
+
+    // Arbitrary element strides
+    BasicMatrix33View(T* data, std::size_t count, std::ptrdiff_t stride,
+                      std::ptrdiff_t rowStride, std::ptrdiff_t colStride);
+
+    // Packed matrices; the size must be a multiple of 9
+    explicit BasicMatrix33View(std::span<T> packed, MatrixLayout layout = MatrixLayout::RowMajor);
+
+    // Mutable view to read-only view
+    template <typename U>
+      requires (std::is_same_v<const U, T> && !std::is_same_v<U, T>)
+    BasicMatrix33View(const BasicMatrix33View<U>& other);
+
+    std::size_t size() const;
+    bool empty() const;
+
+    T* data() const;
+    std::ptrdiff_t stride() const;
+    std::ptrdiff_t rowStride() const;
+    std::ptrdiff_t colStride() const;
+
+    // Element (r, c), 0-based, of matrix i
+    T& operator()(std::size_t i, std::size_t r, std::size_t c) const;
+
+    Matrix33 get(std::size_t i) const;
+    void set(std::size_t i, const Matrix33& m) const
+      requires (!std::is_const_v<T>);
+
+    // count matrices starting at matrix begin (std::out_of_range)
+    BasicMatrix33View subview(std::size_t begin, std::size_t count) const;
+
+  private:
+    T* base;
+    std::size_t n;
+    std::ptrdiff_t step;
+    std::ptrdiff_t rowStep;
+    std::ptrdiff_t colStep;
+
+  }; // class BasicMatrix33View
+
+  using Vector3View = BasicVector3View<double>;
+  using ConstVector3View = BasicVector3View<const double>;
+  using Matrix33View = BasicMatrix33View<double>;
+  using ConstMatrix33View = BasicMatrix33View<const double>;
+
+  // ============================================================
+  // Batch operations on views
+  //
+  // Element-wise over the batch: out_i = f(a_i, b_i). All views
+  // must have the same size (std::invalid_argument); "double* out"
+  // receives size() values. Element i of every input is read
+  // before element i of out is written, so out may be one of the
+  // inputs (in place) in any layout; other overlaps between out
+  // and the inputs are not supported.
+  // ============================================================
+
+  // out_i = A_i * x_i, A * x_i, A_i^T * x_i
+  void multiply(ConstMatrix33View A, ConstVector3View x, Vector3View out);
+  void multiply(const Matrix33& A, ConstVector3View x, Vector3View out);
+  void transposeMultiply(ConstMatrix33View A, ConstVector3View x, Vector3View out);
+
+  // out_i = A_i * B_i, A_i^T
+  void multiply(ConstMatrix33View A, ConstMatrix33View B, Matrix33View out);
+  void transpose(ConstMatrix33View A, Matrix33View out);
+
+  void add(ConstVector3View a, ConstVector3View b, Vector3View out);
+  void subtract(ConstVector3View a, ConstVector3View b, Vector3View out);
+  void scale(ConstVector3View a, double s, Vector3View out);
+  void cross(ConstVector3View a, ConstVector3View b, Vector3View out);
+  void dot(ConstVector3View a, ConstVector3View b, double* out);
+  void norm(ConstVector3View a, double* out);
+
+  // Zero vectors stay zero, as with normalize(Vector3&)
+  void normalize(ConstVector3View a, Vector3View out);
+
+  // Copies between layouts, e.g. column-major to row-major
+  void copy(ConstVector3View from, Vector3View to);
+  void copy(ConstMatrix33View from, Matrix33View to);
+
+  // ============================================================
+  // Implementation
+  // ============================================================
+
+  template <typename T>
+  BasicVector3View<T>::BasicVector3View() :
+    base(nullptr), n(0), step(3), componentStep(1)
+  {
+  }
+
+  template <typename T>
+  BasicVector3View<T>::BasicVector3View(T* data_, std::size_t count_, std::ptrdiff_t stride_,
+                                        std::ptrdiff_t componentStride_) :
+    base(data_), n(count_), step(stride_), componentStep(componentStride_)
+  {
+    if (data_ == nullptr && count_ != 0)
+      throw std::invalid_argument("Vector3View: null data");
+  }
+
+  template <typename T>
+  BasicVector3View<T>::BasicVector3View(std::span<T> packed) :
+    BasicVector3View(packed.data(), packed.size() / 3)
+  {
+    if (packed.size() % 3 != 0)
+      throw std::invalid_argument("Vector3View: size is not a multiple of 3");
+  }
+
+  template <typename T>
+  template <typename U>
+    requires (std::is_same_v<const U, T> && !std::is_same_v<U, T>)
+  BasicVector3View<T>::BasicVector3View(const BasicVector3View<U>& other) :
+    base(other.data()), n(other.size()), step(other.stride()), componentStep(other.componentStride())
+  {
+  }
+
+  template <typename T>
+  std::size_t BasicVector3View<T>::size() const
+  {
+    return n;
+  }
+
+  template <typename T>
+  bool BasicVector3View<T>::empty() const
+  {
+    return n == 0;
+  }
+
+  template <typename T>
+  T* BasicVector3View<T>::data() const
+  {
+    return base;
+  }
+
+  template <typename T>
+  std::ptrdiff_t BasicVector3View<T>::stride() const
+  {
+    return step;
+  }
+
+  template <typename T>
+  std::ptrdiff_t BasicVector3View<T>::componentStride() const
+  {
+    return componentStep;
+  }
+
+  template <typename T>
+  T& BasicVector3View<T>::operator()(std::size_t i, std::size_t k) const
+  {
+    return base[std::ptrdiff_t(i) * step + std::ptrdiff_t(k) * componentStep];
+  }
+
+  template <typename T>
+  Vector3 BasicVector3View<T>::get(std::size_t i) const
+  {
+    return Vector3((*this)(i, 0), (*this)(i, 1), (*this)(i, 2));
+  }
+
+  template <typename T>
+  void BasicVector3View<T>::set(std::size_t i, const Vector3& v) const
+    requires (!std::is_const_v<T>)
+  {
+    (*this)(i, 0) = v.x;
+    (*this)(i, 1) = v.y;
+    (*this)(i, 2) = v.z;
+  }
+
+  template <typename T>
+  BasicVector3View<T> BasicVector3View<T>::subview(std::size_t begin, std::size_t count_) const
+  {
+    if (begin > n || count_ > n - begin)
+      throw std::out_of_range("Vector3View: subview out of range");
+    if (count_ == 0)
+      return BasicVector3View(base, 0, step, componentStep);
+    return BasicVector3View(&(*this)(begin, 0), count_, step, componentStep);
+  }
+
+  template <typename T>
+  BasicMatrix33View<T>::BasicMatrix33View() :
+    base(nullptr), n(0), step(9), rowStep(3), colStep(1)
+  {
+  }
+
+  template <typename T>
+  BasicMatrix33View<T>::BasicMatrix33View(T* data_, std::size_t count_, MatrixLayout layout,
+                                          std::ptrdiff_t stride_) :
+    BasicMatrix33View(data_, count_, stride_,
+                      layout == MatrixLayout::RowMajor ? 3 : 1,
+                      layout == MatrixLayout::RowMajor ? 1 : 3)
+  {
+  }
+
+  template <typename T>
+  BasicMatrix33View<T>::BasicMatrix33View(T* data_, std::size_t count_, std::ptrdiff_t stride_,
+                                          std::ptrdiff_t rowStride_, std::ptrdiff_t colStride_) :
+    base(data_), n(count_), step(stride_), rowStep(rowStride_), colStep(colStride_)
+  {
+    if (data_ == nullptr && count_ != 0)
+      throw std::invalid_argument("Matrix33View: null data");
+  }
+
+  template <typename T>
+  BasicMatrix33View<T>::BasicMatrix33View(std::span<T> packed, MatrixLayout layout) :
+    BasicMatrix33View(packed.data(), packed.size() / 9, layout)
+  {
+    if (packed.size() % 9 != 0)
+      throw std::invalid_argument("Matrix33View: size is not a multiple of 9");
+  }
+
+  template <typename T>
+  template <typename U>
+    requires (std::is_same_v<const U, T> && !std::is_same_v<U, T>)
+  BasicMatrix33View<T>::BasicMatrix33View(const BasicMatrix33View<U>& other) :
+    base(other.data()), n(other.size()), step(other.stride()),
+    rowStep(other.rowStride()), colStep(other.colStride())
+  {
+  }
+
+  template <typename T>
+  std::size_t BasicMatrix33View<T>::size() const
+  {
+    return n;
+  }
+
+  template <typename T>
+  bool BasicMatrix33View<T>::empty() const
+  {
+    return n == 0;
+  }
+
+  template <typename T>
+  T* BasicMatrix33View<T>::data() const
+  {
+    return base;
+  }
+
+  template <typename T>
+  std::ptrdiff_t BasicMatrix33View<T>::stride() const
+  {
+    return step;
+  }
+
+  template <typename T>
+  std::ptrdiff_t BasicMatrix33View<T>::rowStride() const
+  {
+    return rowStep;
+  }
+
+  template <typename T>
+  std::ptrdiff_t BasicMatrix33View<T>::colStride() const
+  {
+    return colStep;
+  }
+
+  template <typename T>
+  T& BasicMatrix33View<T>::operator()(std::size_t i, std::size_t r, std::size_t c) const
+  {
+    return base[std::ptrdiff_t(i) * step + std::ptrdiff_t(r) * rowStep + std::ptrdiff_t(c) * colStep];
+  }
+
+  template <typename T>
+  Matrix33 BasicMatrix33View<T>::get(std::size_t i) const
+  {
+    const BasicMatrix33View& m = *this;
+    return Matrix33(m(i, 0, 0), m(i, 0, 1), m(i, 0, 2),
+                    m(i, 1, 0), m(i, 1, 1), m(i, 1, 2),
+                    m(i, 2, 0), m(i, 2, 1), m(i, 2, 2));
+  }
+
+  template <typename T>
+  void BasicMatrix33View<T>::set(std::size_t i, const Matrix33& m) const
+    requires (!std::is_const_v<T>)
+  {
+    for (std::size_t r = 0; r < 3; ++r)
+      for (std::size_t c = 0; c < 3; ++c)
+        (*this)(i, r, c) = m.data[r][c];
+  }
+
+  template <typename T>
+  BasicMatrix33View<T> BasicMatrix33View<T>::subview(std::size_t begin, std::size_t count_) const
+  {
+    if (begin > n || count_ > n - begin)
+      throw std::out_of_range("Matrix33View: subview out of range");
+    if (count_ == 0)
+      return BasicMatrix33View(base, 0, step, rowStep, colStep);
+    return BasicMatrix33View(&(*this)(begin, 0, 0), count_, step, rowStep, colStep);
+  }
+
+} // namespace AML
+
+#endif // AML_STRIDEDVIEW_H
@@ -0,0 +1,185 @@
+#include "AMLSymMatrix33.h"
+#include "AMLDiagMatrix33.h"
+#include "AMLVector3.h"
+#include "AMLMatrix33.h"
+
+#include <cmath>
+
+namespace AML
+{
+
+  // Diagonal constructor
+  SymMatrix33::SymMatrix33(const DiagMatrix33& d) :
+    s11(d.d1), s12(0.0), s13(0.0), s22(d.d2), s23(0.0), s33(d.d3)
+  {}
+
+  // Dense constructor
+  SymMatrix33::SymMatrix33(const Matrix33& m) :
+    s11(m.m11), s12(m.m12), s13(m.m13), s22(m.m22), s23(m.m23), s33(m.m33)
+  {}
+
+  // Compound assignment operators
+  SymMatrix33& SymMatrix33::operator+=(const SymMatrix33& rhs)
+  {
+    for (int i = 0; i < 6; ++i)
+      data[i] += rhs.data[i];
+    return *this;
+  }
+  SymMatrix33& SymMatrix33::operator-=(const SymMatrix33& rhs)
+  {
+    for (int i = 0; i < 6; ++i)
+      data[i] -= rhs.data[i];
+    return *this;
+  }
+  SymMatrix33& SymMatrix33::operator*=(double s)
+  {
+    for (int i = 0; i < 6; ++i)
+      data[i] *= s;
+    return *this;
+  }
+  SymMatrix33& SymMatrix33::operator/=(double s)
+  {
+    for (int i = 0; i < 6; ++i)
+      data[i] /= s;
+    return *this;
+  }
+
+  // Conversions
+  Matrix33 SymMatrix33::toMatrix33() const
+  {
+    return Matrix33(s11, s12, s13,
+                    s12, s22, s23,
+                    s13, s23, s33);
+  }
+
+  // Operators
+  SymMatrix33 operator-(const SymMatrix33& rhs)
+  {
+    return SymMatrix33(-rhs.s11, -rhs.s12, -rhs.s13, -rhs.s22, -rhs.s23, -rhs.s33);
+  }
+  SymMatrix33 operator+(const SymMatrix33& lhs, const SymMatrix33& rhs) {return SymMatrix33(lhs) += rhs;}
+  SymMatrix33 operator-(const SymMatrix33& lhs, const SymMatrix33& rhs) {return SymMatrix33(lhs) -= rhs;}
+  SymMatrix33 operator*(const SymMatrix33& lhs, double s) {return SymMatrix33(lhs) *= s;}
+  SymMatrix33 operator*(double s, const SymMatrix33& rhs) {return SymMatrix33(rhs) *= s;}
+  SymMatrix33 operator/(const SymMatrix33& lhs, double s) {return SymMatrix33(lhs) /= s;}
+
+  // Matrix-vector product
+  Vector3 operator*(const SymMatrix33& lhs, const Vector3& rhs)
+  {
+    return Vector3(lhs.s11 * rhs.x + lhs.s12 * rhs.y + lhs.s13 * rhs.z,
+                   lhs.s12 * rhs.x + lhs.s22 * rhs.y + lhs.s23 * rhs.z,
+                   lhs.s13 * rhs.x + lhs.s23 * rhs.y + lhs.s33 * rhs.z);
+  }
+
+  // Dense products
+  Matrix33 operator*(const SymMatrix33& lhs, const Matrix33& rhs)
+  {
+    const SymMatrix33& s = lhs;
+    const Matrix33& m = rhs;
+    return Matrix33(s.s11 * m.m11 + s.s12 * m.m21 + s.s13 * m.m31,
+                    s.s11 * m.m12 + s.s12 * m.m22 + s.s13 * m.m32,
+                    s.s11 * m.m13 + s.s12 * m.m23 + s.s13 * m.m33,
+                    s.s12 * m.m11 + s.s22 * m.m21 + s.s23 * m.m31,
+                    s.s12 * m.m12 + s.s22 * m.m22 + s.s23 * m.m32,
+                    s.s12 * m.m13 + s.s22 * m.m23 + s.s23 * m.m33,
+                    s.s13 * m.m11 + s.s23 * m.m21 + s.s33 * m.m31,
+                    s.s13 * m.m12 + s.s23 * m.m22 + s.s33 * m.m32,
+                    s.s13 * m.m13 + s.s23 * m.m23 + s.s33 * m.m33);
+  }
+  Matrix33 operator*(const Matrix33& lhs, const SymMatrix33& rhs)
+  {
+    const Matrix33& m = lhs;
+    const SymMatrix33& s = rhs;
+    return Matrix33(m.m11 * s.s11 + m.m12 * s.s12 + m.m13 * s.s13,
+                    m.m11 * s.s12 + m.m12 * s.s22 + m.m13 * s.s23,
+                    m.m11 * s.s13 + m.m12 * s.s23 + m.m13 * s.s33,
+                    m.m21 * s.s11 + m.m22 * s.s12 + m.m23 * s.s13,
+                    m.m21 * s.s12 + m.m22 * s.s22 + m.m23 * s.s23,
+                    m.m21 * s.s13 + m.m22 * s.s23 + m.m23 * s.s33,
+                    m.m31 * s.s11 + m.m32 * s.s12 + m.m33 * s.s13,
+                    m.m31 * s.s12 + m.m32 * s.s22 + m.m33 * s.s23,
+                    m.m31 * s.s13 + m.m32 * s.s23 + m.m33 * s.s33);
+  }
+  Matrix33 operator*(const SymMatrix33& lhs, const SymMatrix33& rhs)
+  {
+    return lhs * rhs.toMatrix33();
+  }
+
+  SymMatrix33 transpose(const SymMatrix33& rhs)
+  {
+    return rhs;
+  }
+
+  double determinant(const SymMatrix33& rhs)
+  {
+    return rhs.s11 * (rhs.s22 * rhs.s33 - rhs.s23 * rhs.s23)
+      - rhs.s12 * (rhs.s12 * rhs.s33 - rhs.s23 * rhs.s13)
+      + rhs.s13 * (rhs.s12 * rhs.s23 - rhs.s22 * rhs.s13);
+  }
+
+  double trace(const SymMatrix33& rhs)
+  {
+    return rhs.s11 + rhs.s22 + rhs.s33;
+  }
+
+  SymMatrix33 inverse(const SymMatrix33& rhs)
+  {
+    // Cofactors of the upper triangle; the adjugate is symmetric
+    const double c11 = rhs.s22 * rhs.s33 - rhs.s23 * rhs.s23;
+    const double c12 = rhs.s13 * rhs.s23 - rhs.s12 * rhs.s33;
+    const double c13 = rhs.s12 * rhs.s23 - rhs.s13 * rhs.s22;
+    const double det = rhs.s11 * c11 + rhs.s12 * c12 + rhs.s13 * c13;
+    if (fabs(det) > 0.0)
+      {
+        const double invdet = 1 / det;
+        const double c22 = rhs.s11 * rhs.s33 - rhs.s13 * rhs.s13;
+        const double c23 = rhs.s12 * rhs.s13 - rhs.s11 * rhs.s23;
+        const double c33 = rhs.s11 * rhs.s22 - rhs.s12 * rhs.s12;
+        return SymMatrix33(c11 * invdet, c12 * invdet, c13 * invdet,
+                           c22 * invdet, c23 * invdet, c33 * invdet);
+      }
+    return SymMatrix33(NAN, NAN, NAN, NAN, NAN, NAN);
+  }
+
+  double quadraticForm(const SymMatrix33& S, const Vector3& v)
+  {
+    return S.s11 * v.x * v.x + S.s22 * v.y * v.y + S.s33 * v.z * v.z
+      + 2.0 * (S.s12 * v.x * v.y + S.s13 * v.x * v.z + S.s23 * v.y * v.z);
+  }
+
+  SymMatrix33 congruence(const Matrix33& R, const SymMatrix33& S)
+  {
+    // T = R * S (27 multiplies), then the upper triangle of
+    // T * R^T (18 multiplies) instead of two dense products (54)
+    const Matrix33 T = R * S;
+    return SymMatrix33(T.m11 * R.m11 + T.m12 * R.m12 + T.m13 * R.m13,
+                       T.m11 * R.m21 + T.m12 * R.m22 + T.m13 * R.m23,
+                       T.m11 * R.m31 + T.m12 * R.m32 + T.m13 * R.m33,
+                       T.m21 * R.m21 + T.m22 * R.m22 + T.m23 * R.m23,
+                       T.m21 * R.m31 + T.m22 * R.m32 + T.m23 * R.m33,
+                       T.m31 * R.m31 + T.m32 * R.m32 + T.m33 * R.m33);
+  }
+
+  SymMatrix33 congruence(const Matrix33& R, const DiagMatrix33& D)
+  {
+    // T = R * D scales the columns (9 multiplies), then the upper
+    // triangle of T * R^T (18 multiplies)
+    const Matrix33 T = R * D;
+    return SymMatrix33(T.m11 * R.m11 + T.m12 * R.m12 + T.m13 * R.m13,
+                       T.m11 * R.m21 + T.m12 * R.m22 + T.m13 * R.m23,
+                       T.m11 * R.m31 + T.m12 * R.m32 + T.m13 * R.m33,
+                       T.m21 * R.m21 + T.m22 * R.m22 + T.m23 * R.m23,
+                       T.m21 * R.m31 + T.m22 * R.m32 + T.m23 * R.m33,
+                       T.m31 * R.m31 + T.m32 * R.m32 + T.m33 * R.m33);
+  }
+
+  // Stream output
+  std::ostream& operator<<(std::ostream& os, const SymMatrix33& obj)
+  {
+    os << "sym[[" << obj.s11 << "," << obj.s12 << "," << obj.s13 << "],["
+    << obj.s22 << "," << obj.s23 << "],["
+    << obj.s33 << "]]";
+    return os;
+  }
+
+} // namespace AML
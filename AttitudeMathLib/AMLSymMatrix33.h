@@ -0,0 +1,144 @@
+#ifndef AML_SYMMATRIX33_H
+#define AML_SYMMATRIX33_H
+
+#include <iostream>
+
+namespace AML
+{
+  // Forward declarations
+  class Vector3;
+  class Matrix33;
+  class DiagMatrix33;
+
+  // ============================================================
+  // SymMatrix33
+  //
+  // Represents a symmetric 3x3 matrix by its upper triangle
+  // (6 elements instead of 9).
+  //
+  // Intended use:
+  // - Inertia tensors
+  // - 3x3 covariances
+  //
+  // congruence(R, S) evaluates R * S * R^T and returns a
+  // SymMatrix33, so rotating a tensor between frames keeps it
+  // exactly symmetric and only the upper triangle is computed.
+  // ============================================================
+  class SymMatrix33
+  {
+  public:
+
+    // ------------------------------------------------------------
+    // Storage
+    //
+    // data[0..5] or the upper-triangle elements
+    //
+    //   [ s11 s12 s13 ]
+    //   [  .  s22 s23 ]
+    //   [  .   .  s33 ]
+    // ------------------------------------------------------------
+    union
+    {
+      double data[6];
+      struct { double s11, s12, s13, s22, s23, s33; };
+    };
+
+    // ------------------------------------------------------------
+    // Constructors
+    // ------------------------------------------------------------
+
+    // Default constructor
+    // Initializes all elements to zero.
+    constexpr SymMatrix33() :
+      s11(0.0), s12(0.0), s13(0.0), s22(0.0), s23(0.0), s33(0.0)
+    {}
+
+    // Scalar constructor
+    // val * identity
+    constexpr explicit SymMatrix33(double val) :
+      s11(val), s12(0.0), s13(0.0), s22(val), s23(0.0), s33(val)
+    {}
+
+    // Element-wise constructor
+    // Upper triangle in row-major order.
+    constexpr SymMatrix33(double s11_, double s12_, double s13_,
+                          double s22_, double s23_, double s33_) :
+      s11(s11_), s12(s12_), s13(s13_), s22(s22_), s23(s23_), s33(s33_)
+    {}
+
+    // Diagonal constructor
+    SymMatrix33(const DiagMatrix33& d);
+
+    // Dense constructor
+    // Takes the upper triangle; the lower triangle is ignored.
+    explicit SymMatrix33(const Matrix33& m);
+
+    // ------------------------------------------------------------
+    // Compound assignment operators
+    // ------------------------------------------------------------
+    SymMatrix33& operator+=(const SymMatrix33& rhs);
+    SymMatrix33& operator-=(const SymMatrix33& rhs);
+    SymMatrix33& operator*=(double s);
+    SymMatrix33& operator/=(double s);
+
+    // ------------------------------------------------------------
+    // Conversions
+    // ------------------------------------------------------------
+    Matrix33 toMatrix33() const;
+
+    // ------------------------------------------------------------
+    // Identity matrix
+    // ------------------------------------------------------------
+    static constexpr SymMatrix33 identity() { return SymMatrix33(1.0); }
+
+  }; // class SymMatrix33
+
+  // ============================================================
+  // Operators
+  // ============================================================
+  SymMatrix33 operator-(const SymMatrix33& rhs);
+  SymMatrix33 operator+(const SymMatrix33& lhs, const SymMatrix33& rhs);
+  SymMatrix33 operator-(const SymMatrix33& lhs, const SymMatrix33& rhs);
+  SymMatrix33 operator*(const SymMatrix33& lhs, double s);
+  SymMatrix33 operator*(double s, const SymMatrix33& rhs);
+  SymMatrix33 operator/(const SymMatrix33& lhs, double s);
+
+  // Matrix-vector product
+  Vector3 operator*(const SymMatrix33& lhs, const Vector3& rhs);
+
+  // Dense products (the result is not symmetric in general)
+  Matrix33 operator*(const SymMatrix33& lhs, const Matrix33& rhs);
+  Matrix33 operator*(const Matrix33& lhs, const SymMatrix33& rhs);
+  Matrix33 operator*(const SymMatrix33& lhs, const SymMatrix33& rhs);
+
+  // ============================================================
+  // Utility functions
+  // ============================================================
+
+  // Symmetric matrices are their own transpose
+  SymMatrix33 transpose(const SymMatrix33& rhs);
+
+  double determinant(const SymMatrix33& rhs);
+  double trace(const SymMatrix33& rhs);
+
+  // Inverse by adjugate (the inverse is symmetric too).
+  // Returns NaN elements when singular, like inverse(const Matrix33&).
+  SymMatrix33 inverse(const SymMatrix33& rhs);
+
+  // v^T * S * v
+  double quadraticForm(const SymMatrix33& S, const Vector3& v);
+
+  // R * S * R^T, e.g. an inertia tensor or covariance expressed
+  // in another frame. Only the upper triangle is computed.
+  SymMatrix33 congruence(const Matrix33& R, const SymMatrix33& S);
+
+  // R * D * R^T for a diagonal D, e.g. a principal-axis inertia
+  // rotated into the body frame
+  SymMatrix33 congruence(const Matrix33& R, const DiagMatrix33& D);
+
+  // Stream output
+  std::ostream& operator<<(std::ostream& os, const SymMatrix33& obj);
+
+} // namespace AML
+
+#endif // AML_SYMMATRIX33_H
@@ -3,18 +3,6 @@
 
 namespace AML {
 
-  // Default Constructor
-  Vector3::Vector3()
-  : x(0.0), y(0.0), z(0.0) {}
-
-  // Scalar constructor
-  Vector3::Vector3(double val)
-  : x(val), y(val), z(val) {}
-
-  // Component-wise constructor
-  Vector3::Vector3(double x_, double y_, double z_)
-  : x(x_), y(y_), z(z_) {}
-
   // Array constructor
   Vector3::Vector3(const double data_[3])
   : x(data_[0]), y(data_[1]), z(data_[2]) {}
@@ -77,20 +65,6 @@ namespace AML {
     return *this;
   }
 
-  // Axis helper functions
-  const Vector3 Vector3::xAxis()
-  {
-    return Vector3(1.0, 0.0, 0.0);
-  }
-  const Vector3 Vector3::yAxis()
-  {
-    return Vector3(0.0, 1.0, 0.0);    
-  }
-  const Vector3 Vector3::zAxis()
-  {
-    return Vector3(0.0, 0.0, 1.0);    
-  }
-
   // ============================================================
   // Unary operators
   // ============================================================
@@ -204,7 +178,7 @@ namespace AML {
 		// lhs x y z
 		// rhs x y z
 		double x = (lhs.y * rhs.z) - (lhs.z * rhs.y);
-		double y = (lhs.x * rhs.z) - (lhs.z * rhs.x);
+		double y = (lhs.z * rhs.x) - (lhs.x * rhs.z);
 		double z = (lhs.x * rhs.y) - (lhs.y * rhs.x);
 		return Vector3(x, y, z);
 	}
@@ -39,16 +39,16 @@ namespace AML {
 
     // Default constructor
     // Intended to initialize to (0, 0, 0)
-    Vector3();
+    constexpr Vector3() : x(0.0), y(0.0), z(0.0) {}
     
     // Scalar constructor
     // Sets all components to the same value:
     // (val, val, val)
-    Vector3(double val);
+    constexpr Vector3(double val) : x(val), y(val), z(val) {}
     
     // Component-wise constructor
     // Directly initializes (x, y, z)
-    Vector3(double x, double y, double z);
+    constexpr Vector3(double x_, double y_, double z_) : x(x_), y(y_), z(z_) {}
     
     // Array constructor
     // Copies values from a raw double[3]
@@ -82,10 +82,11 @@ namespace AML {
     //
     // Return unit vectors aligned with coordinate axes.
     // Static because they do not depend on any instance.
+    // constexpr so they can be used as compile-time constants.
     // ------------------------------------------------------------
-    static const Vector3 xAxis();
-    static const Vector3 yAxis();
-    static const Vector3 zAxis();
+    static constexpr Vector3 xAxis() { return Vector3(1.0, 0.0, 0.0); }
+    static constexpr Vector3 yAxis() { return Vector3(0.0, 1.0, 0.0); }
+    static constexpr Vector3 zAxis() { return Vector3(0.0, 0.0, 1.0); }
 
   }; // Vector3
 
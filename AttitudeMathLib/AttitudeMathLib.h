@@ -3,5 +3,20 @@
 
 #include "AMLVector3.h"
 #include "AMLMatrix33.h"
+#include "AMLDiagMatrix33.h"
+#include "AMLSymMatrix33.h"
+#include "AMLDecomposition33.h"
+#include "AMLStridedView.h"
+#include "AMLAxisRotation.h"
+#include "AMLMatrixN.h"
+#include "AMLQuaternion.h"
+#include "AMLQuaternionCodec.h"
+#include "AMLOrientationIndex.h"
+#include "AMLRotationAveraging.h"
+#include "AMLFrameGraph.h"
+#include "AMLImuFilters.h"
+#include "AMLRigidBodySim.h"
+#include "AMLRingBuffer.h"
+#include "AMLPipeline.h"
 
 #endif // AttitudeMathLib_
@@ -0,0 +1,87 @@
+#include "AMLBenchmark.h"
+#include "AttitudeMathLib.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace AML;
+
+// ============================================================
+// Elementary rotations against the dense path: building a 3-2-1
+// Euler DCM and rotating vectors.
+//
+// Matrix33 operators live in the library (built with the
+// project's build type); MatrixN<3,3> is the same dense product
+// inlined and optimized here, for a like-for-like comparison.
+// ============================================================
+
+int main()
+{
+  const std::size_t n = 1 << 20;
+  std::vector<double> angles(3 * 1024);
+  for (std::size_t i = 0; i < angles.size(); ++i)
+    angles[i] = 0.001 * double(i);
+
+  std::vector<RotationZ> yaw(1024);
+  std::vector<RotationY> pitch(1024);
+  std::vector<RotationX> roll(1024);
+  std::vector<Matrix33> yawM(1024), pitchM(1024), rollM(1024);
+  std::vector<MatrixN<3, 3>> yawN(1024), pitchN(1024), rollN(1024);
+  for (std::size_t i = 0; i < 1024; ++i)
+    {
+      yaw[i] = RotationZ(angles[3 * i]);
+      pitch[i] = RotationY(angles[3 * i + 1]);
+      roll[i] = RotationX(angles[3 * i + 2]);
+      yawM[i] = yaw[i].toMatrix33();
+      pitchM[i] = pitch[i].toMatrix33();
+      rollM[i] = roll[i].toMatrix33();
+      yawN[i] = MatrixN<3, 3>(yawM[i]);
+      pitchN[i] = MatrixN<3, 3>(pitchM[i]);
+      rollN[i] = MatrixN<3, 3>(rollM[i]);
+    }
+
+  std::printf("3-2-1 Euler composition\n");
+  AMLBench::run("  Matrix33 * Matrix33 * Matrix33", n, [&](std::size_t i)
+  {
+    std::size_t k = i & 1023;
+    Matrix33 R = yawM[k] * pitchM[k] * rollM[k];
+    AMLBench::doNotOptimize(R);
+  });
+  AMLBench::run("  MatrixN<3,3> (inlined dense)", n, [&](std::size_t i)
+  {
+    std::size_t k = i & 1023;
+    MatrixN<3, 3> R = yawN[k] * pitchN[k] * rollN[k];
+    AMLBench::doNotOptimize(R);
+  });
+  AMLBench::run("  RotationZ * RotationY * RotationX", n, [&](std::size_t i)
+  {
+    std::size_t k = i & 1023;
+    Matrix33 R = yaw[k] * pitch[k] * roll[k];
+    AMLBench::doNotOptimize(R);
+  });
+
+  std::printf("Vector rotation\n");
+  Vector3 v(0.3, -1.2, 2.5);
+  AMLBench::run("  Matrix33 * Vector3", n, [&](std::size_t i)
+  {
+    AMLBench::doNotOptimize(v);
+    Vector3 r = yawM[i & 1023] * v;
+    AMLBench::doNotOptimize(r);
+  });
+  AMLBench::run("  RotationZ * Vector3", n, [&](std::size_t i)
+  {
+    AMLBench::doNotOptimize(v);
+    Vector3 r = yaw[i & 1023] * v;
+    AMLBench::doNotOptimize(r);
+  });
+
+  std::printf("Identity\n");
+  AMLBench::run("  Matrix33::identity()", n, [&](std::size_t)
+  {
+    Matrix33 I = Matrix33::identity();
+    AMLBench::doNotOptimize(I);
+  });
+
+  return 0;
+}
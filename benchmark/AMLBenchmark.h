@@ -0,0 +1,39 @@
+#ifndef AML_BENCHMARK_H
+#define AML_BENCHMARK_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+// ============================================================
+// Minimal timing helpers shared by the benchmark executables.
+//
+// run() calls body(i) for i in [0, iterations) and prints the
+// mean time per call. Results are passed to doNotOptimize so the
+// compiler cannot discard the work being measured.
+// ============================================================
+namespace AMLBench
+{
+  template <typename T>
+  inline void doNotOptimize(const T& value)
+  {
+    asm volatile("" : : "r,m"(value) : "memory");
+  }
+
+  template <typename F>
+  double run(const char* name, std::size_t iterations, F&& body)
+  {
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+      {
+        body(i);
+      }
+    const auto stop = clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / double(iterations);
+    std::printf("%-40s %12.2f ns/op\n", name, ns);
+    return ns;
+  }
+}
+
+#endif // AML_BENCHMARK_H
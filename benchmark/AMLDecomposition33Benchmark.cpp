@@ -0,0 +1,58 @@
+#include "AMLBenchmark.h"
+#include "AttitudeMathLib.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace AML;
+
+// ============================================================
+// 3x3 decompositions.
+//
+// Cost per matrix of the symmetric eigen-decomposition and SVD,
+// one matrix at a time and over structure-of-arrays batches, and
+// of the nearest-rotation and polar helpers built on the SVD.
+// ============================================================
+
+int main()
+{
+  const std::size_t n = 1 << 16;
+
+  std::mt19937 gen(1);
+  std::normal_distribution<double> normal;
+  std::vector<Matrix33> M(n);
+  std::vector<SymMatrix33> S(n);
+  Matrix33Batch batchM(n), batchS(n);
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      M[i] = Matrix33(normal(gen), normal(gen), normal(gen),
+                      normal(gen), normal(gen), normal(gen),
+                      normal(gen), normal(gen), normal(gen));
+      S[i] = SymMatrix33(M[i] + transpose(M[i]));
+      batchM.set(i, M[i]);
+      batchS.set(i, S[i].toMatrix33());
+    }
+
+  AMLBench::run("symmetricEigen", n, [&](std::size_t i) { AMLBench::doNotOptimize(symmetricEigen(S[i])); });
+  AMLBench::run("svd", n, [&](std::size_t i) { AMLBench::doNotOptimize(svd(M[i])); });
+  AMLBench::run("nearestRotation", n, [&](std::size_t i) { AMLBench::doNotOptimize(nearestRotation(M[i])); });
+  AMLBench::run("polar", n, [&](std::size_t i) { AMLBench::doNotOptimize(polar(M[i])); });
+
+  Vector3Batch values, sigma;
+  Matrix33Batch vectors, U, V;
+  double ns = AMLBench::run("batch symmetricEigen (whole batch)", 20, [&](std::size_t)
+  {
+    symmetricEigen(batchS, values, vectors);
+    AMLBench::doNotOptimize(values.x[0]);
+  });
+  std::printf("%-40s %12.2f ns/matrix\n", "", ns / double(n));
+  ns = AMLBench::run("batch svd (whole batch)", 20, [&](std::size_t)
+  {
+    svd(batchM, U, sigma, V);
+    AMLBench::doNotOptimize(sigma.x[0]);
+  });
+  std::printf("%-40s %12.2f ns/matrix\n", "", ns / double(n));
+
+  return 0;
+}
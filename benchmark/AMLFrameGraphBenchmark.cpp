@@ -0,0 +1,154 @@
+#include "AMLBenchmark.h"
+#include "AttitudeMathLib.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AML;
+
+// ============================================================
+// Frame graph query latency.
+//
+// A vehicle with 48 frames: inertial -> body, then 8 sensor arms
+// of 5 chained mounts each, plus a few frames on the body. Queries
+// go between the tips of two arms (10 edges). Timed: queries over
+// valid caches against recomposing both chains per query, queries
+// right after an update near the root or at a tip, and concurrent
+// readers with and without a writer updating the body attitude.
+// ============================================================
+
+namespace
+{
+  Matrix33 randomRotation(std::mt19937& gen)
+  {
+    std::normal_distribution<double> normal;
+    return quat2dcm(unit(Quaternion(normal(gen), normal(gen), normal(gen), normal(gen))));
+  }
+
+  // Reader threads each run "queries" queries while an optional
+  // writer updates frame "updated"; returns ns per query per reader
+  double concurrentQueries(FrameGraph& graph, unsigned readers, std::size_t queries,
+                           FrameGraph::FrameId from, FrameGraph::FrameId to,
+                           bool write, FrameGraph::FrameId updated, const std::vector<Matrix33>& updates)
+  {
+    std::atomic<unsigned> finished(0);
+    std::atomic<std::size_t> writes(0);
+    std::vector<std::thread> pool;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned t = 0; t < readers; ++t)
+      pool.emplace_back([&]()
+      {
+        for (std::size_t i = 0; i < queries; ++i)
+          AMLBench::doNotOptimize(graph.transform(from, to));
+        ++finished;
+      });
+    if (write)
+      {
+        std::size_t k = 0;
+        while (finished.load() < readers)
+          {
+            graph.setRotation(updated, updates[k++ % updates.size()]);
+            std::this_thread::yield();
+          }
+        writes = k;
+      }
+    for (std::thread& th : pool)
+      th.join();
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    if (write)
+      std::printf("%-40s %12zu updates\n", "", writes.load());
+    return ns / double(queries);
+  }
+}
+
+int main()
+{
+  std::mt19937 gen(1);
+  const int arms = 8, armLength = 5;
+
+  FrameGraph graph;
+  FrameGraph::FrameId inertial = graph.addFrame("inertial");
+  FrameGraph::FrameId body = graph.addFrame("body", inertial, randomRotation(gen));
+  std::vector<std::vector<FrameGraph::FrameId>> arm(arms);
+  std::vector<std::vector<Matrix33>> armEdges(arms);
+  for (int a = 0; a < arms; ++a)
+    {
+      FrameGraph::FrameId parent = body;
+      for (int k = 0; k < armLength; ++k)
+        {
+          Matrix33 R = randomRotation(gen);
+          parent = graph.addFrame("arm" + std::to_string(a) + "_" + std::to_string(k), parent, R);
+          arm[a].push_back(parent);
+          armEdges[a].push_back(R);
+        }
+    }
+  for (int k = 0; k < 6; ++k)
+    graph.addFrame("body" + std::to_string(k), body, randomRotation(gen));
+  std::printf("frames: %zu\n", graph.size());
+
+  FrameGraph::FrameId from = arm[0].back(), to = arm[7].back();
+  std::vector<Matrix33> updates(64);
+  for (Matrix33& R : updates)
+    R = randomRotation(gen);
+  const std::size_t n = 1 << 20;
+
+  AMLBench::run("transform, caches valid", n, [&](std::size_t)
+  {
+    AMLBench::doNotOptimize(graph.transform(from, to));
+  });
+  AMLBench::run("recompose both chains (no graph)", n, [&](std::size_t)
+  {
+    Matrix33 a = armEdges[0][0], b = armEdges[7][0];
+    for (int k = 1; k < armLength; ++k)
+      {
+        a = a * armEdges[0][k];
+        b = b * armEdges[7][k];
+      }
+    AMLBench::doNotOptimize(transpose(b) * a);
+  });
+  AMLBench::run("update body + transform", n / 4, [&](std::size_t i)
+  {
+    graph.setRotation(body, updates[i % updates.size()]);
+    AMLBench::doNotOptimize(graph.transform(from, to));
+  });
+  AMLBench::run("update arm tip + transform", n / 4, [&](std::size_t i)
+  {
+    graph.setRotation(from, updates[i % updates.size()]);
+    AMLBench::doNotOptimize(graph.transform(from, to));
+  });
+  AMLBench::run("update other arm + transform", n / 4, [&](std::size_t i)
+  {
+    graph.setRotation(arm[3][0], updates[i % updates.size()]);
+    AMLBench::doNotOptimize(graph.transform(from, to));
+  });
+
+  FrameGraph::FrameId batchFrom[16], batchTo[16];
+  Matrix33 out[16];
+  for (int k = 0; k < 16; ++k)
+    {
+      batchFrom[k] = arm[k % arms].back();
+      batchTo[k] = arm[(k + 3) % arms][k % armLength];
+    }
+  double ns = AMLBench::run("transforms, 16 per call", n / 16, [&](std::size_t)
+  {
+    graph.transforms(batchFrom, batchTo, out, 16);
+    AMLBench::doNotOptimize(out[0]);
+  });
+  std::printf("%-40s %12.2f ns/query\n", "", ns / 16.0);
+
+  // One core is left for the writer; hardware_concurrency() may be 0
+  unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+  unsigned readers = std::max(2u, hw) - 1;
+  ns = concurrentQueries(graph, readers, n / 4, from, to, false, body, updates);
+  std::printf("%-40s %12.2f ns/query (%u readers)\n", "concurrent readers", ns, readers);
+  ns = concurrentQueries(graph, readers, n / 4, from, to, true, body, updates);
+  std::printf("%-40s %12.2f ns/query (%u readers)\n", "concurrent readers, body updates", ns, readers);
+
+  return 0;
+}
@@ -0,0 +1,80 @@
+#include "AMLBenchmark.h"
+#include "AttitudeMathLib.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace AML;
+
+// ============================================================
+// Throughput of the batched IMU filters: one update call for all
+// sensors per tick, against one single-sensor filter per sensor.
+// Reported time is per sensor update.
+// ============================================================
+
+namespace
+{
+  const std::size_t sensors = 1024;
+  const std::size_t ticks = 2000;
+  const double dt = 0.01;
+
+  ImuBatch makeTick()
+  {
+    ImuBatch imu(sensors);
+    for (std::size_t i = 0; i < sensors; ++i)
+      {
+        double p = 0.001 * double(i);
+        imu.set(i, Vector3(0.01 + p, -0.02, 0.03),
+                Vector3(0.1 * std::sin(p), 0.1 * std::cos(p), 9.81),
+                Vector3(0.22, 0.01 * p, -0.42));
+      }
+    return imu;
+  }
+
+  template <typename Filter, typename... Args>
+  void compare(const char* name, bool useMag, Args... args)
+  {
+    ImuBatch imu = makeTick();
+    char label[64];
+
+    Filter batch(sensors, args...);
+    std::snprintf(label, sizeof(label), "%s batched%s", name, useMag ? "" : " (imu)");
+    AMLBench::run(label, ticks * sensors, [&](std::size_t i)
+    {
+      if (i % sensors == 0)
+        {
+          batch.update(imu, dt, useMag);
+          AMLBench::doNotOptimize(batch);
+        }
+    });
+
+    std::vector<Filter> single(sensors, Filter(1, args...));
+    std::vector<ImuBatch> one(sensors, ImuBatch(1));
+    for (std::size_t s = 0; s < sensors; ++s)
+      {
+        one[s].set(0, Vector3(imu.gx[s], imu.gy[s], imu.gz[s]),
+                   Vector3(imu.ax[s], imu.ay[s], imu.az[s]),
+                   Vector3(imu.mx[s], imu.my[s], imu.mz[s]));
+      }
+    std::snprintf(label, sizeof(label), "%s per-sensor%s", name, useMag ? "" : " (imu)");
+    AMLBench::run(label, ticks * sensors, [&](std::size_t i)
+    {
+      std::size_t s = i % sensors;
+      single[s].update(one[s], dt, useMag);
+      AMLBench::doNotOptimize(single[s]);
+    });
+  }
+}
+
+int main()
+{
+  std::printf("%zu sensors, %zu ticks\n", sensors, ticks);
+  compare<MahonyFilterBatch>("Mahony", true, 1.0, 0.1);
+  compare<MahonyFilterBatch>("Mahony", false, 1.0, 0.1);
+  compare<MadgwickFilterBatch>("Madgwick", true, 0.1);
+  compare<MadgwickFilterBatch>("Madgwick", false, 0.1);
+  compare<ComplementaryFilterBatch>("Complementary", true, 0.02, 0.02);
+  compare<ComplementaryFilterBatch>("Complementary", false, 0.02, 0.02);
+  return 0;
+}
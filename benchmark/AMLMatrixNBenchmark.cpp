@@ -0,0 +1,99 @@
+#include "AMLBenchmark.h"
+#include "AttitudeMathLib.h"
+
+#include <vector>
+
+using namespace AML;
+
+// ============================================================
+// Dynamic-size baseline: heap-allocated row-major matrix, the
+// shape of what a general linear algebra library does per call.
+// ============================================================
+struct DynMatrix
+{
+  std::size_t rows, cols;
+  std::vector<double> data;
+
+  DynMatrix(std::size_t r, std::size_t c) : rows(r), cols(c), data(r * c, 0.0) {}
+  double& operator()(std::size_t i, std::size_t j) { return data[i * cols + j]; }
+  double operator()(std::size_t i, std::size_t j) const { return data[i * cols + j]; }
+};
+
+DynMatrix multiply(const DynMatrix& a, const DynMatrix& b)
+{
+  DynMatrix c(a.rows, b.cols);
+  for (std::size_t i = 0; i < a.rows; ++i)
+    for (std::size_t j = 0; j < b.cols; ++j)
+      {
+        double s = 0.0;
+        for (std::size_t k = 0; k < a.cols; ++k)
+          s += a(i, k) * b(k, j);
+        c(i, j) = s;
+      }
+  return c;
+}
+
+DynMatrix transpose(const DynMatrix& a)
+{
+  DynMatrix t(a.cols, a.rows);
+  for (std::size_t i = 0; i < a.rows; ++i)
+    for (std::size_t j = 0; j < a.cols; ++j)
+      t(j, i) = a(i, j);
+  return t;
+}
+
+int main()
+{
+  const std::size_t n = 1000000;
+
+  Matrix66 P;
+  Matrix36 H;
+  DynMatrix dP(6, 6), dH(3, 6);
+  for (std::size_t i = 0; i < 6; ++i)
+    for (std::size_t j = 0; j < 6; ++j)
+      {
+        P(i, j) = dP(i, j) = (i == j) ? 2.0 : 0.1 / (1.0 + i + j);
+        if (i < 3)
+          H(i, j) = dH(i, j) = 0.5 + 0.01 * double(i * 6 + j);
+      }
+
+  std::printf("6x6 * 6x6\n");
+  AMLBench::run("  MatrixN<6,6>", n, [&](std::size_t)
+  {
+    AMLBench::doNotOptimize(P);
+    Matrix66 r = P * P;
+    AMLBench::doNotOptimize(r);
+  });
+  AMLBench::run("  dynamic", n, [&](std::size_t)
+  {
+    AMLBench::doNotOptimize(dP);
+    DynMatrix r = multiply(dP, dP);
+    AMLBench::doNotOptimize(r.data[0]);
+  });
+
+  std::printf("EKF innovation covariance H * P * H^T (3x6, 6x6)\n");
+  AMLBench::run("  MatrixN", n, [&](std::size_t)
+  {
+    AMLBench::doNotOptimize(P);
+    MatrixN<3, 3> S = H * P * transpose(H);
+    AMLBench::doNotOptimize(S);
+  });
+  AMLBench::run("  dynamic", n, [&](std::size_t)
+  {
+    AMLBench::doNotOptimize(dP);
+    DynMatrix S = multiply(multiply(dH, dP), transpose(dH));
+    AMLBench::doNotOptimize(S.data[0]);
+  });
+
+  std::printf("6x6 Cholesky\n");
+  AMLBench::run("  MatrixN", n, [&](std::size_t)
+  {
+    AMLBench::doNotOptimize(P);
+    Matrix66 L;
+    bool ok = cholesky(P, L);
+    AMLBench::doNotOptimize(ok);
+    AMLBench::doNotOptimize(L);
+  });
+
+  return 0;
+}
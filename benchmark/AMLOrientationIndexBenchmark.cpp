@@ -0,0 +1,118 @@
+#include "AMLBenchmark.h"
+#include "AttitudeMathLib.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace AML;
+
+// ============================================================
+// OrientationIndex against brute force.
+//
+// A library of one million random attitudes is indexed; queries
+// are either uniformly random or close to a library entry (the
+// template-matching case). Brute force is the dense Matrix33
+// comparison (trace of R^T * R_i per entry), timed on a few
+// queries since it scans the whole library each time.
+// ============================================================
+
+namespace
+{
+  double seconds(std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+}
+
+int main()
+{
+  const std::size_t n = 1000000;
+  const std::size_t queryCount = 4096;
+
+  std::mt19937 gen(1);
+  std::normal_distribution<double> normal;
+  std::vector<Quaternion> library(n);
+  for (Quaternion& x : library)
+    x = unit(Quaternion(normal(gen), normal(gen), normal(gen), normal(gen)));
+
+  std::vector<Quaternion> random(queryCount), close(queryCount);
+  for (std::size_t i = 0; i < queryCount; ++i)
+    {
+      random[i] = unit(Quaternion(normal(gen), normal(gen), normal(gen), normal(gen)));
+      Quaternion jitter(1.0, 0.005 * normal(gen), 0.005 * normal(gen), 0.005 * normal(gen));
+      close[i] = unit(library[(i * 7919) % n] * jitter);
+    }
+
+  auto start = std::chrono::steady_clock::now();
+  OrientationIndex index(library);
+  std::printf("build (%zu attitudes)                  %12.3f s\n", n, seconds(start));
+
+  // Status quo: dense rotation matrices, best trace
+  std::vector<Matrix33> dcm(n);
+  for (std::size_t i = 0; i < n; ++i)
+    dcm[i] = quat2dcm(library[i]);
+  AMLBench::run("brute force Matrix33, k = 1", 4, [&](std::size_t i)
+  {
+    Matrix33 rt = transpose(quat2dcm(random[i]));
+    double best = -2.0;
+    std::size_t bestIndex = 0;
+    for (std::size_t j = 0; j < n; ++j)
+      {
+        const Matrix33& r = dcm[j];
+        double t = rt.m11 * r.m11 + rt.m12 * r.m21 + rt.m13 * r.m31
+          + rt.m21 * r.m12 + rt.m22 * r.m22 + rt.m23 * r.m32
+          + rt.m31 * r.m13 + rt.m32 * r.m23 + rt.m33 * r.m33;
+        if (t > best)
+          {
+            best = t;
+            bestIndex = j;
+          }
+      }
+    AMLBench::doNotOptimize(bestIndex);
+  });
+
+  const struct { const std::vector<Quaternion>* queries; const char* name; } sets[] = {
+    {&random, "random"},
+    {&close, "near library"}};
+
+  for (const auto& set : sets)
+    {
+      const std::vector<Quaternion>& q = *set.queries;
+      std::printf("%s queries\n", set.name);
+      AMLBench::run("  nearest, k = 1", queryCount, [&](std::size_t i)
+      {
+        AMLBench::doNotOptimize(index.nearest(q[i], 1)[0].index);
+      });
+      AMLBench::run("  nearest, k = 10", queryCount, [&](std::size_t i)
+      {
+        AMLBench::doNotOptimize(index.nearest(q[i], 10)[0].index);
+      });
+      std::size_t found = 0;
+      AMLBench::run("  within 0.05 rad", queryCount, [&](std::size_t i)
+      {
+        found += index.withinAngle(q[i], 0.05).size();
+      });
+      std::printf("%-40s %12.2f matches/query\n", "", double(found) / double(queryCount));
+
+      double ns = AMLBench::run("  batched nearest k = 1 (whole batch)", 4, [&](std::size_t)
+      {
+        AMLBench::doNotOptimize(index.nearest(q, 1)[0].index);
+      });
+      std::printf("%-40s %12.2f ns/query\n", "", ns / double(queryCount));
+    }
+
+  std::stringstream file;
+  start = std::chrono::steady_clock::now();
+  index.save(file);
+  std::printf("save (%zu bytes)                 %12.3f s\n", file.str().size(), seconds(start));
+  start = std::chrono::steady_clock::now();
+  OrientationIndex loaded = OrientationIndex::load(file);
+  std::printf("load                                     %12.3f s\n", seconds(start));
+  AMLBench::doNotOptimize(loaded.size());
+
+  return 0;
+}
@@ -0,0 +1,118 @@
+#include "AMLBenchmark.h"
+#include "AttitudeMathLib.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace AML;
+
+// ============================================================
+// QuaternionCodec throughput against error.
+//
+// For each width: batch and one-at-a-time encode/decode cost per
+// attitude, bytes per attitude, and the measured max / RMS angular
+// error on random attitudes next to the documented bound. Delta
+// streams are measured on a slowly varying attitude.
+// ============================================================
+
+namespace
+{
+  double angleBetween(const Quaternion& a, const Quaternion& b)
+  {
+    Quaternion d = conjugate(a) * b;
+    double v = std::sqrt(d.q1 * d.q1 + d.q2 * d.q2 + d.q3 * d.q3);
+    return 2.0 * std::atan2(v, std::fabs(d.q0));
+  }
+
+  void reportError(const char* name, const std::vector<Quaternion>& q, const std::vector<Quaternion>& back)
+  {
+    double maxError = 0.0, sum = 0.0;
+    for (std::size_t i = 0; i < q.size(); ++i)
+      {
+        double e = angleBetween(q[i], back[i]);
+        maxError = std::fmax(maxError, e);
+        sum += e * e;
+      }
+    std::printf("  %-38s max %.3e rad, rms %.3e rad\n", name, maxError, std::sqrt(sum / double(q.size())));
+  }
+}
+
+int main()
+{
+  const std::size_t n = 1 << 16;
+
+  std::mt19937 gen(1);
+  std::normal_distribution<double> normal;
+  std::vector<Quaternion> q(n);
+  for (Quaternion& x : q)
+    x = unit(Quaternion(normal(gen), normal(gen), normal(gen), normal(gen)));
+
+  std::vector<Quaternion> smooth(n);
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      double t = 0.01 * double(i);
+      Vector3 axis = unit(Vector3(std::cos(0.3 * t), std::sin(0.3 * t), 1.0));
+      smooth[i] = Quaternion(std::cos(0.4 * t), axis * std::sin(0.4 * t));
+    }
+
+  const struct { QuaternionCodec::Width width; const char* name; } widths[] = {
+    {QuaternionCodec::Width::Bits32, "32-bit"},
+    {QuaternionCodec::Width::Bits48, "48-bit"},
+    {QuaternionCodec::Width::Bits64, "64-bit"}};
+
+  std::printf("Raw: Quaternion %zu bytes, Matrix33 %zu bytes\n", sizeof(Quaternion), sizeof(Matrix33));
+
+  for (const auto& w : widths)
+    {
+      QuaternionCodec codec(w.width);
+      std::vector<std::uint8_t> bytes(n * codec.bytes());
+      std::vector<Quaternion> back(n);
+
+      std::printf("%s (%zu bytes, bound %.3e rad)\n", w.name, codec.bytes(), codec.maxAngularError());
+      double ns = AMLBench::run("  batch encode (whole batch)", 20, [&](std::size_t)
+      {
+        codec.encode(q.data(), n, bytes.data());
+        AMLBench::doNotOptimize(bytes[0]);
+      });
+      std::printf("%-40s %12.2f ns/attitude\n", "", ns / double(n));
+      ns = AMLBench::run("  batch decode (whole batch)", 20, [&](std::size_t)
+      {
+        codec.decode(bytes.data(), n, back.data());
+        AMLBench::doNotOptimize(back[0]);
+      });
+      std::printf("%-40s %12.2f ns/attitude\n", "", ns / double(n));
+      AMLBench::run("  scalar encode", n, [&](std::size_t i)
+      {
+        std::uint64_t code = codec.encode(q[i]);
+        AMLBench::doNotOptimize(code);
+      });
+      AMLBench::run("  scalar decode", n, [&](std::size_t i)
+      {
+        Quaternion x = codec.decode(std::uint64_t(i) & 0xFFFFFFFF);
+        AMLBench::doNotOptimize(x);
+      });
+      reportError("absolute error", q, codec.decode(bytes));
+
+      // Delta stream of a slowly varying attitude
+      QuaternionDeltaEncoder encoder(w.width, 0.05);
+      std::vector<std::uint8_t> stream;
+      stream.reserve(n * codec.bytes());
+      AMLBench::run("  delta encode", n, [&](std::size_t i)
+      {
+        encoder.push(smooth[i], stream);
+      });
+      std::vector<Quaternion> decoded;
+      decoded.reserve(n);
+      QuaternionDeltaDecoder decoder(w.width, 0.05);
+      ns = AMLBench::run("  delta decode (whole stream)", 1, [&](std::size_t)
+      {
+        decoder.decode(stream.data(), stream.size(), decoded);
+      });
+      std::printf("%-40s %12.2f ns/attitude\n", "", ns / double(n));
+      reportError("delta error (maxStep 0.05 rad)", smooth, decoded);
+    }
+
+  return 0;
+}
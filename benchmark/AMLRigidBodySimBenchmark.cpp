@@ -0,0 +1,101 @@
+#include "AMLBenchmark.h"
+#include "AttitudeMathLib.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+using namespace AML;
+
+// ============================================================
+// RigidBodySimulator throughput and thread scaling.
+//
+// Each line runs `steps` fixed steps of the whole fleet and
+// reports the time per run and per body-step. The torque case
+// uses a per-body callback (attitude-dependent restoring torque).
+// The last section makes the same steps of a small fleet with one
+// run() and with one step() call at a time, which starts the
+// worker threads for every step.
+// ============================================================
+
+namespace
+{
+  void setFleet(RigidBodySimulator& sim)
+  {
+    for (std::size_t i = 0; i < sim.size(); ++i)
+      {
+        double a = 1e-3 * double(i % 1000);
+        sim.setBody(i, DiagMatrix33(1.0 + a, 2.0, 3.0 - a),
+                    Quaternion(std::cos(a), 0.0, std::sin(a), 0.0),
+                    Vector3(0.1, 2.0 + a, 0.05));
+      }
+  }
+
+  Vector3 restoringTorque(double, std::size_t, const Quaternion& q, const Vector3& w)
+  {
+    Vector3 zBody = rotate(conjugate(q), Vector3::zAxis());
+    return cross(Vector3::zAxis(), zBody) * 0.1 - w * 0.01;
+  }
+
+  void bench(const char* name, std::size_t bodies, std::size_t steps,
+             RigidBodySimulator::Integrator method, unsigned threads, bool withTorque)
+  {
+    RigidBodySimulator sim(bodies, method, threads);
+    setFleet(sim);
+    if (withTorque)
+      sim.setBodyTorque(restoringTorque);
+    sim.run(0.01, steps); // warm-up
+
+    char label[64];
+    std::snprintf(label, sizeof(label), "  %s, %u thread(s)", name, threads);
+    double ns = AMLBench::run(label, 5, [&](std::size_t)
+    {
+      sim.run(0.01, steps);
+    });
+    std::printf("%-40s %12.2f ns/body-step\n", "", ns / double(bodies * steps));
+  }
+
+  void benchStepLoop(const char* name, std::size_t bodies, std::size_t steps,
+                     RigidBodySimulator::Integrator method, unsigned threads)
+  {
+    RigidBodySimulator sim(bodies, method, threads);
+    setFleet(sim);
+    sim.run(0.01, steps); // warm-up
+
+    char label[64];
+    std::snprintf(label, sizeof(label), "  %s, %u thread(s)", name, threads);
+    double ns = AMLBench::run(label, 5, [&](std::size_t)
+    {
+      for (std::size_t k = 0; k < steps; ++k)
+        sim.step(0.01);
+    });
+    std::printf("%-40s %12.2f ns/body-step\n", "", ns / double(bodies * steps));
+  }
+}
+
+int main()
+{
+  const std::size_t bodies = 16384;
+  const std::size_t steps = 50;
+
+  unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+  std::printf("%zu bodies, %zu steps per run, %u hardware threads\n", bodies, steps, hw);
+
+  for (unsigned threads = 1; threads <= std::max(4u, hw); threads *= 2)
+    {
+      std::printf("Threads: %u\n", threads);
+      bench("RK4 torque-free", bodies, steps, RigidBodySimulator::Integrator::RK4, threads, false);
+      bench("Symplectic torque-free", bodies, steps, RigidBodySimulator::Integrator::Symplectic, threads, false);
+      bench("RK4 + torque callback", bodies, steps, RigidBodySimulator::Integrator::RK4, threads, true);
+      bench("Symplectic + torque callback", bodies, steps, RigidBodySimulator::Integrator::Symplectic, threads, true);
+    }
+
+  const std::size_t small = 1024;
+  const unsigned threads = std::max(4u, hw);
+  std::printf("Per-call overhead: %zu bodies, %zu steps\n", small, steps);
+  bench("RK4 torque-free, run()", small, steps, RigidBodySimulator::Integrator::RK4, threads, false);
+  benchStepLoop("RK4 torque-free, step() loop", small, steps, RigidBodySimulator::Integrator::RK4, threads);
+
+  return 0;
+}
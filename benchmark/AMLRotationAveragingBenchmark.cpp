@@ -0,0 +1,106 @@
+#include "AMLBenchmark.h"
+#include "AttitudeMathLib.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace AML;
+
+// ============================================================
+// Streaming rotation averaging.
+//
+// Cost per sample of adding quaternions / rotation matrices to
+// each accumulator one at a time and in batches, the cost of
+// extracting the mean, and a parallel reduction over threads
+// with merge().
+// ============================================================
+
+int main()
+{
+  const std::size_t n = 1 << 20;
+
+  std::mt19937 gen(1);
+  std::normal_distribution<double> normal;
+  std::vector<Quaternion> q(n);
+  std::vector<Matrix33> R(n);
+  std::vector<double> w(n);
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      q[i] = unit(Quaternion(1.0, 0.2 * normal(gen), 0.2 * normal(gen), 0.2 * normal(gen)));
+      R[i] = quat2dcm(q[i]);
+      w[i] = 0.5 + 0.5 * std::fabs(normal(gen));
+    }
+
+  {
+    ChordalMeanAccumulator acc;
+    std::printf("ChordalMeanAccumulator\n");
+    AMLBench::run("  add(Matrix33)", n, [&](std::size_t i) { acc.add(R[i]); });
+    AMLBench::run("  add(Quaternion)", n, [&](std::size_t i) { acc.add(q[i]); });
+    AMLBench::run("  add + remove (sliding window)", n, [&](std::size_t i)
+    {
+      acc.add(q[i]);
+      acc.remove(q[i]);
+    });
+    double ns = AMLBench::run("  batch add(Matrix33) (whole batch)", 10, [&](std::size_t)
+    {
+      acc.add(R.data(), n);
+    });
+    std::printf("%-40s %12.2f ns/sample\n", "", ns / double(n));
+    ns = AMLBench::run("  batch add(Quaternion), weighted", 10, [&](std::size_t)
+    {
+      acc.add(q.data(), n, w.data());
+    });
+    std::printf("%-40s %12.2f ns/sample\n", "", ns / double(n));
+    AMLBench::run("  mean()", 100000, [&](std::size_t) { AMLBench::doNotOptimize(acc.mean()); });
+  }
+
+  {
+    QuaternionMeanAccumulator acc;
+    std::printf("QuaternionMeanAccumulator\n");
+    AMLBench::run("  add(Quaternion)", n, [&](std::size_t i) { acc.add(q[i]); });
+    AMLBench::run("  add(Matrix33)", n, [&](std::size_t i) { acc.add(R[i]); });
+    AMLBench::run("  add + remove (sliding window)", n, [&](std::size_t i)
+    {
+      acc.add(q[i]);
+      acc.remove(q[i]);
+    });
+    double ns = AMLBench::run("  batch add(Quaternion) (whole batch)", 10, [&](std::size_t)
+    {
+      acc.add(q.data(), n);
+    });
+    std::printf("%-40s %12.2f ns/sample\n", "", ns / double(n));
+    ns = AMLBench::run("  batch add(Matrix33), weighted", 10, [&](std::size_t)
+    {
+      acc.add(R.data(), n, w.data());
+    });
+    std::printf("%-40s %12.2f ns/sample\n", "", ns / double(n));
+    AMLBench::run("  mean()", 100000, [&](std::size_t) { AMLBench::doNotOptimize(acc.mean()); });
+  }
+
+  // Parallel reduction: one partial accumulator per thread
+  unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+  double ns = AMLBench::run("parallel reduction (whole batch)", 10, [&](std::size_t)
+  {
+    std::vector<QuaternionMeanAccumulator> partial(threads);
+    std::vector<std::thread> pool;
+    std::size_t per = (n + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; ++t)
+      pool.emplace_back([&, t]()
+      {
+        std::size_t begin = std::min(n, t * per);
+        partial[t].add(q.data() + begin, std::min(n, begin + per) - begin);
+      });
+    for (std::thread& th : pool)
+      th.join();
+    for (unsigned t = 1; t < threads; ++t)
+      partial[0] += partial[t];
+    AMLBench::doNotOptimize(partial[0].mean());
+  });
+  std::printf("%-40s %12.2f ns/sample (%u threads)\n", "", ns / double(n), threads);
+
+  return 0;
+}
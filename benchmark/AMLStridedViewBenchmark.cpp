@@ -0,0 +1,132 @@
+#include "AMLBenchmark.h"
+#include "AttitudeMathLib.h"
+
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace AML;
+
+// ============================================================
+// Strided views against copying.
+//
+// Telemetry-style flat buffers: per record an attitude (row- or
+// column-major) and a body vector. Each operation is timed the
+// copying way (Matrix33(const double[9]) / Vector3(const double[3])
+// in, math on the objects, elements written back to the buffer)
+// and directly on strided views, in place.
+// ============================================================
+
+int main()
+{
+  const std::size_t n = 1 << 16;
+  const int reps = 200;
+
+  std::mt19937 gen(1);
+  std::normal_distribution<double> normal;
+  std::vector<double> rows(9 * n), cols(9 * n), vec(3 * n), out(3 * n);
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      Matrix33 R = quat2dcm(unit(Quaternion(normal(gen), normal(gen), normal(gen), normal(gen))));
+      Matrix33View(rows.data(), n).set(i, R);
+      Matrix33View(cols.data(), n, MatrixLayout::ColumnMajor).set(i, R);
+    }
+  for (double& e : vec)
+    e = normal(gen);
+
+  Matrix33View rowView{std::span<double>(rows)};
+  Matrix33View colView{std::span<double>(cols), MatrixLayout::ColumnMajor};
+  Vector3View vecView{std::span<double>(vec)};
+  Vector3View outView{std::span<double>(out)};
+
+  auto report = [&](double ns) { std::printf("%-40s %12.2f ns/record\n", "", ns / double(n)); };
+
+  // out_i = R_i * v_i
+  report(AMLBench::run("R * v, copy in / out (row-major)", reps, [&](std::size_t)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+      {
+        Vector3 r = Matrix33(rows.data() + 9 * i) * Vector3(vec.data() + 3 * i);
+        out[3 * i] = r.x;
+        out[3 * i + 1] = r.y;
+        out[3 * i + 2] = r.z;
+      }
+    AMLBench::doNotOptimize(out[0]);
+  }));
+  report(AMLBench::run("R * v, views (row-major)", reps, [&](std::size_t)
+  {
+    multiply(rowView, vecView, outView);
+    AMLBench::doNotOptimize(out[0]);
+  }));
+  report(AMLBench::run("R * v, copy in / out (column-major)", reps, [&](std::size_t)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+      {
+        Vector3 r = transpose(Matrix33(cols.data() + 9 * i)) * Vector3(vec.data() + 3 * i);
+        out[3 * i] = r.x;
+        out[3 * i + 1] = r.y;
+        out[3 * i + 2] = r.z;
+      }
+    AMLBench::doNotOptimize(out[0]);
+  }));
+  report(AMLBench::run("R * v, views (column-major)", reps, [&](std::size_t)
+  {
+    multiply(colView, vecView, outView);
+    AMLBench::doNotOptimize(out[0]);
+  }));
+
+  // v_i = R_i^T * v_i in place; rotations keep the buffer
+  // bounded over the repetitions
+  report(AMLBench::run("R^T * v in place, copy in / out", reps, [&](std::size_t)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+      {
+        Vector3 r = transpose(Matrix33(rows.data() + 9 * i)) * Vector3(vec.data() + 3 * i);
+        vec[3 * i] = r.x;
+        vec[3 * i + 1] = r.y;
+        vec[3 * i + 2] = r.z;
+      }
+    AMLBench::doNotOptimize(vec[0]);
+  }));
+  report(AMLBench::run("R^T * v in place, views", reps, [&](std::size_t)
+  {
+    transposeMultiply(rowView, vecView, vecView);
+    AMLBench::doNotOptimize(vec[0]);
+  }));
+
+  // Attitude composition R_i <- R_i * C_i, row-major target and
+  // column-major increments, in place
+  report(AMLBench::run("R * C in place, copy in / out", reps, [&](std::size_t)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+      {
+        Matrix33 p = Matrix33(rows.data() + 9 * i) * transpose(Matrix33(cols.data() + 9 * i));
+        for (int r = 0; r < 3; ++r)
+          for (int c = 0; c < 3; ++c)
+            rows[9 * i + 3 * r + c] = p.data[r][c];
+      }
+    AMLBench::doNotOptimize(rows[0]);
+  }));
+  report(AMLBench::run("R * C in place, views", reps, [&](std::size_t)
+  {
+    multiply(rowView, colView, rowView);
+    AMLBench::doNotOptimize(rows[0]);
+  }));
+
+  // The copy alone: the work the views remove
+  std::vector<Matrix33> matrices(n);
+  std::vector<Vector3> vectors(n);
+  report(AMLBench::run("copy into Matrix33 / Vector3 only", reps, [&](std::size_t)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+      {
+        matrices[i] = Matrix33(rows.data() + 9 * i);
+        vectors[i] = Vector3(vec.data() + 3 * i);
+      }
+    AMLBench::doNotOptimize(matrices[n - 1]);
+    AMLBench::doNotOptimize(vectors[n - 1]);
+  }));
+
+  return 0;
+}
@@ -0,0 +1,110 @@
+#include "AMLBenchmark.h"
+#include "AttitudeMathLib.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace AML;
+
+// ============================================================
+// Diagonal and symmetric 3x3 types against the dense Matrix33
+// path: inertia-tensor products and frame changes R * S * R^T.
+//
+// Both paths are library calls built with the project's build
+// type, so the comparison is like-for-like.
+// ============================================================
+
+int main()
+{
+  const std::size_t n = 1 << 20;
+
+  std::vector<Matrix33> R(1024);
+  std::vector<DiagMatrix33> D(1024);
+  std::vector<SymMatrix33> S(1024);
+  std::vector<Matrix33> Dd(1024), Sd(1024), Rt(1024);
+  for (std::size_t i = 0; i < 1024; ++i)
+    {
+      double a = 0.001 * double(i);
+      R[i] = RotationZ(a) * RotationY(2.0 * a) * RotationX(3.0 * a);
+      Rt[i] = transpose(R[i]);
+      D[i] = DiagMatrix33(1.0 + a, 2.0 + a, 3.0 + a);
+      S[i] = SymMatrix33(4.0 + a, -0.3, 0.2, 5.0, 0.1 * a, 6.0);
+      Dd[i] = D[i].toMatrix33();
+      Sd[i] = S[i].toMatrix33();
+    }
+  Vector3 w(0.3, -1.2, 2.5);
+
+  std::printf("Inertia * angular rate\n");
+  AMLBench::run("  Matrix33 (diagonal) * Vector3", n, [&](std::size_t i)
+  {
+    AMLBench::doNotOptimize(w);
+    Vector3 h = Dd[i & 1023] * w;
+    AMLBench::doNotOptimize(h);
+  });
+  AMLBench::run("  DiagMatrix33 * Vector3", n, [&](std::size_t i)
+  {
+    AMLBench::doNotOptimize(w);
+    Vector3 h = D[i & 1023] * w;
+    AMLBench::doNotOptimize(h);
+  });
+  AMLBench::run("  Matrix33 (symmetric) * Vector3", n, [&](std::size_t i)
+  {
+    AMLBench::doNotOptimize(w);
+    Vector3 h = Sd[i & 1023] * w;
+    AMLBench::doNotOptimize(h);
+  });
+  AMLBench::run("  SymMatrix33 * Vector3", n, [&](std::size_t i)
+  {
+    AMLBench::doNotOptimize(w);
+    Vector3 h = S[i & 1023] * w;
+    AMLBench::doNotOptimize(h);
+  });
+
+  std::printf("Matrix scaling\n");
+  AMLBench::run("  Matrix33 (diagonal) * Matrix33", n, [&](std::size_t i)
+  {
+    std::size_t k = i & 1023;
+    Matrix33 M = Dd[k] * R[k];
+    AMLBench::doNotOptimize(M);
+  });
+  AMLBench::run("  DiagMatrix33 * Matrix33", n, [&](std::size_t i)
+  {
+    std::size_t k = i & 1023;
+    Matrix33 M = D[k] * R[k];
+    AMLBench::doNotOptimize(M);
+  });
+
+  std::printf("Frame change R * S * R^T\n");
+  AMLBench::run("  dense R * S * transpose(R)", n, [&](std::size_t i)
+  {
+    std::size_t k = i & 1023;
+    Matrix33 M = R[k] * Sd[k] * transpose(R[k]);
+    AMLBench::doNotOptimize(M);
+  });
+  AMLBench::run("  dense R * S * Rt (Rt precomputed)", n, [&](std::size_t i)
+  {
+    std::size_t k = i & 1023;
+    Matrix33 M = R[k] * Sd[k] * Rt[k];
+    AMLBench::doNotOptimize(M);
+  });
+  AMLBench::run("  congruence(R, SymMatrix33)", n, [&](std::size_t i)
+  {
+    std::size_t k = i & 1023;
+    SymMatrix33 M = congruence(R[k], S[k]);
+    AMLBench::doNotOptimize(M);
+  });
+  AMLBench::run("  dense R * D * transpose(R)", n, [&](std::size_t i)
+  {
+    std::size_t k = i & 1023;
+    Matrix33 M = R[k] * Dd[k] * transpose(R[k]);
+    AMLBench::doNotOptimize(M);
+  });
+  AMLBench::run("  congruence(R, DiagMatrix33)", n, [&](std::size_t i)
+  {
+    std::size_t k = i & 1023;
+    SymMatrix33 M = congruence(R[k], D[k]);
+    AMLBench::doNotOptimize(M);
+  });
+
+  return 0;
+}
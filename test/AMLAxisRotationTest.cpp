@@ -0,0 +1,118 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "AttitudeMathLib.h"
+
+#include <cmath>
+#include <numbers>
+
+using namespace AML;
+using Catch::Approx;
+
+namespace
+{
+	void checkEqual(const Matrix33& a, const Matrix33& b)
+	{
+		for (int i = 0; i < 3; ++i)
+			for (int j = 0; j < 3; ++j)
+				CHECK(a.data[i][j] == Approx(b.data[i][j]).margin(1e-14));
+	}
+
+	void checkEqual(const Vector3& a, const Vector3& b)
+	{
+		CHECK(a.x == Approx(b.x).margin(1e-14));
+		CHECK(a.y == Approx(b.y).margin(1e-14));
+		CHECK(a.z == Approx(b.z).margin(1e-14));
+	}
+
+	// Closed-form product of two different-axis rotations against the
+	// dense product, and chained through M from the left and right
+	template <int A, int B>
+	void checkCrossAxis(const AxisRotation<A>& a, const AxisRotation<B>& b, const Matrix33& M)
+	{
+		const Matrix33 dense = a.toMatrix33() * b.toMatrix33();
+		checkEqual(a * b, dense);
+		checkEqual(a * (b * M), dense * M);
+		checkEqual((M * a) * b, M * dense);
+		checkEqual((a * b) * M, dense * M);
+		checkEqual(M * (a * b), M * dense);
+	}
+}
+
+TEST_CASE("Compile-time constants", "[AxisRotation]")
+{
+	static constexpr Matrix33 I = Matrix33::identity();
+	static_assert(I.m11 == 1.0 && I.m22 == 1.0 && I.m33 == 1.0);
+	static_assert(I.m12 == 0.0 && I.m31 == 0.0);
+
+	static constexpr Vector3 z = Vector3::zAxis();
+	static_assert(z.x == 0.0 && z.z == 1.0);
+
+	// Quarter turn about z, evaluated at compile time
+	static constexpr RotationZ quarter(0.0, 1.0);
+	static constexpr Vector3 y = quarter * Vector3::xAxis();
+	static_assert(y.x == 0.0 && y.y == 1.0 && y.z == 0.0);
+
+	static constexpr RotationZ half = quarter * quarter;
+	static_assert(half.c == -1.0 && half.s == 0.0);
+	static_assert(RotationX::identity().c == 1.0);
+	static_assert(transpose(quarter).s == -1.0);
+
+	CHECK(Matrix33::identity().m22 == 1.0);
+	CHECK(Vector3::yAxis().y == 1.0);
+}
+
+TEST_CASE("AxisRotation matches dense products", "[AxisRotation]")
+{
+	double data[9] = {1.0, -2.0, 0.5, 3.0, 0.25, -1.0, 2.0, 4.0, -3.0};
+	Matrix33 M(data);
+	Vector3 v(0.3, -1.2, 2.5);
+
+	RotationX rx(0.3);
+	RotationY ry(-1.1);
+	RotationZ rz(2.4);
+
+	checkEqual(rx * v, rx.toMatrix33() * v);
+	checkEqual(ry * v, ry.toMatrix33() * v);
+	checkEqual(rz * v, rz.toMatrix33() * v);
+
+	checkEqual(rx * M, rx.toMatrix33() * M);
+	checkEqual(ry * M, ry.toMatrix33() * M);
+	checkEqual(rz * M, rz.toMatrix33() * M);
+
+	checkEqual(M * rx, M * rx.toMatrix33());
+	checkEqual(M * ry, M * ry.toMatrix33());
+	checkEqual(M * rz, M * rz.toMatrix33());
+
+	// All six ordered pairs of different axes
+	checkCrossAxis(rx, ry, M);
+	checkCrossAxis(rx, rz, M);
+	checkCrossAxis(ry, rx, M);
+	checkCrossAxis(ry, rz, M);
+	checkCrossAxis(rz, rx, M);
+	checkCrossAxis(rz, ry, M);
+}
+
+TEST_CASE("AxisRotation composition", "[AxisRotation]")
+{
+	// Same axis: angles add
+	RotationY a(0.4);
+	RotationY b(0.5);
+	CHECK((a * b).angle() == Approx(0.9));
+	CHECK((a * transpose(a)).angle() == Approx(0.0).margin(1e-15));
+
+	// Positive angle turns vectors counter-clockwise about the axis
+	checkEqual(RotationX(std::numbers::pi / 2.0) * Vector3::yAxis(), Vector3::zAxis());
+	checkEqual(RotationY(std::numbers::pi / 2.0) * Vector3::zAxis(), Vector3::xAxis());
+	checkEqual(RotationZ(std::numbers::pi / 2.0) * Vector3::xAxis(), Vector3::yAxis());
+
+	// Agrees with the quaternion convention
+	double h = 0.35;
+	checkEqual(RotationX(2.0 * h).toMatrix33(), quat2dcm(Quaternion(std::cos(h), std::sin(h), 0.0, 0.0)));
+
+	// 3-2-1 Euler sequence
+	double yaw = 0.7, pitch = -0.2, roll = 1.3;
+	Matrix33 R = RotationZ(yaw) * RotationY(pitch) * RotationX(roll);
+	Matrix33 dense = RotationZ(yaw).toMatrix33() * RotationY(pitch).toMatrix33() * RotationX(roll).toMatrix33();
+	checkEqual(R, dense);
+	CHECK(determinant(R) == Approx(1.0));
+}
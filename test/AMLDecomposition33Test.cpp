@@ -0,0 +1,318 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "AttitudeMathLib.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace AML;
+using Catch::Approx;
+
+namespace
+{
+	Matrix33 randomRotation(std::mt19937& gen)
+	{
+		std::normal_distribution<double> normal;
+		return quat2dcm(unit(Quaternion(normal(gen), normal(gen), normal(gen), normal(gen))));
+	}
+
+	double maxAbs(const Matrix33& m)
+	{
+		double r = 0.0;
+		for (int i = 0; i < 3; ++i)
+			for (int j = 0; j < 3; ++j)
+				r = std::max(r, std::fabs(m.data[i][j]));
+		return r;
+	}
+
+	// Orthonormal with determinant +1
+	void requireRotation(const Matrix33& R)
+	{
+		Matrix33 I = R * transpose(R);
+		for (int i = 0; i < 3; ++i)
+			for (int j = 0; j < 3; ++j)
+				REQUIRE(I.data[i][j] == Approx(i == j ? 1.0 : 0.0).margin(1e-14));
+		REQUIRE(determinant(R) == Approx(1.0).epsilon(1e-14));
+	}
+
+	// Checks the decomposition of S against known eigenvalues
+	void requireEigen(const SymMatrix33& S, const DiagMatrix33& expected)
+	{
+		SymmetricEigen33 e = symmetricEigen(S);
+		double scale = std::max(maxAbs(S.toMatrix33()), 1e-300);
+
+		requireRotation(e.vectors);
+		REQUIRE(e.values.d1 >= e.values.d2);
+		REQUIRE(e.values.d2 >= e.values.d3);
+
+		Matrix33 residual = S.toMatrix33() * e.vectors - e.vectors * e.values;
+		REQUIRE(maxAbs(residual) <= 1e-14 * scale);
+
+		std::vector<double> sorted = {expected.d1, expected.d2, expected.d3};
+		std::sort(sorted.begin(), sorted.end(), std::greater<double>());
+		for (int i = 0; i < 3; ++i)
+			REQUIRE(e.values.data[i] == Approx(sorted[i]).margin(1e-14 * scale));
+	}
+
+	// Checks the signed SVD of M against known singular values
+	// (already in order)
+	void requireSVD(const Matrix33& M, const DiagMatrix33& expected)
+	{
+		SVD33 d = svd(M);
+		double scale = std::max(maxAbs(M), 1e-300);
+
+		requireRotation(d.U);
+		requireRotation(d.V);
+		REQUIRE(d.S.d1 >= 0.0);
+		REQUIRE(d.S.d2 >= 0.0);
+		REQUIRE(d.S.d1 >= d.S.d2 - 1e-15 * scale);
+		REQUIRE(d.S.d2 >= std::fabs(d.S.d3) - 1e-15 * scale);
+
+		Matrix33 residual = d.U * d.S * transpose(d.V) - M;
+		REQUIRE(maxAbs(residual) <= 1e-14 * scale);
+		for (int i = 0; i < 3; ++i)
+			REQUIRE(d.S.data[i] == Approx(expected.data[i]).margin(1e-14 * scale));
+	}
+}
+
+TEST_CASE("Symmetric eigen-decomposition", "[Decomposition33]")
+{
+	std::mt19937 gen(1);
+	std::uniform_real_distribution<double> uniform(-10.0, 10.0);
+
+	SECTION("Random spectra")
+	{
+		for (int k = 0; k < 500; ++k)
+		{
+			DiagMatrix33 D(uniform(gen), uniform(gen), uniform(gen));
+			requireEigen(congruence(randomRotation(gen), D), D);
+		}
+	}
+
+	SECTION("Near-degenerate spectra")
+	{
+		const DiagMatrix33 spectra[] = {
+			DiagMatrix33(1.0, 1.0, 1.0),
+			DiagMatrix33(2.0, 2.0, 1.0),
+			DiagMatrix33(1.0, -3.0, -3.0),
+			DiagMatrix33(1.0, 1.0 + 1e-12, 1.0 + 2e-12),
+			DiagMatrix33(1.0, 1.0 + 1e-15, 0.5),
+			DiagMatrix33(1.0, 0.0, 0.0),
+			DiagMatrix33(1.0, 1e-9, -1e-9),
+			DiagMatrix33(0.0, 0.0, 0.0),
+			DiagMatrix33(1e200, 2e200, -1e200),
+			DiagMatrix33(1e-200, 3e-200, 2e-200),
+			DiagMatrix33(1e-310, 2e-311, 1e-311)};
+		for (const DiagMatrix33& D : spectra)
+		{
+			requireEigen(SymMatrix33(D), D);
+			for (int k = 0; k < 50; ++k)
+				requireEigen(congruence(randomRotation(gen), D), D);
+		}
+	}
+
+	SECTION("Graded matrices keep relative accuracy")
+	{
+		// The small eigenvalues of a graded matrix are found to full
+		// relative precision, far below rounding of the largest one.
+		// Reference: the decoupled 2x2 block [a b; b c], whose small
+		// eigenvalue det / large eigenvalue is accurate here.
+		const double a = 1e-10, b = 1e-16, c = 1e-20;
+		double big = 0.5 * (a + c) + std::sqrt(0.25 * (a - c) * (a - c) + b * b);
+		double small = (a * c - b * b) / big;
+
+		SymmetricEigen33 e = symmetricEigen(SymMatrix33(1.0, 0.0, 0.0, a, b, c));
+		REQUIRE(e.values.d1 == 1.0);
+		REQUIRE(e.values.d2 == Approx(big).epsilon(1e-14));
+		REQUIRE(e.values.d3 == Approx(small).epsilon(1e-14));
+	}
+}
+
+TEST_CASE("3x3 SVD", "[Decomposition33]")
+{
+	std::mt19937 gen(2);
+	std::uniform_real_distribution<double> uniform(0.0, 10.0);
+
+	SECTION("Random matrices")
+	{
+		for (int k = 0; k < 500; ++k)
+		{
+			std::vector<double> s = {uniform(gen), uniform(gen), uniform(gen)};
+			std::sort(s.begin(), s.end(), std::greater<double>());
+			DiagMatrix33 S(s[0], s[1], k % 2 ? s[2] : -s[2]);
+			requireSVD(randomRotation(gen) * S * transpose(randomRotation(gen)), S);
+		}
+	}
+
+	SECTION("Near-degenerate matrices")
+	{
+		const DiagMatrix33 spectra[] = {
+			DiagMatrix33(1.0, 1.0, 1.0),
+			DiagMatrix33(1.0, 1.0, -1.0),
+			DiagMatrix33(1.0, 1.0, 1.0 - 1e-12),
+			DiagMatrix33(2.0, 1.0 + 1e-14, 1.0),
+			DiagMatrix33(1.0, 1e-8, 0.0),
+			DiagMatrix33(1.0, 1e-8, -1e-12),
+			DiagMatrix33(1.0, 0.0, 0.0),
+			DiagMatrix33(1.0, 1.0, 0.0),
+			DiagMatrix33(0.0, 0.0, 0.0),
+			DiagMatrix33(3e150, 2e150, -1e150),
+			DiagMatrix33(3e-150, 2e-150, 1e-150),
+			DiagMatrix33(1e-310, 5e-311, 2e-311),
+			DiagMatrix33(1.7e308, 1e308, -1e307)};
+		for (const DiagMatrix33& S : spectra)
+		{
+			requireSVD(S.toMatrix33(), S);
+			for (int k = 0; k < 50; ++k)
+				requireSVD(randomRotation(gen) * S * transpose(randomRotation(gen)), S);
+		}
+	}
+
+	SECTION("Singular value sign follows the determinant")
+	{
+		Matrix33 reflection(1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, -2.0);
+		SVD33 d = svd(reflection);
+		REQUIRE(d.S.d1 == Approx(2.0));
+		REQUIRE(d.S.d2 == Approx(1.0));
+		REQUIRE(d.S.d3 == Approx(-1.0));
+	}
+}
+
+TEST_CASE("Nearest rotation and polar decomposition", "[Decomposition33]")
+{
+	std::mt19937 gen(3);
+	std::normal_distribution<double> normal;
+
+	// Wahba: B = sum w_i * b_i * r_i^T with b_i = R * r_i
+	Matrix33 R = randomRotation(gen);
+	Matrix33 B;
+	for (int k = 0; k < 20; ++k)
+	{
+		Vector3 r(normal(gen), normal(gen), normal(gen));
+		Vector3 b = R * r + 1e-3 * Vector3(normal(gen), normal(gen), normal(gen));
+		B = B + Matrix33(b.x * r.x, b.x * r.y, b.x * r.z,
+		                 b.y * r.x, b.y * r.y, b.y * r.z,
+		                 b.z * r.x, b.z * r.y, b.z * r.z);
+	}
+	Matrix33 estimate = nearestRotation(B);
+	requireRotation(estimate);
+	REQUIRE(maxAbs(estimate - R) < 1e-3);
+
+	// A reflected input still gives a proper rotation
+	Matrix33 flip = R * Matrix33(1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, -1.0);
+	requireRotation(nearestRotation(flip));
+
+	// M = R * P with P symmetric positive semi-definite
+	Matrix33 M = R * SymMatrix33(3.0, 0.2, -0.1, 2.0, 0.3, 1.0).toMatrix33();
+	Polar33 p = polar(M);
+	requireRotation(p.R);
+	REQUIRE(maxAbs(p.R - R) < 1e-14);
+	REQUIRE(maxAbs(p.R * p.P.toMatrix33() - M) < 1e-13);
+	SymmetricEigen33 e = symmetricEigen(p.P);
+	REQUIRE(e.values.d3 > 0.0);
+}
+
+TEST_CASE("Batched decompositions match single matrices", "[Decomposition33]")
+{
+	std::mt19937 gen(4);
+	std::normal_distribution<double> normal;
+
+	const std::size_t n = 1000;
+	Matrix33Batch M(n);
+	Matrix33Batch S(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		Matrix33 m(normal(gen), normal(gen), normal(gen),
+		           normal(gen), normal(gen), normal(gen),
+		           normal(gen), normal(gen), normal(gen));
+		// Mix in degenerate and scaled matrices
+		if (i % 7 == 0)
+			m = randomRotation(gen);
+		if (i % 11 == 0)
+			m = DiagMatrix33(1.0, 1.0, 0.0) * m;
+		if (i % 13 == 0)
+			m = m * 1e120;
+		M.set(i, m);
+		S.set(i, SymMatrix33(m + transpose(m)).toMatrix33());
+	}
+	REQUIRE(M.size() == n);
+
+	Matrix33Batch U, V, vectors;
+	Vector3Batch sigma, values;
+	svd(M, U, sigma, V);
+	symmetricEigen(S, values, vectors);
+	REQUIRE(U.size() == n);
+	REQUIRE(values.size() == n);
+
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		SVD33 d = svd(M.get(i));
+		double scale = maxAbs(M.get(i));
+		REQUIRE(maxAbs(U.get(i) - d.U) <= 1e-15);
+		REQUIRE(maxAbs(V.get(i) - d.V) <= 1e-15);
+		REQUIRE(norm(sigma.get(i) - d.S.toVector3()) <= 1e-15 * scale);
+
+		SymmetricEigen33 e = symmetricEigen(SymMatrix33(S.get(i)));
+		REQUIRE(maxAbs(vectors.get(i) - e.vectors) <= 1e-15);
+		REQUIRE(norm(values.get(i) - e.values.toVector3()) <= 1e-15 * scale);
+	}
+}
+
+TEST_CASE("Batched decompositions on strided views", "[Decomposition33]")
+{
+	std::mt19937 gen(5);
+	std::normal_distribution<double> normal;
+
+	// Records of 20 doubles: M column-major, a tag, S row-major,
+	// with the results in packed, strided and SoA buffers
+	const std::size_t n = 257;
+	std::vector<double> records(20 * n);
+	Matrix33Batch M(n), S(n);
+	ConstMatrix33View Mview(records.data(), n, MatrixLayout::ColumnMajor, 20);
+	ConstMatrix33View Sview(records.data() + 10, n, MatrixLayout::RowMajor, 20);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		Matrix33 m(normal(gen), normal(gen), normal(gen),
+		           normal(gen), normal(gen), normal(gen),
+		           normal(gen), normal(gen), normal(gen));
+		if (i % 11 == 0)
+			m = DiagMatrix33(1.0, 1.0, 0.0) * m;
+		M.set(i, m);
+		S.set(i, SymMatrix33(m + transpose(m)).toMatrix33());
+		Matrix33View(records.data() + 20 * i, 1, MatrixLayout::ColumnMajor).set(0, m);
+		Matrix33View(records.data() + 20 * i + 10, 1).set(0, S.get(i));
+		records[20 * i + 9] = -1.0;
+	}
+
+	std::vector<double> Ubuf(9 * n), Vbuf(9 * n), sigmaBuf(4 * n), valueBuf(3 * n), vectorBuf(9 * n);
+	Matrix33View Uview{std::span<double>(Ubuf)};
+	Matrix33View Vview(std::span<double>(Vbuf), MatrixLayout::ColumnMajor);
+	Vector3View sigmaView(sigmaBuf.data(), n, 4);
+	Vector3View valueView(valueBuf.data(), n, 1, std::ptrdiff_t(n));
+	Matrix33View vectorView{std::span<double>(vectorBuf)};
+	svd(Mview, Uview, sigmaView, Vview);
+	symmetricEigen(Sview, valueView, vectorView);
+
+	Matrix33Batch U, V, vectors;
+	Vector3Batch sigma, values;
+	svd(M, U, sigma, V);
+	symmetricEigen(S, values, vectors);
+
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		double scale = maxAbs(M.get(i));
+		REQUIRE(maxAbs(Uview.get(i) - U.get(i)) <= 1e-15);
+		REQUIRE(maxAbs(Vview.get(i) - V.get(i)) <= 1e-15);
+		REQUIRE(norm(sigmaView.get(i) - sigma.get(i)) <= 1e-15 * scale);
+		REQUIRE(maxAbs(vectorView.get(i) - vectors.get(i)) <= 1e-15);
+		REQUIRE(norm(valueView.get(i) - values.get(i)) <= 1e-15 * scale);
+		REQUIRE(records[20 * i + 9] == -1.0);
+	}
+
+	CHECK_THROWS_AS(svd(Mview, Uview.subview(0, n - 1), sigmaView, Vview), std::invalid_argument);
+	CHECK_THROWS_AS(symmetricEigen(Sview, valueView, vectorView.subview(1, n - 1)), std::invalid_argument);
+}
@@ -0,0 +1,102 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "AttitudeMathLib.h"
+
+#include <cmath>
+
+using namespace AML;
+using Catch::Approx;
+
+namespace
+{
+	void checkEqual(const Matrix33& a, const Matrix33& b)
+	{
+		for (int i = 0; i < 3; ++i)
+			for (int j = 0; j < 3; ++j)
+				CHECK(a.data[i][j] == Approx(b.data[i][j]).margin(1e-14));
+	}
+}
+
+TEST_CASE("DiagMatrix33 construction", "[DiagMatrix33]")
+{
+	static constexpr DiagMatrix33 I = DiagMatrix33::identity();
+	static_assert(I.d1 == 1.0 && I.d2 == 1.0 && I.d3 == 1.0);
+
+	DiagMatrix33 zero;
+	CHECK(zero.d1 == 0.0);
+	CHECK(zero.d2 == 0.0);
+	CHECK(zero.d3 == 0.0);
+
+	DiagMatrix33 s(2.0);
+	CHECK(s.data[0] == 2.0);
+	CHECK(s.data[2] == 2.0);
+
+	DiagMatrix33 v(Vector3(1.0, 2.0, 3.0));
+	CHECK(v.d1 == 1.0);
+	CHECK(v.d2 == 2.0);
+	CHECK(v.d3 == 3.0);
+
+	checkEqual(v.toMatrix33(), diag(Vector3(1.0, 2.0, 3.0)));
+	CHECK(v.toVector3().z == 3.0);
+}
+
+TEST_CASE("DiagMatrix33 products match dense", "[DiagMatrix33]")
+{
+	double data[9] = {1.0, -2.0, 0.5, 3.0, 0.25, -1.0, 2.0, 4.0, -3.0};
+	Matrix33 M(data);
+	DiagMatrix33 D(2.0, -0.5, 3.0);
+	Matrix33 Dd = D.toMatrix33();
+	Vector3 v(0.3, -1.2, 2.5);
+
+	Vector3 dv = D * v;
+	Vector3 ddv = Dd * v;
+	CHECK(dv.x == Approx(ddv.x));
+	CHECK(dv.y == Approx(ddv.y));
+	CHECK(dv.z == Approx(ddv.z));
+
+	checkEqual(D * M, Dd * M);
+	checkEqual(M * D, M * Dd);
+	checkEqual(D + M, Dd + M);
+	checkEqual(M + D, M + Dd);
+
+	DiagMatrix33 E(1.0, 4.0, -2.0);
+	checkEqual((D * E).toMatrix33(), Dd * E.toMatrix33());
+	checkEqual((D + E).toMatrix33(), Dd + E.toMatrix33());
+	checkEqual((D - E).toMatrix33(), Dd - E.toMatrix33());
+	checkEqual((-D).toMatrix33(), -Dd);
+	checkEqual((2.0 * D).toMatrix33(), Dd * 2.0);
+	checkEqual((D / 2.0).toMatrix33(), Dd / 2.0);
+}
+
+TEST_CASE("DiagMatrix33 inverse and determinant", "[DiagMatrix33]")
+{
+	DiagMatrix33 D(2.0, -0.5, 4.0);
+	CHECK(determinant(D) == Approx(-4.0));
+	CHECK(determinant(D) == Approx(determinant(D.toMatrix33())));
+
+	DiagMatrix33 Di = inverse(D);
+	CHECK(Di.d1 == Approx(0.5));
+	CHECK(Di.d2 == Approx(-2.0));
+	CHECK(Di.d3 == Approx(0.25));
+	checkEqual((D * Di).toMatrix33(), Matrix33::identity());
+	checkEqual(transpose(D).toMatrix33(), D.toMatrix33());
+
+	DiagMatrix33 singular(1.0, 0.0, 2.0);
+	CHECK(std::isnan(inverse(singular).d1));
+}
+
+TEST_CASE("Dense diag and transpose", "[DiagMatrix33]")
+{
+	double data[9] = {1.0, -2.0, 0.5, 3.0, 0.25, -1.0, 2.0, 4.0, -3.0};
+	Matrix33 M(data);
+
+	Vector3 d = diag(M);
+	CHECK(d.x == 1.0);
+	CHECK(d.y == 0.25);
+	CHECK(d.z == -3.0);
+
+	Matrix33 Mt = transpose(M);
+	for (int i = 0; i < 3; ++i)
+		for (int j = 0; j < 3; ++j)
+			CHECK(Mt.data[i][j] == M.data[j][i]);
+}
@@ -0,0 +1,186 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "AttitudeMathLib.h"
+
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace AML;
+using Catch::Approx;
+
+namespace
+{
+	Matrix33 randomRotation(std::mt19937& gen)
+	{
+		std::normal_distribution<double> normal;
+		return quat2dcm(unit(Quaternion(normal(gen), normal(gen), normal(gen), normal(gen))));
+	}
+
+	double maxDifference(const Matrix33& a, const Matrix33& b)
+	{
+		double r = 0.0;
+		for (int i = 0; i < 3; ++i)
+			for (int j = 0; j < 3; ++j)
+				r = std::max(r, std::fabs(a.data[i][j] - b.data[i][j]));
+		return r;
+	}
+}
+
+TEST_CASE("Frame graph composes transforms", "[FrameGraph]")
+{
+	std::mt19937 gen(1);
+	Matrix33 Rbody = randomRotation(gen);
+	Matrix33 Rimu = randomRotation(gen);
+	Matrix33 Rcamera = randomRotation(gen);
+	Matrix33 Rmount = randomRotation(gen);
+
+	//   inertial - body - imu
+	//                   \ camera - mount
+	//   map (separate tree)
+	FrameGraph graph;
+	FrameGraph::FrameId inertial = graph.addFrame("inertial");
+	FrameGraph::FrameId body = graph.addFrame("body", inertial, Rbody);
+	FrameGraph::FrameId imu = graph.addFrame("imu", body, Rimu);
+	FrameGraph::FrameId camera = graph.addFrame("camera", body, Rcamera);
+	FrameGraph::FrameId mount = graph.addFrame("mount", camera, Rmount);
+	FrameGraph::FrameId map = graph.addFrame("map");
+
+	REQUIRE(graph.size() == 6);
+	REQUIRE(graph.contains("camera"));
+	REQUIRE_FALSE(graph.contains("lidar"));
+	REQUIRE(graph.id("imu") == imu);
+	REQUIRE(graph.name(mount) == "mount");
+	REQUIRE(graph.parent(mount) == camera);
+	REQUIRE(graph.parent(inertial) == inertial);
+	REQUIRE(graph.version(imu) == 0);
+
+	// Up, down and across the tree
+	REQUIRE(maxDifference(graph.transform(mount, inertial), Rbody * Rcamera * Rmount) < 1e-15);
+	REQUIRE(maxDifference(graph.toRoot(imu), Rbody * Rimu) < 1e-15);
+	REQUIRE(maxDifference(graph.transform(inertial, imu), transpose(Rbody * Rimu)) < 1e-15);
+	REQUIRE(maxDifference(graph.transform(mount, imu), transpose(Rimu) * Rcamera * Rmount) < 1e-14);
+	REQUIRE(maxDifference(graph.transform("imu", "camera"), transpose(Rcamera) * Rimu) < 1e-14);
+	REQUIRE(maxDifference(graph.transform(imu, mount) * graph.transform(mount, imu), Matrix33::identity()) < 1e-14);
+	REQUIRE(maxDifference(graph.transform(camera, camera), Matrix33::identity()) == 0.0);
+
+	// A vector in imu coordinates seen from the camera
+	Vector3 v(0.3, -1.2, 2.0);
+	Vector3 expected = transpose(Rcamera) * (Rimu * v);
+	Vector3 actual = graph.transform(imu, camera) * v;
+	REQUIRE(actual.x == Approx(expected.x));
+	REQUIRE(actual.y == Approx(expected.y));
+	REQUIRE(actual.z == Approx(expected.z));
+
+	// Batched queries
+	FrameGraph::FrameId from[] = {mount, imu, body};
+	FrameGraph::FrameId to[] = {inertial, camera, body};
+	Matrix33 out[3];
+	graph.transforms(from, to, out, 3);
+	for (int i = 0; i < 3; ++i)
+		REQUIRE(maxDifference(out[i], graph.transform(from[i], to[i])) == 0.0);
+
+	REQUIRE_THROWS_AS(graph.transform(imu, map), std::invalid_argument);
+	REQUIRE_THROWS_AS(graph.transform(imu, 42), std::out_of_range);
+	REQUIRE_THROWS_AS(graph.id("lidar"), std::invalid_argument);
+	REQUIRE_THROWS_AS(graph.addFrame("imu", body, Rimu), std::invalid_argument);
+	REQUIRE_THROWS_AS(graph.addFrame("lidar", 42, Rimu), std::out_of_range);
+	REQUIRE(graph.size() == 6);
+}
+
+TEST_CASE("Frame graph edge updates", "[FrameGraph]")
+{
+	std::mt19937 gen(2);
+	FrameGraph graph;
+	FrameGraph::FrameId inertial = graph.addFrame("inertial");
+	FrameGraph::FrameId body = graph.addFrame("body", inertial, randomRotation(gen));
+	FrameGraph::FrameId imu = graph.addFrame("imu", body, randomRotation(gen));
+	FrameGraph::FrameId camera = graph.addFrame("camera", body, randomRotation(gen));
+
+	// Warm the caches, then update edges between queries
+	graph.transform(imu, camera);
+	for (int k = 1; k <= 20; ++k)
+	{
+		Matrix33 Rbody = randomRotation(gen);
+		Matrix33 Rimu = randomRotation(gen);
+		graph.setRotation(body, Rbody);
+		if (k % 3 == 0)
+			graph.setRotation(imu, Rimu);
+		REQUIRE(graph.version(body) == std::uint64_t(k));
+		REQUIRE(maxDifference(graph.rotation(body), Rbody) == 0.0);
+
+		Matrix33 Rimu_ = graph.rotation(imu);
+		Matrix33 Rcamera = graph.rotation(camera);
+		REQUIRE(maxDifference(graph.transform(imu, inertial), Rbody * Rimu_) < 1e-15);
+		REQUIRE(maxDifference(graph.transform(camera, imu), transpose(Rbody * Rimu_) * (Rbody * Rcamera)) < 1e-14);
+	}
+	REQUIRE(graph.version(imu) == 6);
+	REQUIRE(graph.version(camera) == 0);
+
+	// Batched updates apply all or nothing
+	Matrix33 Rb = randomRotation(gen), Rc = randomRotation(gen);
+	FrameGraph::FrameId frames[] = {body, camera};
+	Matrix33 R[] = {Rb, Rc};
+	graph.setRotations(frames, R, 2);
+	REQUIRE(maxDifference(graph.transform(camera, inertial), Rb * Rc) < 1e-15);
+
+	FrameGraph::FrameId bad[] = {camera, 42};
+	REQUIRE_THROWS_AS(graph.setRotations(bad, R, 2), std::out_of_range);
+	REQUIRE(graph.version(camera) == 1);
+	FrameGraph::FrameId root[] = {camera, inertial};
+	REQUIRE_THROWS_AS(graph.setRotations(root, R, 2), std::invalid_argument);
+	REQUIRE(graph.version(camera) == 1);
+
+	Matrix33 nan = Matrix33::identity();
+	nan.m22 = NAN;
+	REQUIRE_THROWS_AS(graph.setRotation(imu, nan), std::invalid_argument);
+	REQUIRE_THROWS_AS(graph.addFrame("lidar", body, nan), std::invalid_argument);
+}
+
+TEST_CASE("Frame graph concurrent readers", "[FrameGraph]")
+{
+	std::mt19937 gen(3);
+	Matrix33 Rimu = randomRotation(gen);
+	Matrix33 Rcamera = randomRotation(gen);
+	Matrix33 states[2] = {randomRotation(gen), randomRotation(gen)};
+
+	FrameGraph graph;
+	FrameGraph::FrameId inertial = graph.addFrame("inertial");
+	FrameGraph::FrameId body = graph.addFrame("body", inertial, states[0]);
+	FrameGraph::FrameId imu = graph.addFrame("imu", body, Rimu);
+	FrameGraph::FrameId camera = graph.addFrame("camera", body, Rcamera);
+
+	// Whichever body rotation a reader sees, each answer is one of
+	// the two consistent transforms
+	Matrix33 expected[2] = {states[0] * Rimu, states[1] * Rimu};
+	Matrix33 across = transpose(Rcamera) * Rimu;
+
+	std::atomic<bool> done(false);
+	std::atomic<int> failures(0);
+	std::vector<std::thread> readers;
+	for (int t = 0; t < 4; ++t)
+		readers.emplace_back([&]()
+		{
+			while (!done.load())
+			{
+				Matrix33 a = graph.transform(imu, inertial);
+				if (maxDifference(a, expected[0]) > 1e-15 && maxDifference(a, expected[1]) > 1e-15)
+					++failures;
+				if (maxDifference(graph.transform(imu, camera), across) > 1e-14)
+					++failures;
+			}
+		});
+
+	for (int k = 1; k <= 20000; ++k)
+		graph.setRotation(body, states[k % 2]);
+	done = true;
+	for (std::thread& th : readers)
+		th.join();
+
+	REQUIRE(failures.load() == 0);
+	REQUIRE(graph.version(body) == 20000);
+	REQUIRE(maxDifference(graph.transform(imu, inertial), expected[0]) < 1e-15);
+}
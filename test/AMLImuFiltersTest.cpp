@@ -0,0 +1,257 @@
+#include <catch2/catch_test_macros.hpp>
+#include "AttitudeMathLib.h"
+
+#include <cmath>
+#include <numbers>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace AML;
+
+namespace
+{
+	struct RecordedSample
+	{
+		Vector3 gyro, accel, mag;
+		Quaternion truth;
+	};
+
+	// Loads test/data/imu_recording.csv (see the header of that file)
+	std::vector<RecordedSample> loadRecording()
+	{
+		std::vector<RecordedSample> samples;
+		std::ifstream in(std::string(AML_TEST_DATA_DIR) + "/imu_recording.csv");
+		std::string line;
+		while (std::getline(in, line))
+		{
+			if (line.empty() || line[0] == '#')
+				continue;
+			std::stringstream ss(line);
+			double v[14];
+			char comma;
+			for (int i = 0; i < 14; ++i)
+			{
+				ss >> v[i];
+				if (i < 13)
+					ss >> comma;
+			}
+			RecordedSample s;
+			s.gyro = Vector3(v[1], v[2], v[3]);
+			s.accel = Vector3(v[4], v[5], v[6]);
+			s.mag = Vector3(v[7], v[8], v[9]);
+			s.truth = Quaternion(v[10], v[11], v[12], v[13]);
+			samples.push_back(s);
+		}
+		return samples;
+	}
+
+	// Angle between two attitudes in degrees
+	double angleDeg(const Quaternion& a, const Quaternion& b)
+	{
+		double d = std::fabs(dot(a, b));
+		return 2.0 * std::acos(d > 1.0 ? 1.0 : d) * 180.0 / std::numbers::pi;
+	}
+
+	// Replays the recording into every sensor of the batch
+	template <typename Filter>
+	void replay(Filter& filter, const std::vector<RecordedSample>& samples, bool useMag)
+	{
+		ImuBatch imu(filter.size());
+		for (const RecordedSample& s : samples)
+		{
+			for (std::size_t i = 0; i < filter.size(); ++i)
+				imu.set(i, s.gyro, s.accel, s.mag);
+			filter.update(imu, 0.02, useMag);
+		}
+	}
+
+	// The same replay from interleaved gyro/accel/mag records
+	// through strided views; without the magnetometer no mag view
+	// is passed
+	template <typename Filter>
+	void replayViews(Filter& filter, const std::vector<RecordedSample>& samples, bool useMag)
+	{
+		std::vector<double> records(9 * filter.size());
+		ConstVector3View gyro(records.data(), filter.size(), 9);
+		ConstVector3View accel(records.data() + 3, filter.size(), 9);
+		ConstVector3View mag = useMag ? ConstVector3View(records.data() + 6, filter.size(), 9) : ConstVector3View();
+		for (const RecordedSample& s : samples)
+		{
+			for (std::size_t i = 0; i < filter.size(); ++i)
+			{
+				Vector3View(records.data() + 9 * i, 3).set(0, s.gyro);
+				Vector3View(records.data() + 9 * i, 3).set(1, s.accel);
+				Vector3View(records.data() + 9 * i, 3).set(2, s.mag);
+			}
+			filter.update(gyro, accel, mag, 0.02, useMag);
+		}
+	}
+
+	template <typename Filter>
+	void checkViewReplay(Filter&& batch, Filter&& viewed)
+	{
+		const std::vector<RecordedSample> samples = loadRecording();
+		for (bool useMag : {true, false})
+		{
+			Filter a = batch, b = viewed;
+			replay(a, samples, useMag);
+			replayViews(b, samples, useMag);
+			for (std::size_t i = 0; i < a.size(); ++i)
+			{
+				Quaternion d = a.attitude(i) - b.attitude(i);
+				CHECK(std::fabs(d.q0) + std::fabs(d.q1) + std::fabs(d.q2) + std::fabs(d.q3) < 1e-12);
+			}
+		}
+	}
+
+	template <typename Filter>
+	void checkReplay(Filter&& single, Filter&& batch, Filter&& again, double maxErrorDeg)
+	{
+		const std::vector<RecordedSample> samples = loadRecording();
+		REQUIRE(samples.size() == 500);
+
+		replay(single, samples, true);
+		replay(batch, samples, true);
+		replay(again, samples, true);
+
+		// Converges to the recorded truth from a 30 degree error
+		const Quaternion& truth = samples.back().truth;
+		CHECK(angleDeg(single.attitude(0), truth) < maxErrorDeg);
+
+		// Every lane of the batch matches the single-sensor run and a
+		// second replay reproduces the batch exactly.
+		for (std::size_t i = 0; i < batch.size(); ++i)
+		{
+			CHECK(angleDeg(batch.attitude(i), single.attitude(0)) < 1e-6);
+			Quaternion a = batch.attitude(i);
+			Quaternion b = again.attitude(i);
+			CHECK(a.q0 == b.q0);
+			CHECK(a.q1 == b.q1);
+			CHECK(a.q2 == b.q2);
+			CHECK(a.q3 == b.q3);
+		}
+	}
+
+	// Tilt error: angle between estimated and true "up" in the body frame
+	double tiltErrorDeg(const Quaternion& estimate, const Quaternion& truth)
+	{
+		Vector3 a = transpose(quat2dcm(estimate)) * Vector3(0.0, 0.0, 1.0);
+		Vector3 b = transpose(quat2dcm(truth)) * Vector3(0.0, 0.0, 1.0);
+		double c = dot(a, b) / (norm(a) * norm(b));
+		return std::acos(c > 1.0 ? 1.0 : c) * 180.0 / std::numbers::pi;
+	}
+}
+
+TEST_CASE("ImuBatch layout", "[ImuFilters]")
+{
+	ImuBatch imu(3);
+	CHECK(imu.size() == 3);
+	imu.set(1, Vector3(1.0, 2.0, 3.0), Vector3(4.0, 5.0, 6.0), Vector3(7.0, 8.0, 9.0));
+	CHECK(imu.gy[1] == 2.0);
+	CHECK(imu.az[1] == 6.0);
+	CHECK(imu.mx[1] == 7.0);
+	imu.resize(5);
+	CHECK(imu.mz.size() == 5);
+
+	MahonyFilterBatch f(4);
+	CHECK(f.attitude(2).q0 == 1.0);
+	f.setAttitude(2, Quaternion(2.0, 0.0, 0.0, 0.0));
+	CHECK(f.attitude(2).q0 == 1.0);
+
+	// One IMU sample per sensor, no more and no fewer
+	CHECK_THROWS_AS(f.update(imu, 0.01), std::invalid_argument);
+	CHECK_THROWS_AS(MadgwickFilterBatch(6).update(imu, 0.01), std::invalid_argument);
+	CHECK_THROWS_AS(ComplementaryFilterBatch(4).update(imu, 0.01), std::invalid_argument);
+	imu.resize(4);
+	f.update(imu, 0.01);
+	CHECK(f.attitude(2).q0 == 1.0);
+}
+
+TEST_CASE("Mahony replay", "[ImuFilters]")
+{
+	checkReplay(MahonyFilterBatch(1, 1.0, 0.1), MahonyFilterBatch(13, 1.0, 0.1),
+	            MahonyFilterBatch(13, 1.0, 0.1), 2.0);
+
+	// Started at the truth, the integral term picks up the recorded
+	// gyro bias (0.004, -0.003, 0.002) with opposite sign
+	const std::vector<RecordedSample> samples = loadRecording();
+	MahonyFilterBatch f(1, 1.0, 0.3);
+	f.setAttitude(0, samples.front().truth);
+	replay(f, samples, true);
+	Vector3 bias = f.integralError(0);
+	CHECK(bias.x < -0.002);
+	CHECK(bias.y > 0.001);
+	CHECK(bias.z < 0.0);
+}
+
+TEST_CASE("Madgwick replay", "[ImuFilters]")
+{
+	checkReplay(MadgwickFilterBatch(1, 0.2), MadgwickFilterBatch(13, 0.2),
+	            MadgwickFilterBatch(13, 0.2), 2.0);
+}
+
+TEST_CASE("Complementary replay", "[ImuFilters]")
+{
+	checkReplay(ComplementaryFilterBatch(1, 0.02, 0.02), ComplementaryFilterBatch(13, 0.02, 0.02),
+	            ComplementaryFilterBatch(13, 0.02, 0.02), 2.0);
+}
+
+TEST_CASE("Strided view updates match ImuBatch updates", "[ImuFilters]")
+{
+	checkViewReplay(MahonyFilterBatch(5, 1.0, 0.1), MahonyFilterBatch(5, 1.0, 0.1));
+	checkViewReplay(MadgwickFilterBatch(5, 0.2), MadgwickFilterBatch(5, 0.2));
+	checkViewReplay(ComplementaryFilterBatch(5, 0.02, 0.02), ComplementaryFilterBatch(5, 0.02, 0.02));
+
+	// Every view needs one sample per sensor, except an unused mag
+	std::vector<double> buffer(9 * 4);
+	ConstVector3View four(buffer.data(), 4, 9);
+	ConstVector3View three(buffer.data(), 3, 9);
+	MahonyFilterBatch f(4);
+	CHECK_THROWS_AS(f.update(three, four, four, 0.01), std::invalid_argument);
+	CHECK_THROWS_AS(f.update(four, four, three, 0.01), std::invalid_argument);
+	CHECK_THROWS_AS(MadgwickFilterBatch(4).update(four, three, four, 0.01), std::invalid_argument);
+	CHECK_THROWS_AS(ComplementaryFilterBatch(4).update(four, four, ConstVector3View(), 0.01), std::invalid_argument);
+	f.update(four, four, ConstVector3View(), 0.01, false);
+	CHECK(f.attitude(3).q0 == 1.0);
+}
+
+TEST_CASE("Accelerometer-only updates correct tilt", "[ImuFilters]")
+{
+	const std::vector<RecordedSample> samples = loadRecording();
+	const Quaternion& truth = samples.back().truth;
+
+	MahonyFilterBatch mahony(1, 1.0);
+	MadgwickFilterBatch madgwick(1, 0.2);
+	ComplementaryFilterBatch complementary(1, 0.02, 0.02);
+	replay(mahony, samples, false);
+	replay(madgwick, samples, false);
+	replay(complementary, samples, false);
+
+	CHECK(tiltErrorDeg(mahony.attitude(0), truth) < 2.0);
+	CHECK(tiltErrorDeg(madgwick.attitude(0), truth) < 2.0);
+	CHECK(tiltErrorDeg(complementary.attitude(0), truth) < 2.0);
+}
+
+TEST_CASE("Zero accelerometer falls back to gyro integration", "[ImuFilters]")
+{
+	// Pure rotation about z at 1 rad/s for 1 s with no reference data
+	ImuBatch imu(2);
+	imu.set(0, Vector3(0.0, 0.0, 1.0), Vector3(0.0), Vector3(0.0));
+	imu.set(1, Vector3(0.0, 0.0, 1.0), Vector3(0.0), Vector3(0.0));
+	MahonyFilterBatch mahony(2);
+	MadgwickFilterBatch madgwick(2);
+	ComplementaryFilterBatch complementary(2);
+	for (int k = 0; k < 1000; ++k)
+	{
+		mahony.update(imu, 0.001);
+		madgwick.update(imu, 0.001);
+		complementary.update(imu, 0.001);
+	}
+	Quaternion expected(std::cos(0.5), 0.0, 0.0, std::sin(0.5));
+	CHECK(angleDeg(mahony.attitude(1), expected) < 0.01);
+	CHECK(angleDeg(madgwick.attitude(1), expected) < 0.01);
+	CHECK(angleDeg(complementary.attitude(1), expected) < 0.01);
+}
@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "AttitudeMathLib.h"
+
+using namespace AML;
+using Catch::Approx;
+
+TEST_CASE("MatrixN Constructors", "[MatrixN]")
+{
+	// Case 1
+	Matrix36 m;
+	for (std::size_t i = 0; i < 3; ++i)
+		for (std::size_t j = 0; j < 6; ++j)
+			CHECK(m(i, j) == 0.0);
+	// Case 2
+	Matrix36 s(2.0);
+	CHECK(s(2, 5) == 2.0);
+	// Case 3
+	double data[6] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+	MatrixN<2, 3> f(data);
+	CHECK(f(0, 0) == 1.0);
+	CHECK(f(0, 2) == 3.0);
+	CHECK(f(1, 0) == 4.0);
+	// Case 4
+	Matrix66 I = Matrix66::identity();
+	CHECK(I(3, 3) == 1.0);
+	CHECK(I(3, 4) == 0.0);
+	// Case 5
+	double m33[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+	MatrixN<3, 3> fromM{Matrix33(m33)};
+	CHECK(fromM(1, 2) == 6.0);
+	MatrixN<3, 1> fromV(Vector3(1.0, 2.0, 3.0));
+	CHECK(fromV(2, 0) == 3.0);
+	CHECK(fromV.toVector3().y == 2.0);
+	CHECK(fromM.toMatrix33().m32 == 8.0);
+}
+
+TEST_CASE("MatrixN Products", "[MatrixN]")
+{
+	// Case 1: (2x3) * (3x2)
+	double a[6] = {1, 2, 3, 4, 5, 6};
+	double b[6] = {7, 8, 9, 10, 11, 12};
+	MatrixN<2, 2> c = MatrixN<2, 3>(a) * MatrixN<3, 2>(b);
+	CHECK(c(0, 0) == 58.0);
+	CHECK(c(0, 1) == 64.0);
+	CHECK(c(1, 0) == 139.0);
+	CHECK(c(1, 1) == 154.0);
+	// Case 2: transpose
+	MatrixN<3, 2> t = transpose(MatrixN<2, 3>(a));
+	CHECK(t(2, 0) == 3.0);
+	CHECK(t(0, 1) == 4.0);
+	// Case 3: (R x 3) * Vector3
+	Vector6 y = Matrix63(1.0) * Vector3(1.0, 2.0, 3.0);
+	CHECK(y(5, 0) == 6.0);
+	// Case 4: element-wise and scalar
+	Matrix66 I = Matrix66::identity();
+	Matrix66 d = 2.0 * I + I - I / 2.0;
+	CHECK(d(4, 4) == 2.5);
+	CHECK((-d)(4, 4) == -2.5);
+}
+
+TEST_CASE("MatrixN Blocks", "[MatrixN]")
+{
+	double r[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+	Matrix33 R(r);
+
+	Matrix66 P;
+	P.setBlock33<3, 3>(R);
+	P.setVector3<0, 1>(Vector3(10.0, 11.0, 12.0));
+	CHECK(P(3, 3) == 1.0);
+	CHECK(P(5, 5) == 9.0);
+	CHECK(P(4, 3) == 4.0);
+	CHECK(P(2, 1) == 12.0);
+
+	Matrix33 B = P.block33<3, 3>();
+	CHECK(B.m23 == 6.0);
+	Vector3 v = P.vector3<0, 1>();
+	CHECK(v.x == 10.0);
+	CHECK(v.z == 12.0);
+
+	MatrixN<2, 2> sub = P.block<4, 4, 2, 2>();
+	CHECK(sub(0, 0) == 5.0);
+	CHECK(sub(1, 1) == 9.0);
+	MatrixN<2, 1> column = P.block<3, 4, 2, 1>();
+	CHECK(column(0, 0) == 2.0);
+	CHECK(column(1, 0) == 5.0);
+
+	// Blocks are copies
+	sub(0, 0) = -1.0;
+	CHECK(P(4, 4) == 5.0);
+	Matrix36 H;
+	H.setBlock<0, 3>(MatrixN<2, 2>(1.0));
+	CHECK(H(1, 4) == 1.0);
+}
+
+TEST_CASE("MatrixN Cholesky", "[MatrixN]")
+{
+	// Case 1: symmetric positive definite A = M * M^T + I
+	Matrix66 M;
+	for (std::size_t i = 0; i < 6; ++i)
+		for (std::size_t j = 0; j < 6; ++j)
+			M(i, j) = 1.0 / (1.0 + i + j);
+	Matrix66 A = M * transpose(M) + Matrix66::identity();
+
+	Matrix66 L;
+	REQUIRE(cholesky(A, L));
+	CHECK(L(0, 1) == 0.0);
+	Matrix66 LLt = L * transpose(L);
+	for (std::size_t i = 0; i < 6; ++i)
+		for (std::size_t j = 0; j < 6; ++j)
+			CHECK(LLt(i, j) == Approx(A(i, j)).margin(1e-12));
+
+	// Case 2: solve A x = b
+	Vector6 x;
+	for (std::size_t i = 0; i < 6; ++i)
+		x(i, 0) = double(i) - 2.5;
+	Vector6 b = A * x;
+	Vector6 xs = choleskySolve(L, b);
+	for (std::size_t i = 0; i < 6; ++i)
+		CHECK(xs(i, 0) == Approx(x(i, 0)).margin(1e-10));
+
+	// Case 3: indefinite matrix is rejected
+	Matrix66 N = -Matrix66::identity();
+	CHECK_FALSE(cholesky(N, L));
+}
@@ -0,0 +1,339 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "AttitudeMathLib.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace AML;
+using Catch::Approx;
+
+namespace
+{
+	std::vector<Quaternion> randomAttitudes(std::size_t n, unsigned seed)
+	{
+		std::mt19937 gen(seed);
+		std::normal_distribution<double> normal;
+		std::vector<Quaternion> q(n);
+		for (Quaternion& x : q)
+			x = Quaternion(normal(gen), normal(gen), normal(gen), normal(gen));
+		return q;
+	}
+
+	// Rotation angle between two attitudes from the rotation matrices
+	double matrixAngle(const Quaternion& a, const Quaternion& b)
+	{
+		Matrix33 d = transpose(quat2dcm(unit(a))) * quat2dcm(unit(b));
+		double c = 0.5 * (d.m11 + d.m22 + d.m33 - 1.0);
+		return std::acos(std::max(-1.0, std::min(1.0, c)));
+	}
+
+	std::vector<OrientationIndex::Match> bruteForce(const std::vector<Quaternion>& library, const Quaternion& q)
+	{
+		std::vector<OrientationIndex::Match> all;
+		for (std::size_t i = 0; i < library.size(); ++i)
+			all.push_back(OrientationIndex::Match{i, matrixAngle(q, library[i])});
+		std::sort(all.begin(), all.end(), [](const OrientationIndex::Match& a, const OrientationIndex::Match& b)
+		{
+			return a.angle < b.angle;
+		});
+		return all;
+	}
+
+	// Index file whose tree is a chain: every internal node peels
+	// off one vantage point (no inside subtree) and the outside
+	// subtree holds the rest. Valid except for its depth.
+	std::string chainFile(std::uint32_t n)
+	{
+		std::string bytes("AMLOIDX\0", 8);
+		auto put = [&](std::uint64_t v, int size)
+		{
+			for (int j = 0; j < size; ++j)
+				bytes.push_back(char((v >> (8 * j)) & 0xff));
+		};
+		auto putF64 = [&](double v) { put(std::bit_cast<std::uint64_t>(v), 8); };
+		put(1, 4);
+		put(1, 4);
+		put(n, 8);
+		put(n, 8);
+		for (std::uint32_t i = 0; i < n; ++i)
+		{
+			putF64(1.0);
+			putF64(0.0);
+			putF64(0.0);
+			putF64(0.0);
+		}
+		for (std::uint32_t i = 0; i < n; ++i)
+			put(i, 4);
+		for (std::uint32_t i = 0; i < n; ++i)
+		{
+			bool leaf = i + 1 == n;
+			put(i, 4);
+			put(n, 4);
+			put(std::uint32_t(-1), 4);
+			put(leaf ? std::uint32_t(-1) : i + 1, 4);
+			putF64(-1.0);
+			putF64(0.0);
+			putF64(0.0);
+		}
+		return bytes;
+	}
+
+	// Same matches (angles compared with tolerance, since the index
+	// and the matrix angle round differently)
+	void requireSameMatches(const std::vector<OrientationIndex::Match>& a, const std::vector<OrientationIndex::Match>& b)
+	{
+		REQUIRE(a.size() == b.size());
+		for (std::size_t i = 0; i < a.size(); ++i)
+		{
+			REQUIRE(a[i].index == b[i].index);
+			REQUIRE(a[i].angle == Approx(b[i].angle).margin(1e-7));
+		}
+	}
+}
+
+TEST_CASE("OrientationIndex nearest matches brute force", "[OrientationIndex]")
+{
+	std::vector<Quaternion> library = randomAttitudes(3000, 1);
+	std::vector<Quaternion> queries = randomAttitudes(50, 2);
+
+	for (std::size_t leafSize : {std::size_t(1), std::size_t(16)})
+	{
+		OrientationIndex index(library, leafSize);
+		REQUIRE(index.size() == library.size());
+		REQUIRE(index.leafSize() == leafSize);
+
+		for (const Quaternion& q : queries)
+		{
+			std::vector<OrientationIndex::Match> expected = bruteForce(library, q);
+			for (std::size_t k : {std::size_t(1), std::size_t(7)})
+			{
+				std::vector<OrientationIndex::Match> found = index.nearest(q, k);
+				REQUIRE(found.size() == k);
+				for (std::size_t i = 0; i < k; ++i)
+				{
+					REQUIRE(found[i].index == expected[i].index);
+					REQUIRE(found[i].angle == Approx(expected[i].angle).margin(1e-7));
+				}
+			}
+		}
+	}
+
+	// Library entries are found at distance 0, through q or -q
+	OrientationIndex index(library);
+	for (std::size_t i = 0; i < library.size(); i += 97)
+	{
+		std::vector<OrientationIndex::Match> self = index.nearest(library[i], 1);
+		REQUIRE(self[0].index == i);
+		REQUIRE(self[0].angle == Approx(0.0).margin(1e-7));
+
+		std::vector<OrientationIndex::Match> flipped = index.nearest(-2.0 * library[i], 1);
+		REQUIRE(flipped[0].index == i);
+		REQUIRE(flipped[0].angle == Approx(0.0).margin(1e-7));
+	}
+
+	// Small angles keep full precision
+	Quaternion base = unit(library[5]);
+	Quaternion near = base * Quaternion(std::cos(0.5e-9), std::sin(0.5e-9), 0.0, 0.0);
+	REQUIRE(index.nearest(near, 1)[0].angle == Approx(1e-9).epsilon(1e-6));
+
+	// k larger than the library returns everything
+	REQUIRE(index.nearest(queries[0], 5000).size() == library.size());
+}
+
+TEST_CASE("OrientationIndex radius queries match brute force", "[OrientationIndex]")
+{
+	std::vector<Quaternion> library = randomAttitudes(3000, 3);
+	std::vector<Quaternion> queries = randomAttitudes(30, 4);
+	OrientationIndex index(library);
+
+	for (double radius : {0.0, 0.2, 0.6, 1.5, 3.0})
+	{
+		for (const Quaternion& q : queries)
+		{
+			std::vector<OrientationIndex::Match> expected = bruteForce(library, q);
+			expected.erase(std::remove_if(expected.begin(), expected.end(), [&](const OrientationIndex::Match& m)
+			{
+				return m.angle > radius;
+			}), expected.end());
+			requireSameMatches(index.withinAngle(q, radius), expected);
+		}
+	}
+
+	REQUIRE(index.withinAngle(queries[0], std::numbers::pi).size() == library.size());
+	REQUIRE(index.withinAngle(queries[0], 10.0).size() == library.size());
+	REQUIRE_THROWS_AS(index.withinAngle(queries[0], -0.1), std::invalid_argument);
+	REQUIRE_THROWS_AS(index.withinAngle(queries[0], NAN), std::invalid_argument);
+}
+
+TEST_CASE("OrientationIndex batched queries", "[OrientationIndex]")
+{
+	std::vector<Quaternion> library = randomAttitudes(5000, 5);
+	std::vector<Quaternion> queries = randomAttitudes(257, 6);
+	OrientationIndex index(library);
+
+	std::vector<OrientationIndex::Match> rows = index.nearest(queries, 4, 3);
+	REQUIRE(rows.size() == queries.size() * 4);
+	for (std::size_t i = 0; i < queries.size(); ++i)
+	{
+		std::vector<OrientationIndex::Match> single = index.nearest(queries[i], 4);
+		for (std::size_t j = 0; j < 4; ++j)
+		{
+			REQUIRE(rows[i * 4 + j].index == single[j].index);
+			REQUIRE(rows[i * 4 + j].angle == single[j].angle);
+		}
+	}
+
+	std::vector<std::vector<OrientationIndex::Match>> balls = index.withinAngle(queries, 0.3, 4);
+	REQUIRE(balls.size() == queries.size());
+	for (std::size_t i = 0; i < queries.size(); ++i)
+	{
+		std::vector<OrientationIndex::Match> single = index.withinAngle(queries[i], 0.3);
+		REQUIRE(balls[i].size() == single.size());
+		for (std::size_t j = 0; j < single.size(); ++j)
+			REQUIRE(balls[i][j].index == single[j].index);
+	}
+
+	// Invalid queries are reported from the worker threads
+	queries[100] = Quaternion(0.0, 0.0, 0.0, 0.0);
+	REQUIRE_THROWS_AS(index.nearest(queries, 2, 4), std::invalid_argument);
+	REQUIRE_THROWS_AS(index.withinAngle(queries, 0.1, 4), std::invalid_argument);
+}
+
+TEST_CASE("OrientationIndex files", "[OrientationIndex]")
+{
+	std::vector<Quaternion> library = randomAttitudes(2000, 7);
+	std::vector<Quaternion> queries = randomAttitudes(40, 8);
+	OrientationIndex index(library, 8);
+
+	std::stringstream file;
+	index.save(file);
+	const std::string bytes = file.str();
+
+	std::istringstream in(bytes);
+	OrientationIndex loaded = OrientationIndex::load(in);
+	REQUIRE(loaded.size() == index.size());
+	REQUIRE(loaded.leafSize() == 8);
+	for (std::size_t i = 0; i < library.size(); i += 111)
+	{
+		Quaternion a = index.attitude(i);
+		Quaternion b = loaded.attitude(i);
+		for (int j = 0; j < 4; ++j)
+			REQUIRE(a.data[j] == b.data[j]);
+	}
+	for (const Quaternion& q : queries)
+	{
+		std::vector<OrientationIndex::Match> a = index.nearest(q, 5);
+		std::vector<OrientationIndex::Match> b = loaded.nearest(q, 5);
+		for (std::size_t j = 0; j < 5; ++j)
+		{
+			REQUIRE(a[j].index == b[j].index);
+			REQUIRE(a[j].angle == b[j].angle);
+		}
+	}
+
+	// Header: magic, version, leaf size, counts
+	REQUIRE(bytes.compare(0, 8, std::string("AMLOIDX\0", 8)) == 0);
+	REQUIRE(std::uint8_t(bytes[8]) == 1);
+	REQUIRE(std::uint8_t(bytes[12]) == 8);
+
+	SECTION("Malformed files are rejected")
+	{
+		std::string truncated = bytes.substr(0, bytes.size() - 1);
+		std::istringstream a(truncated);
+		REQUIRE_THROWS_AS(OrientationIndex::load(a), std::runtime_error);
+
+		std::string badMagic = bytes;
+		badMagic[0] = 'X';
+		std::istringstream b(badMagic);
+		REQUIRE_THROWS_AS(OrientationIndex::load(b), std::runtime_error);
+
+		// Duplicate library index
+		std::string badIds = bytes;
+		std::size_t idOffset = 32 + 32 * library.size();
+		badIds.replace(idOffset, 4, badIds.substr(idOffset + 4, 4));
+		std::istringstream c(badIds);
+		REQUIRE_THROWS_AS(OrientationIndex::load(c), std::runtime_error);
+
+		// Root child pointing back at the root
+		std::string badLink = bytes;
+		std::size_t nodeOffset = 32 + 36 * library.size();
+		badLink.replace(nodeOffset + 12, 4, std::string(4, '\0'));
+		std::istringstream d(badLink);
+		REQUIRE_THROWS_AS(OrientationIndex::load(d), std::runtime_error);
+
+		// Header claiming 2^31 - 1 attitudes with no data behind it
+		std::string oversized = bytes.substr(0, 32);
+		oversized.replace(16, 8, std::string("\xff\xff\xff\x7f\0\0\0\0", 8));
+		oversized.replace(24, 8, std::string(8, '\0'));
+		std::istringstream e(oversized);
+		REQUIRE_THROWS_AS(OrientationIndex::load(e), std::runtime_error);
+
+		// A short chain is a legal tree; a long one would overflow
+		// the stack of the recursive searches
+		std::istringstream shortChain(chainFile(4));
+		REQUIRE(OrientationIndex::load(shortChain).nearest(queries[0], 1).size() == 1);
+		std::istringstream longChain(chainFile(5000));
+		REQUIRE_THROWS_AS(OrientationIndex::load(longChain), std::runtime_error);
+	}
+
+	SECTION("Every built tree loads")
+	{
+		for (std::size_t n : {1, 2, 3, 17, 1000, 4097})
+			for (std::size_t leafSize : {1, 2, 3, 8})
+			{
+				std::stringstream built;
+				OrientationIndex(randomAttitudes(n, 9), leafSize).save(built);
+				REQUIRE(OrientationIndex::load(built).size() == n);
+			}
+	}
+
+	SECTION("Empty index")
+	{
+		OrientationIndex none;
+		REQUIRE(none.empty());
+		REQUIRE(none.nearest(queries[0], 3).empty());
+		REQUIRE(none.withinAngle(queries[0], 1.0).empty());
+
+		std::stringstream emptyFile;
+		none.save(emptyFile);
+		REQUIRE(OrientationIndex::load(emptyFile).empty());
+	}
+}
+
+TEST_CASE("OrientationIndex build", "[OrientationIndex]")
+{
+	// Library entries are normalized; duplicates and antipodes are
+	// all returned at distance 0
+	std::vector<Quaternion> library = randomAttitudes(100, 9);
+	library.push_back(library[10] * 3.0);
+	library.push_back(-library[10]);
+	OrientationIndex index(library, 4);
+
+	Quaternion stored = index.attitude(100);
+	Quaternion expected = unit(library[10]);
+	for (int j = 0; j < 4; ++j)
+		REQUIRE(stored.data[j] == Approx(expected.data[j]));
+
+	std::vector<OrientationIndex::Match> same = index.withinAngle(library[10], 1e-6);
+	REQUIRE(same.size() == 3);
+	std::vector<std::size_t> ids = {same[0].index, same[1].index, same[2].index};
+	std::sort(ids.begin(), ids.end());
+	REQUIRE(ids == std::vector<std::size_t>{10, 100, 101});
+
+	REQUIRE_THROWS_AS(index.attitude(102), std::out_of_range);
+	REQUIRE_THROWS_AS(OrientationIndex(library, 0), std::invalid_argument);
+	library[50] = Quaternion(0.0, 0.0, 0.0, 0.0);
+	REQUIRE_THROWS_AS(OrientationIndex(library), std::invalid_argument);
+	library[50] = Quaternion(NAN, 0.0, 0.0, 1.0);
+	REQUIRE_THROWS_AS(OrientationIndex(library), std::invalid_argument);
+	REQUIRE_THROWS_AS(index.nearest(Quaternion(0.0, 0.0, 0.0, 0.0), 1), std::invalid_argument);
+}
@@ -0,0 +1,310 @@
+#include <catch2/catch_test_macros.hpp>
+#include "AttitudeMathLib.h"
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace AML;
+
+namespace
+{
+	// Synthetic IMU: constant body rate about z, gravity on -z,
+	// magnetic field along x, sampled at a fixed rate.
+	class SyntheticImuSource
+	{
+	public:
+		SyntheticImuSource(std::uint64_t samples, std::int64_t periodNs)
+		: remaining(samples), period(periodNs) {}
+
+		std::size_t operator()(AttitudeRecord* records, std::size_t maxCount)
+		{
+			std::size_t n = 0;
+			while (n < maxCount && remaining > 0)
+			{
+				AttitudeRecord& r = records[n++];
+				r.sequence = next;
+				r.timestampNs = static_cast<std::int64_t>(next) * period;
+				r.angularRate = Vector3(0.0, 0.0, 0.1);
+				r.acceleration = Vector3(0.0, 0.0, -9.81);
+				r.magneticField = Vector3(1.0, 0.0, 0.0);
+				++next;
+				--remaining;
+			}
+			return n;
+		}
+
+	private:
+		std::uint64_t remaining;
+		std::int64_t period;
+		std::uint64_t next = 0;
+	};
+}
+
+TEST_CASE("RingBuffer single-threaded", "[RingBuffer]")
+{
+	// Case 1: capacity rounds up to a power of two
+	RingBuffer<int> q(5);
+	CHECK(q.capacity() == 8);
+	CHECK(q.empty());
+
+	// Case 2: FIFO order and full / empty reporting
+	for (int i = 0; i < 8; ++i)
+	{
+		CHECK(q.tryPush(i));
+	}
+	CHECK_FALSE(q.tryPush(8));
+	CHECK(q.size() == 8);
+	int v = -1;
+	CHECK(q.tryPop(v));
+	CHECK(v == 0);
+
+	// Case 3: batches wrap around the end of the storage
+	int in[4] = {8, 9, 10, 11};
+	CHECK(q.pushBatch(in, 4) == 1);
+	int out[16];
+	CHECK(q.popBatch(out, 16) == 8);
+	for (int i = 0; i < 8; ++i)
+	{
+		CHECK(out[i] == i + 1);
+	}
+	CHECK(q.pushBatch(in, 4) == 4);
+	CHECK(q.popBatch(out, 2) == 2);
+	CHECK(out[0] == 8);
+	CHECK(out[1] == 9);
+	CHECK(q.tryPop(v));
+	CHECK(v == 10);
+
+	// Case 4: close is observed by the consumer
+	CHECK_FALSE(q.isClosed());
+	q.close();
+	CHECK(q.isClosed());
+}
+
+TEST_CASE("RingBuffer producer / consumer threads", "[RingBuffer]")
+{
+	const std::uint64_t count = 200000;
+	RingBuffer<std::uint64_t> q(64);
+
+	std::thread producer([&]()
+	{
+		std::uint64_t batch[16];
+		std::uint64_t next = 0;
+		while (next < count)
+		{
+			std::size_t n = 0;
+			while (n < 16 && next + n < count)
+			{
+				batch[n] = next + n;
+				++n;
+			}
+			std::size_t pushed = 0;
+			while (pushed < n)
+			{
+				pushed += q.pushBatch(batch + pushed, n - pushed);
+				if (pushed < n)
+				{
+					std::this_thread::yield();
+				}
+			}
+			next += n;
+		}
+		q.close();
+	});
+
+	std::uint64_t expected = 0;
+	bool ordered = true;
+	std::uint64_t batch[16];
+	for (;;)
+	{
+		std::size_t n = q.popBatch(batch, 16);
+		if (n == 0)
+		{
+			if (q.isClosed() && q.empty())
+			{
+				break;
+			}
+			std::this_thread::yield();
+			continue;
+		}
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			ordered = ordered && (batch[i] == expected++);
+		}
+	}
+	producer.join();
+
+	CHECK(ordered);
+	CHECK(expected == count);
+}
+
+TEST_CASE("LatencyHistogram", "[Pipeline]")
+{
+	LatencyHistogram h;
+	CHECK(h.count() == 0);
+	CHECK(h.percentile(0.5) == 0);
+
+	h.record(0);
+	h.record(1);
+	h.record(100);   // bucket 6: [64, 128)
+	h.record(1000);  // bucket 9: [512, 1024)
+	CHECK(h.count() == 4);
+	CHECK(h.bucket(0) == 2);
+	CHECK(h.bucket(6) == 1);
+	CHECK(h.bucket(9) == 1);
+	CHECK(h.max() == 1000);
+	CHECK(h.percentile(0.5) == 2);
+	CHECK(h.percentile(0.75) == 128);
+	CHECK(h.percentile(1.0) == 1000);
+
+	h.reset();
+	CHECK(h.count() == 0);
+	CHECK(h.max() == 0);
+}
+
+TEST_CASE("Pipeline sensor -> attitude -> output", "[Pipeline]")
+{
+	const std::uint64_t samples = 20000;
+	const double dt = 0.01;
+
+	Pipeline pipeline(256, 16);
+	pipeline.setSource(SyntheticImuSource(samples, 10000000));
+
+	// Attitude update: first-order integration of the body rate
+	Matrix33 attitude = Matrix33::identity();
+	pipeline.addStage("attitude", [&](AttitudeRecord& r)
+	{
+		const Vector3 w = r.angularRate * dt;
+		double skew[9] = {0.0, -w.z, w.y, w.z, 0.0, -w.x, -w.y, w.x, 0.0};
+		attitude += attitude * Matrix33(skew);
+		r.attitude = attitude;
+	});
+
+	// Output: check that records arrive complete and in order
+	std::uint64_t received = 0;
+	bool ordered = true;
+	double lastYawRate = 0.0;
+	pipeline.addStage("publish", [&](AttitudeRecord& r)
+	{
+		ordered = ordered && (r.sequence == received);
+		lastYawRate = r.attitude.m21;
+		++received;
+	});
+
+	pipeline.run();
+
+	CHECK(received == samples);
+	CHECK(ordered);
+	CHECK(lastYawRate > 0.0);
+	CHECK(pipeline.stageCount() == 2);
+	CHECK(pipeline.stageName(0) == "attitude");
+	CHECK(pipeline.processed(0) == samples);
+	CHECK(pipeline.processed(1) == samples);
+	CHECK(pipeline.stageLatency(0).count() == samples);
+	CHECK(pipeline.stageLatency(1).count() == samples);
+}
+
+TEST_CASE("Pipeline backpressure", "[Pipeline]")
+{
+	const std::uint64_t samples = 2000;
+
+	// Tiny queues and a slow sink force the source to wait
+	Pipeline pipeline(4, 4);
+	pipeline.setSource(SyntheticImuSource(samples, 1000));
+	std::uint64_t received = 0;
+	pipeline.addStage("slow", [&](AttitudeRecord&)
+	{
+		std::this_thread::yield();
+		++received;
+	});
+	pipeline.run();
+
+	CHECK(received == samples);
+	CHECK(pipeline.backpressureEvents(0) > 0);
+}
+
+TEST_CASE("Pipeline stop", "[Pipeline]")
+{
+	// Endless source, ended by stop()
+	Pipeline pipeline(64, 8);
+	pipeline.setSource([](AttitudeRecord* records, std::size_t maxCount)
+	{
+		for (std::size_t i = 0; i < maxCount; ++i)
+		{
+			records[i] = AttitudeRecord();
+		}
+		return maxCount;
+	});
+	pipeline.addStage("sink", [](AttitudeRecord&) {});
+	pipeline.start();
+	while (pipeline.processed(0) == 0)
+	{
+		std::this_thread::yield();
+	}
+	CHECK_THROWS_AS(pipeline.setSource(SyntheticImuSource(1, 1000)), std::logic_error);
+	CHECK_THROWS_AS(pipeline.addStage("late", [](AttitudeRecord&) {}), std::logic_error);
+	pipeline.stop();
+	pipeline.wait();
+	CHECK(pipeline.processed(0) > 0);
+}
+
+TEST_CASE("Pipeline runs again after wait", "[Pipeline]")
+{
+	const std::uint64_t samples = 3000;
+
+	Pipeline pipeline(16, 4);
+	std::uint64_t received = 0;
+	pipeline.addStage("count", [&](AttitudeRecord&) { ++received; });
+	pipeline.addStage("sink", [](AttitudeRecord&) {});
+
+	pipeline.setSource(SyntheticImuSource(samples, 1000));
+	pipeline.run();
+	CHECK(received == samples);
+
+	// Queues were closed by the first run; counters start over
+	pipeline.setSource(SyntheticImuSource(samples / 2, 1000));
+	pipeline.run();
+	CHECK(received == samples + samples / 2);
+	CHECK(pipeline.processed(0) == samples / 2);
+	CHECK(pipeline.processed(1) == samples / 2);
+	CHECK(pipeline.stageLatency(1).count() == samples / 2);
+}
+
+TEST_CASE("Pipeline stage exception", "[Pipeline]")
+{
+	// Endless source into tiny queues: once the middle stage fails,
+	// the source and the first stage are blocked on full queues
+	// until the stop reaches them
+	Pipeline pipeline(4, 2);
+	pipeline.setSource([](AttitudeRecord* records, std::size_t maxCount)
+	{
+		for (std::size_t i = 0; i < maxCount; ++i)
+		{
+			records[i] = AttitudeRecord();
+		}
+		return maxCount;
+	});
+	std::atomic<bool> fail(true);
+	std::uint64_t seen = 0;
+	pipeline.addStage("pass", [](AttitudeRecord&) {});
+	pipeline.addStage("fail", [&](AttitudeRecord&)
+	{
+		if (++seen == 100 && fail.load())
+		{
+			throw std::runtime_error("stage failed");
+		}
+	});
+	pipeline.addStage("sink", [](AttitudeRecord&) {});
+	REQUIRE_THROWS_AS(pipeline.run(), std::runtime_error);
+	CHECK(seen == 100);
+
+	// The pipeline is usable again afterwards
+	fail.store(false);
+	pipeline.setSource(SyntheticImuSource(500, 1000));
+	seen = 0;
+	pipeline.run();
+	CHECK(seen == 500);
+	CHECK(pipeline.processed(2) == 500);
+}
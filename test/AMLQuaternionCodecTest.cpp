@@ -0,0 +1,225 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "AttitudeMathLib.h"
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace AML;
+using Catch::Approx;
+
+namespace
+{
+	const QuaternionCodec::Width widths[] = {
+		QuaternionCodec::Width::Bits32,
+		QuaternionCodec::Width::Bits48,
+		QuaternionCodec::Width::Bits64};
+
+	// Rotation angle between two attitudes (accurate for small angles)
+	double angleBetween(const Quaternion& a, const Quaternion& b)
+	{
+		Quaternion d = conjugate(a) * b;
+		double v = std::sqrt(d.q1 * d.q1 + d.q2 * d.q2 + d.q3 * d.q3);
+		return 2.0 * std::atan2(v, std::fabs(d.q0));
+	}
+
+	std::vector<Quaternion> randomAttitudes(std::size_t n)
+	{
+		std::mt19937 gen(7);
+		std::normal_distribution<double> normal;
+		std::vector<Quaternion> q(n);
+		for (Quaternion& x : q)
+			x = unit(Quaternion(normal(gen), normal(gen), normal(gen), normal(gen)));
+		return q;
+	}
+
+	// Slow coning motion sampled at 100 Hz
+	std::vector<Quaternion> smoothStream(std::size_t n)
+	{
+		std::vector<Quaternion> q(n);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			double t = 0.01 * double(i);
+			Vector3 axis = unit(Vector3(std::cos(0.3 * t), std::sin(0.3 * t), 1.0));
+			double angle = 0.8 * t;
+			q[i] = Quaternion(std::cos(0.5 * angle), axis * std::sin(0.5 * angle));
+		}
+		return q;
+	}
+}
+
+TEST_CASE("QuaternionCodec widths", "[QuaternionCodec]")
+{
+	QuaternionCodec c32(QuaternionCodec::Width::Bits32);
+	QuaternionCodec c48(QuaternionCodec::Width::Bits48);
+	QuaternionCodec c64(QuaternionCodec::Width::Bits64);
+
+	CHECK(c32.bytes() == 4);
+	CHECK(c48.bytes() == 6);
+	CHECK(c64.bytes() == 8);
+	CHECK(c32.componentBits() == 10);
+	CHECK(c48.componentBits() == 15);
+	CHECK(c64.componentBits() == 20);
+
+	CHECK(c32.maxAngularError() == Approx(4.79e-3).epsilon(0.01));
+	CHECK(c48.maxAngularError() == Approx(1.495e-4).epsilon(0.01));
+	CHECK(c64.maxAngularError() == Approx(4.67e-6).epsilon(0.01));
+
+	// Codes fit the width
+	for (const Quaternion& q : randomAttitudes(100))
+	{
+		CHECK(c32.encode(q) < (std::uint64_t(1) << 32));
+		CHECK(c48.encode(q) < (std::uint64_t(1) << 48));
+	}
+}
+
+TEST_CASE("QuaternionCodec error bound", "[QuaternionCodec]")
+{
+	std::vector<Quaternion> q = randomAttitudes(20000);
+
+	// Edge cases: ties between components, sign flips, axes
+	q.push_back(Quaternion());
+	q.push_back(Quaternion(-1.0, 0.0, 0.0, 0.0));
+	q.push_back(Quaternion(0.0, 0.0, 0.0, -1.0));
+	q.push_back(unit(Quaternion(1.0, 1.0, 1.0, 1.0)));
+	q.push_back(unit(Quaternion(1.0, -1.0, 0.0, 0.0)));
+	q.push_back(unit(Quaternion(0.0, 0.0, -1.0, 1.0)));
+
+	for (QuaternionCodec::Width w : widths)
+	{
+		QuaternionCodec codec(w);
+		double maxError = 0.0;
+		for (const Quaternion& x : q)
+		{
+			Quaternion y = codec.decode(codec.encode(x));
+			maxError = std::fmax(maxError, angleBetween(x, y));
+			CHECK(norm(y) == Approx(1.0).margin(1e-14));
+
+			// q and -q are the same attitude and share a code
+			CHECK(codec.encode(-x) == codec.encode(x));
+		}
+		CHECK(maxError <= codec.maxAngularError());
+		// The bound is reasonably tight
+		CHECK(maxError > 0.2 * codec.maxAngularError());
+	}
+
+	// Unnormalized input is normalized by the scalar encoder
+	QuaternionCodec codec;
+	Quaternion big(2.0, 0.0, 0.0, 0.0);
+	CHECK(angleBetween(codec.decode(codec.encode(big)), Quaternion()) == 0.0);
+}
+
+TEST_CASE("QuaternionCodec batch matches scalar", "[QuaternionCodec]")
+{
+	// Not a multiple of the kernel chunk size
+	std::vector<Quaternion> q = randomAttitudes(1001);
+
+	for (QuaternionCodec::Width w : widths)
+	{
+		QuaternionCodec codec(w);
+		std::vector<std::uint8_t> bytes = codec.encode(q);
+		REQUIRE(bytes.size() == q.size() * codec.bytes());
+
+		for (std::size_t i = 0; i < q.size(); ++i)
+		{
+			std::uint64_t code = 0;
+			for (std::size_t j = 0; j < codec.bytes(); ++j)
+				code |= std::uint64_t(bytes[i * codec.bytes() + j]) << (8 * j);
+			CHECK(code == codec.encode(q[i]));
+		}
+
+		std::vector<Quaternion> back = codec.decode(bytes);
+		REQUIRE(back.size() == q.size());
+		for (std::size_t i = 0; i < q.size(); i += 13)
+		{
+			Quaternion y = codec.decode(codec.encode(q[i]));
+			CHECK(back[i].q0 == y.q0);
+			CHECK(back[i].q1 == y.q1);
+			CHECK(back[i].q2 == y.q2);
+			CHECK(back[i].q3 == y.q3);
+		}
+
+		// A trailing partial word is an error, not dropped
+		bytes.pop_back();
+		CHECK_THROWS_AS(codec.decode(bytes), std::invalid_argument);
+	}
+}
+
+TEST_CASE("Quaternion delta streams", "[QuaternionCodec]")
+{
+	std::vector<Quaternion> q = smoothStream(2000);
+	const double maxStep = 0.05;
+
+	for (QuaternionCodec::Width w : widths)
+	{
+		QuaternionCodec codec(w);
+		QuaternionDeltaEncoder encoder(w, maxStep);
+		std::vector<std::uint8_t> stream;
+		for (const Quaternion& x : q)
+			encoder.push(x, stream);
+
+		CHECK(encoder.count() == q.size());
+		CHECK(encoder.keyCount() == 1);
+		CHECK(stream.size() == q.size() * codec.bytes());
+
+		QuaternionDeltaDecoder decoder(w, maxStep);
+		std::vector<Quaternion> back;
+		CHECK(decoder.decode(stream.data(), stream.size(), back) == q.size());
+		REQUIRE(back.size() == q.size());
+
+		// Closed-loop coding: the error stays at the delta step size
+		// instead of accumulating, far below the absolute bound
+		double maxError = 0.0;
+		for (std::size_t i = 1; i < q.size(); ++i)
+			maxError = std::fmax(maxError, angleBetween(q[i], back[i]));
+		CHECK(maxError < 0.1 * codec.maxAngularError());
+		CHECK(angleBetween(back.back(), encoder.reference()) == 0.0);
+	}
+}
+
+TEST_CASE("Quaternion delta keyframes and escapes", "[QuaternionCodec]")
+{
+	const QuaternionCodec::Width w = QuaternionCodec::Width::Bits32;
+	std::vector<Quaternion> q = smoothStream(1000);
+
+	// A jump larger than maxStep forces an escaped absolute code
+	for (std::size_t i = 500; i < q.size(); ++i)
+		q[i] = q[i] * Quaternion(std::cos(0.5), std::sin(0.5), 0.0, 0.0);
+
+	QuaternionDeltaEncoder encoder(w, 0.05, 100);
+	std::vector<std::uint8_t> stream;
+	for (const Quaternion& x : q)
+		encoder.push(x, stream);
+
+	// Keyframes every 100 samples (the jump falls on one of them)
+	CHECK(encoder.keyCount() == 10);
+	CHECK(stream.size() == (q.size() + 9) * 4);
+
+	// Decoding in pieces gives the same result
+	QuaternionDeltaDecoder whole(w, 0.05);
+	QuaternionDeltaDecoder pieces(w, 0.05);
+	std::vector<Quaternion> a, b;
+	whole.decode(stream.data(), stream.size(), a);
+	for (std::size_t pos = 0; pos < stream.size(); pos += 12)
+		pieces.decode(stream.data() + pos, std::min<std::size_t>(12, stream.size() - pos), b);
+	REQUIRE(a.size() == q.size());
+	REQUIRE(b.size() == q.size());
+	for (std::size_t i = 0; i < q.size(); ++i)
+	{
+		CHECK(a[i].q0 == b[i].q0);
+		CHECK(angleBetween(a[i], q[i]) < QuaternionCodec(w).maxAngularError());
+	}
+
+	// Jump between keyframes
+	QuaternionDeltaEncoder sparse(w, 0.05);
+	std::vector<std::uint8_t> s;
+	for (std::size_t i = 450; i < 550; ++i)
+		sparse.push(q[i], s);
+	CHECK(sparse.keyCount() == 2);
+	CHECK(s.size() == 101 * 4);
+
+	CHECK_THROWS_AS(whole.decode(stream.data(), 3, a), std::invalid_argument);
+	CHECK_THROWS_AS(QuaternionDeltaEncoder(w, 0.0), std::invalid_argument);
+}
@@ -0,0 +1,81 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "AttitudeMathLib.h"
+
+#include <cmath>
+
+using namespace AML;
+using Catch::Approx;
+
+TEST_CASE("Quaternion Constructors", "[Quaternion]")
+{
+	// Case 1
+	Quaternion q;
+	CHECK(q.q0 == 1.0);
+	CHECK(q.q1 == 0.0);
+	CHECK(q.q2 == 0.0);
+	CHECK(q.q3 == 0.0);
+	// Case 2
+	q = Quaternion(1.0, 2.0, 3.0, 4.0);
+	CHECK(q.data[0] == 1.0);
+	CHECK(q.data[3] == 4.0);
+	// Case 3
+	q = Quaternion(5.0, Vector3(6.0, 7.0, 8.0));
+	CHECK(q.q0 == 5.0);
+	CHECK(q.q2 == 7.0);
+	// Case 4
+	double data[4] = {4.0, 3.0, 2.0, 1.0};
+	q = Quaternion(data);
+	CHECK(q.q1 == 3.0);
+}
+
+TEST_CASE("Quaternion Products", "[Quaternion]")
+{
+	// i * j = k, j * i = -k
+	Quaternion i(0.0, 1.0, 0.0, 0.0);
+	Quaternion j(0.0, 0.0, 1.0, 0.0);
+	Quaternion k = i * j;
+	CHECK(k.q3 == 1.0);
+	CHECK((j * i).q3 == -1.0);
+	CHECK((i * i).q0 == -1.0);
+
+	Quaternion q = unit(Quaternion(1.0, 2.0, -1.0, 0.5));
+	Quaternion r = q * inverse(q);
+	CHECK(r.q0 == Approx(1.0));
+	CHECK(r.q1 == Approx(0.0).margin(1e-15));
+	CHECK(norm(q) == Approx(1.0));
+	CHECK(dot(q, conjugate(q)) == Approx(q.q0 * q.q0 - q.q1 * q.q1 - q.q2 * q.q2 - q.q3 * q.q3));
+}
+
+TEST_CASE("Quaternion Rotation", "[Quaternion]")
+{
+	// 90 degrees about z maps x onto y
+	double h = std::sqrt(0.5);
+	Quaternion qz(h, 0.0, 0.0, h);
+	Vector3 v = rotate(qz, Vector3(1.0, 0.0, 0.0));
+	CHECK(v.x == Approx(0.0).margin(1e-15));
+	CHECK(v.y == Approx(1.0));
+
+	Matrix33 R = quat2dcm(qz);
+	CHECK(R.m21 == Approx(1.0));
+	CHECK(R.m12 == Approx(-1.0));
+
+	// dcm2quat inverts quat2dcm, including the large-angle branches
+	Quaternion samples[4] = {
+		unit(Quaternion(0.9, 0.1, -0.3, 0.2)),
+		unit(Quaternion(0.1, 0.9, 0.3, -0.2)),
+		unit(Quaternion(0.05, -0.2, 0.95, 0.1)),
+		unit(Quaternion(-0.1, 0.2, 0.1, 0.95))};
+	for (const Quaternion& s : samples)
+	{
+		Quaternion back = dcm2quat(quat2dcm(s));
+		CHECK(std::fabs(dot(back, s)) == Approx(1.0));
+		CHECK(back.q0 >= 0.0);
+
+		Vector3 a = rotate(s, Vector3(0.3, -1.0, 2.0));
+		Vector3 b = quat2dcm(s) * Vector3(0.3, -1.0, 2.0);
+		CHECK(a.x == Approx(b.x));
+		CHECK(a.y == Approx(b.y));
+		CHECK(a.z == Approx(b.z));
+	}
+}
@@ -0,0 +1,235 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "AttitudeMathLib.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+using namespace AML;
+using Catch::Approx;
+
+namespace
+{
+	// Asymmetric body spinning close to its intermediate axis, so
+	// it tumbles (tennis racket / Dzhanibekov motion)
+	const DiagMatrix33 tumblerInertia(1.0, 2.0, 3.0);
+	const Vector3 tumblerRate(0.01, 2.0, 0.02);
+
+	void setTumblers(RigidBodySimulator& sim)
+	{
+		for (std::size_t i = 0; i < sim.size(); ++i)
+		{
+			double a = 0.1 * double(i);
+			sim.setBody(i, tumblerInertia * (1.0 + a), Quaternion(std::cos(a), std::sin(a), 0.0, 0.0),
+						tumblerRate + a);
+		}
+	}
+
+	double relativeError(double value, double reference)
+	{
+		return std::fabs(value - reference) / std::fabs(reference);
+	}
+}
+
+TEST_CASE("RigidBodySimulator defaults", "[RigidBodySim]")
+{
+	RigidBodySimulator sim(10, RigidBodySimulator::Integrator::RK4, 2);
+	CHECK(sim.size() == 10);
+	CHECK(sim.threadCount() == 2);
+	CHECK(sim.time() == 0.0);
+	CHECK(sim.attitude(3).q0 == 1.0);
+	CHECK(sim.inertia(3).d2 == 1.0);
+
+	sim.run(0.01, 100);
+	CHECK(sim.time() == Approx(1.0));
+	CHECK(sim.attitude(3).q0 == Approx(1.0));
+	CHECK(norm(sim.angularVelocity(3)) == 0.0);
+
+	CHECK(RigidBodySimulator(1).threadCount() >= 1);
+	CHECK_THROWS_AS(sim.setInertia(0, DiagMatrix33(1.0, 0.0, 1.0)), std::invalid_argument);
+}
+
+TEST_CASE("Steady spin about a principal axis", "[RigidBodySim]")
+{
+	for (auto method : {RigidBodySimulator::Integrator::RK4, RigidBodySimulator::Integrator::Symplectic})
+	{
+		RigidBodySimulator sim(1, method, 1);
+		sim.setBody(0, DiagMatrix33(1.0, 2.0, 3.0), Quaternion(), Vector3(0.0, 0.0, 0.5));
+		sim.run(0.01, 400);
+
+		// q(t) = rotation about z by 0.5 * t = 2 rad
+		Quaternion q = sim.attitude(0);
+		CHECK(q.q0 == Approx(std::cos(1.0)).margin(1e-10));
+		CHECK(q.q3 == Approx(std::sin(1.0)).margin(1e-10));
+		CHECK(sim.angularVelocity(0).z == Approx(0.5));
+	}
+}
+
+TEST_CASE("Constant body torque spin-up", "[RigidBodySim]")
+{
+	// Spherical body: w_z = tau t / I and the angle is tau t^2 / (2 I)
+	for (auto method : {RigidBodySimulator::Integrator::RK4, RigidBodySimulator::Integrator::Symplectic})
+	{
+		RigidBodySimulator sim(3, method, 1);
+		for (std::size_t i = 0; i < 3; ++i)
+			sim.setInertia(i, DiagMatrix33(2.0));
+		sim.setBodyTorque([](double, std::size_t, const Quaternion&, const Vector3&)
+		{
+			return Vector3(0.0, 0.0, 1.0);
+		});
+		sim.run(0.01, 200);
+
+		double angle = 2.0 * std::atan2(sim.attitude(1).q3, sim.attitude(1).q0);
+		CHECK(sim.angularVelocity(1).z == Approx(1.0).margin(1e-12));
+		CHECK(angle == Approx(1.0).margin(1e-6));
+	}
+}
+
+TEST_CASE("RK4 conserves energy and angular momentum", "[RigidBodySim]")
+{
+	RigidBodySimulator sim(4, RigidBodySimulator::Integrator::RK4, 1);
+	setTumblers(sim);
+
+	double energy[4];
+	Vector3 momentum[4];
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		energy[i] = sim.kineticEnergy(i);
+		momentum[i] = sim.angularMomentum(i);
+	}
+
+	// 20 s through several flips of the intermediate axis
+	double minRate = tumblerRate.y;
+	for (int block = 0; block < 200; ++block)
+	{
+		sim.run(0.001, 100);
+		minRate = std::fmin(minRate, sim.angularVelocity(0).y);
+	}
+
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		CHECK(relativeError(sim.kineticEnergy(i), energy[i]) < 1e-9);
+		CHECK(norm(sim.angularMomentum(i) - momentum[i]) / norm(momentum[i]) < 1e-9);
+		CHECK(norm(sim.attitude(i)) == Approx(1.0).margin(1e-14));
+	}
+
+	// The tumbling body has flipped: w_y changed sign
+	CHECK(minRate < -1.0);
+}
+
+TEST_CASE("Symplectic integrator keeps errors bounded", "[RigidBodySim]")
+{
+	RigidBodySimulator sim(4, RigidBodySimulator::Integrator::Symplectic, 1);
+	setTumblers(sim);
+
+	double energy[4], bodyMomentum[4];
+	Vector3 momentum[4];
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		energy[i] = sim.kineticEnergy(i);
+		bodyMomentum[i] = norm(sim.bodyAngularMomentum(i));
+		momentum[i] = sim.angularMomentum(i);
+	}
+
+	// Coarse step, long run: the energy error oscillates instead of
+	// growing
+	double maxEnergyError = 0.0;
+	for (int block = 0; block < 100; ++block)
+	{
+		sim.run(0.01, 1000);
+		for (std::size_t i = 0; i < 4; ++i)
+		{
+			maxEnergyError = std::fmax(maxEnergyError, relativeError(sim.kineticEnergy(i), energy[i]));
+			CHECK(relativeError(norm(sim.bodyAngularMomentum(i)), bodyMomentum[i]) < 1e-10);
+		}
+	}
+	CHECK(maxEnergyError < 1e-4);
+
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		// Each drift sub-flow is exact, so the inertial momentum only
+		// moves by rounding (10^5 steps)
+		CHECK(norm(sim.angularMomentum(i) - momentum[i]) / norm(momentum[i]) < 1e-10);
+	}
+}
+
+TEST_CASE("Threaded runs match a single thread", "[RigidBodySim]")
+{
+	// Attitude-dependent torque (restoring towards the inertial z axis)
+	auto torque = [](double, std::size_t begin, std::size_t end,
+					 const RigidBodySimulator::StateView& s, double* tx, double* ty, double* tz)
+	{
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			Vector3 zBody = rotate(conjugate(s.attitude(i)), Vector3::zAxis());
+			Vector3 tau = cross(Vector3::zAxis(), zBody) * 0.1 - s.angularVelocity(i) * 0.01;
+			tx[i] = tau.x;
+			ty[i] = tau.y;
+			tz[i] = tau.z;
+		}
+	};
+
+	for (auto method : {RigidBodySimulator::Integrator::RK4, RigidBodySimulator::Integrator::Symplectic})
+	{
+		RigidBodySimulator single(1000, method, 1);
+		RigidBodySimulator threaded(1000, method, 4);
+		setTumblers(single);
+		setTumblers(threaded);
+		single.setTorque(torque);
+		threaded.setTorque(torque);
+
+		single.run(0.01, 50);
+		threaded.run(0.01, 50);
+
+		for (std::size_t i = 0; i < 1000; i += 37)
+		{
+			CHECK(single.attitude(i).q0 == threaded.attitude(i).q0);
+			CHECK(single.attitude(i).q3 == threaded.attitude(i).q3);
+			CHECK(single.angularVelocity(i).x == threaded.angularVelocity(i).x);
+		}
+	}
+}
+
+TEST_CASE("Torque exceptions reach the caller", "[RigidBodySim]")
+{
+	RigidBodySimulator sim(2000, RigidBodySimulator::Integrator::RK4, 4);
+	sim.setBodyTorque([](double, std::size_t i, const Quaternion&, const Vector3&) -> Vector3
+	{
+		if (i == 1500)
+			throw std::runtime_error("bad body");
+		return Vector3();
+	});
+	CHECK_THROWS_AS(sim.run(0.01, 10), std::runtime_error);
+	CHECK(sim.time() == 0.0);
+
+	sim.setBodyTorque(nullptr);
+	sim.run(0.01, 10);
+	CHECK(sim.time() == Approx(0.1));
+}
+
+TEST_CASE("Moved simulators own their state", "[RigidBodySim]")
+{
+	RigidBodySimulator a(3, RigidBodySimulator::Integrator::RK4, 1);
+	a.setBody(1, DiagMatrix33(1.0, 2.0, 3.0), Quaternion(), Vector3(0.0, 0.0, 0.5));
+
+	RigidBodySimulator b(std::move(a));
+	CHECK(a.size() == 0);
+	CHECK(b.size() == 3);
+	CHECK(b.inertia(1).d3 == 3.0);
+
+	// Running the moved-from simulator must not touch b
+	a.run(0.01, 10);
+	CHECK(a.time() == 0.0);
+	b.run(0.01, 100);
+	CHECK(b.attitude(1).q3 == Approx(std::sin(0.25)));
+
+	RigidBodySimulator c(1);
+	c = std::move(b);
+	CHECK(b.size() == 0);
+	CHECK(c.size() == 3);
+	CHECK(c.time() == Approx(1.0));
+	CHECK(c.angularVelocity(1).z == 0.5);
+	c.run(0.01, 100);
+	CHECK(c.attitude(1).q3 == Approx(std::sin(0.5)));
+}
@@ -0,0 +1,287 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "AttitudeMathLib.h"
+
+#include <cmath>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace AML;
+using Catch::Approx;
+
+namespace
+{
+	double angleBetween(const Quaternion& a, const Quaternion& b)
+	{
+		Quaternion d = conjugate(a) * b;
+		double v = std::sqrt(d.q1 * d.q1 + d.q2 * d.q2 + d.q3 * d.q3);
+		return 2.0 * std::atan2(v, std::fabs(d.q0));
+	}
+
+	// Attitudes scattered around center by up to about spread rad
+	std::vector<Quaternion> scatter(const Quaternion& center, double spread, std::size_t n, unsigned seed)
+	{
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+		std::vector<Quaternion> q(n);
+		for (Quaternion& x : q)
+		{
+			Vector3 r(uniform(gen), uniform(gen), uniform(gen));
+			double angle = spread * norm(r);
+			Vector3 axis = angle > 0.0 ? unit(r) : Vector3(1.0, 0.0, 0.0);
+			x = center * Quaternion(std::cos(0.5 * angle), axis * std::sin(0.5 * angle));
+		}
+		return q;
+	}
+
+	// Chordal cost sum |R - R_i|_F^2 of a candidate mean
+	double chordalCost(const Quaternion& mean, const std::vector<Quaternion>& q)
+	{
+		Matrix33 R = quat2dcm(mean);
+		double cost = 0.0;
+		for (const Quaternion& x : q)
+		{
+			Matrix33 d = R - quat2dcm(x);
+			for (int i = 0; i < 3; ++i)
+				for (int j = 0; j < 3; ++j)
+					cost += d.data[i][j] * d.data[i][j];
+		}
+		return cost;
+	}
+
+	void requireSameAttitude(const Quaternion& a, const Quaternion& b, double tolerance)
+	{
+		REQUIRE(angleBetween(a, b) <= tolerance);
+	}
+}
+
+TEST_CASE("Rotation averaging means", "[RotationAveraging]")
+{
+	const Quaternion center = unit(Quaternion(0.3, -0.5, 0.7, 0.2));
+	std::vector<Quaternion> q = scatter(center, 0.4, 2000, 1);
+
+	ChordalMeanAccumulator chordal;
+	QuaternionMeanAccumulator eigen;
+	QuaternionMeanAccumulator fromMatrices;
+	for (std::size_t i = 0; i < q.size(); ++i)
+	{
+		chordal.add(q[i]);
+		// Input signs do not matter
+		eigen.add(i % 2 ? q[i] : -q[i]);
+		fromMatrices.add(quat2dcm(q[i]));
+	}
+	REQUIRE(chordal.count() == q.size());
+	REQUIRE(eigen.weight() == Approx(double(q.size())));
+
+	// The mean of a symmetric scatter is close to its center
+	Quaternion mean = chordal.mean();
+	REQUIRE(norm(mean) == Approx(1.0));
+	REQUIRE(mean.q0 >= 0.0);
+	requireSameAttitude(mean, center, 0.01);
+
+	// All forms compute the chordal mean
+	requireSameAttitude(eigen.mean(), mean, 1e-12);
+	requireSameAttitude(fromMatrices.mean(), mean, 1e-12);
+	ChordalMeanAccumulator chordalMatrices;
+	for (const Quaternion& x : q)
+		chordalMatrices.add(quat2dcm(x));
+	requireSameAttitude(chordalMatrices.mean(), mean, 1e-12);
+
+	// It minimizes the chordal cost
+	double best = chordalCost(mean, q);
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		for (double step : {-1e-3, 1e-3})
+		{
+			Vector3 v;
+			v.data[axis] = step;
+			Quaternion nudged = mean * Quaternion(std::cos(0.5 * step), v * (std::sin(0.5 * step) / step));
+			REQUIRE(chordalCost(nudged, q) > best);
+		}
+	}
+
+	// The mean matrix is a rotation; the averaged elements are not
+	Matrix33 R = chordal.meanMatrix();
+	Matrix33 I = R * transpose(R);
+	for (int i = 0; i < 3; ++i)
+		for (int j = 0; j < 3; ++j)
+			REQUIRE(I.data[i][j] == Approx(i == j ? 1.0 : 0.0).margin(1e-12));
+	REQUIRE(determinant(R) == Approx(1.0));
+	Matrix33 naive = chordal.sum() / chordal.weight();
+	REQUIRE(determinant(naive) < 0.9);
+
+	// The second moment has trace equal to the total weight
+	MatrixN<4, 4> A = eigen.secondMoment();
+	REQUIRE(A(0, 0) + A(1, 1) + A(2, 2) + A(3, 3) == Approx(double(q.size())));
+	REQUIRE(A(1, 2) == A(2, 1));
+
+	// A single sample is its own mean
+	QuaternionMeanAccumulator one;
+	one.add(-center);
+	requireSameAttitude(one.mean(), center, 1e-12);
+	REQUIRE(one.mean().q0 >= 0.0);
+}
+
+TEST_CASE("Rotation averaging weights and batches", "[RotationAveraging]")
+{
+	std::vector<Quaternion> q = scatter(Quaternion(1.0, 0.0, 0.0, 0.0), 1.2, 1000, 2);
+	std::vector<Matrix33> R(q.size());
+	std::vector<double> w(q.size());
+	for (std::size_t i = 0; i < q.size(); ++i)
+	{
+		R[i] = quat2dcm(q[i]);
+		w[i] = double(i % 5);
+	}
+
+	ChordalMeanAccumulator chordal, chordalBatch, chordalMatrixBatch;
+	QuaternionMeanAccumulator eigen, eigenBatch, eigenMatrixBatch;
+	for (std::size_t i = 0; i < q.size(); ++i)
+	{
+		chordal.add(q[i], w[i]);
+		eigen.add(q[i], w[i]);
+	}
+	chordalBatch.add(q.data(), q.size(), w.data());
+	chordalMatrixBatch.add(R.data(), R.size(), w.data());
+	eigenBatch.add(q.data(), q.size(), w.data());
+	eigenMatrixBatch.add(R.data(), R.size(), w.data());
+
+	REQUIRE(chordalBatch.count() == q.size());
+	REQUIRE(chordalBatch.weight() == Approx(chordal.weight()));
+	requireSameAttitude(chordalBatch.mean(), chordal.mean(), 1e-12);
+	requireSameAttitude(chordalMatrixBatch.mean(), chordal.mean(), 1e-12);
+	requireSameAttitude(eigenBatch.mean(), chordal.mean(), 1e-12);
+	requireSameAttitude(eigenMatrixBatch.mean(), chordal.mean(), 1e-12);
+
+	// The matrices as a column-major buffer through a view
+	std::vector<double> columns(9 * R.size());
+	Matrix33View view(std::span<double>(columns), MatrixLayout::ColumnMajor);
+	for (std::size_t i = 0; i < R.size(); ++i)
+		view.set(i, R[i]);
+	ChordalMeanAccumulator chordalView;
+	QuaternionMeanAccumulator eigenView;
+	chordalView.add(view, w.data());
+	eigenView.add(view, w.data());
+	REQUIRE(chordalView.count() == q.size());
+	REQUIRE(eigenView.weight() == Approx(chordal.weight()));
+	requireSameAttitude(chordalView.mean(), chordal.mean(), 1e-12);
+	requireSameAttitude(eigenView.mean(), chordal.mean(), 1e-12);
+	chordalView.remove(view.subview(0, 600), w.data());
+	eigenView.remove(view.subview(0, 600), w.data());
+	chordalMatrixBatch.remove(R.data(), 600, w.data());
+	REQUIRE(eigenView.count() == 400);
+	requireSameAttitude(chordalView.mean(), chordalMatrixBatch.mean(), 1e-12);
+	REQUIRE_THROWS_AS(eigenView.remove(view, w.data()), std::logic_error);
+
+	// Weight 2 is the same as adding twice
+	ChordalMeanAccumulator twice, doubled;
+	twice.add(q[0]);
+	twice.add(q[0]);
+	twice.add(q[1]);
+	doubled.add(q[0], 2.0);
+	doubled.add(q[1]);
+	requireSameAttitude(twice.mean(), doubled.mean(), 1e-12);
+
+	// Zero total weight has no mean
+	QuaternionMeanAccumulator zero;
+	zero.add(q[0], 0.0);
+	REQUIRE(zero.count() == 1);
+	REQUIRE(std::isnan(zero.mean().q0));
+	REQUIRE(std::isnan(ChordalMeanAccumulator().mean().q0));
+
+	REQUIRE_THROWS_AS(chordal.add(q[0], -1.0), std::invalid_argument);
+	REQUIRE_THROWS_AS(eigen.add(R[0], NAN), std::invalid_argument);
+	w[500] = INFINITY;
+	std::size_t before = eigenBatch.count();
+	REQUIRE_THROWS_AS(eigenBatch.add(q.data(), q.size(), w.data()), std::invalid_argument);
+	REQUIRE(eigenBatch.count() == before);
+}
+
+TEST_CASE("Rotation averaging merge and sliding windows", "[RotationAveraging]")
+{
+	std::vector<Quaternion> q = scatter(unit(Quaternion(0.1, 0.9, -0.2, 0.4)), 0.8, 3000, 3);
+
+	SECTION("Partial accumulators merge")
+	{
+		ChordalMeanAccumulator whole, parts[3];
+		QuaternionMeanAccumulator wholeEigen, partsEigen[3];
+		for (std::size_t i = 0; i < q.size(); ++i)
+		{
+			whole.add(q[i]);
+			parts[i % 3].add(q[i]);
+			wholeEigen.add(q[i]);
+			partsEigen[i % 3].add(q[i]);
+		}
+		parts[0].merge(parts[1]);
+		parts[0] += parts[2];
+		partsEigen[0] += partsEigen[1];
+		partsEigen[0].merge(partsEigen[2]);
+
+		REQUIRE(parts[0].count() == q.size());
+		REQUIRE(partsEigen[0].count() == q.size());
+		requireSameAttitude(parts[0].mean(), whole.mean(), 1e-12);
+		requireSameAttitude(partsEigen[0].mean(), wholeEigen.mean(), 1e-12);
+	}
+
+	SECTION("Sliding window")
+	{
+		const std::size_t window = 100;
+		ChordalMeanAccumulator chordal;
+		QuaternionMeanAccumulator eigen;
+		for (std::size_t i = 0; i < q.size(); ++i)
+		{
+			chordal.add(q[i]);
+			eigen.add(quat2dcm(q[i]), 0.5);
+			if (i >= window)
+			{
+				chordal.remove(q[i - window]);
+				eigen.remove(quat2dcm(q[i - window]), 0.5);
+			}
+		}
+		REQUIRE(chordal.count() == window);
+		REQUIRE(eigen.weight() == Approx(0.5 * window));
+
+		ChordalMeanAccumulator fresh;
+		fresh.add(q.data() + q.size() - window, window);
+		requireSameAttitude(chordal.mean(), fresh.mean(), 1e-12);
+		requireSameAttitude(eigen.mean(), fresh.mean(), 1e-12);
+
+		// Batched removal, then removing everything clears the state
+		chordal.remove(q.data() + q.size() - window, window / 2);
+		REQUIRE(chordal.count() == window / 2);
+		chordal.remove(q.data() + q.size() - window / 2, window / 2);
+		REQUIRE(chordal.count() == 0);
+		REQUIRE(chordal.weight() == 0.0);
+		REQUIRE(std::isnan(chordal.mean().q0));
+
+		REQUIRE_THROWS_AS(chordal.remove(q[0]), std::logic_error);
+		REQUIRE_THROWS_AS(eigen.remove(q.data(), window + 1), std::logic_error);
+		REQUIRE(eigen.count() == window);
+	}
+
+	SECTION("Long streams do not drift")
+	{
+		// A small resident window with a large batch streamed
+		// through it; the accumulator never empties (which would
+		// reset it), so the compensated sums must cancel the batch
+		// to full precision on their own
+		ChordalMeanAccumulator running;
+		std::vector<Quaternion> tail(q.end() - 10, q.end());
+		running.add(tail.data(), tail.size());
+		for (int pass = 0; pass < 100; ++pass)
+		{
+			running.add(q.data(), q.size());
+			running.remove(q.data(), q.size());
+			REQUIRE(running.count() == tail.size());
+		}
+
+		ChordalMeanAccumulator fresh;
+		fresh.add(tail.data(), tail.size());
+		Matrix33 a = running.sum(), b = fresh.sum();
+		for (int i = 0; i < 3; ++i)
+			for (int j = 0; j < 3; ++j)
+				REQUIRE(a.data[i][j] == Approx(b.data[i][j]).margin(1e-13));
+		requireSameAttitude(running.mean(), fresh.mean(), 1e-13);
+	}
+}
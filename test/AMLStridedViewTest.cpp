@@ -0,0 +1,209 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "AttitudeMathLib.h"
+
+#include <cmath>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace AML;
+using Catch::Approx;
+
+namespace
+{
+	void requireEqual(const Vector3& a, const Vector3& b)
+	{
+		REQUIRE(a.x == Approx(b.x).margin(1e-15));
+		REQUIRE(a.y == Approx(b.y).margin(1e-15));
+		REQUIRE(a.z == Approx(b.z).margin(1e-15));
+	}
+
+	void requireEqual(const Matrix33& a, const Matrix33& b)
+	{
+		for (int i = 0; i < 3; ++i)
+			for (int j = 0; j < 3; ++j)
+				REQUIRE(a.data[i][j] == Approx(b.data[i][j]).margin(1e-15));
+	}
+}
+
+TEST_CASE("Strided views address external buffers", "[StridedView]")
+{
+	// Two packed row-major matrices and the same two column-major
+	std::vector<double> rows = {1, 2, 3, 4, 5, 6, 7, 8, 9,
+	                            -1, -2, -3, -4, -5, -6, -7, -8, -9};
+	std::vector<double> cols = {1, 4, 7, 2, 5, 8, 3, 6, 9,
+	                            -1, -4, -7, -2, -5, -8, -3, -6, -9};
+	Matrix33View R{std::span<double>(rows)};
+	ConstMatrix33View C{std::span<const double>(cols), MatrixLayout::ColumnMajor};
+	REQUIRE(R.size() == 2);
+	REQUIRE(C.size() == 2);
+	for (std::size_t i = 0; i < 2; ++i)
+		requireEqual(R.get(i), C.get(i));
+	REQUIRE(R.get(0).m23 == 6.0);
+	REQUIRE(C(1, 0, 2) == -3.0);
+	requireEqual(R.get(1), Matrix33(rows.data() + 9));
+
+	// Writes go straight to the buffer
+	R.set(1, Matrix33::identity());
+	REQUIRE(rows[9] == 1.0);
+	REQUIRE(rows[10] == 0.0);
+	R(0, 2, 0) = 70.0;
+	REQUIRE(rows[6] == 70.0);
+
+	// Vectors embedded in 5-double records: [t, x, y, z, flag]
+	std::vector<double> records = {0.0, 1.0, 2.0, 3.0, 9.0,
+	                               0.1, 4.0, 5.0, 6.0, 9.0,
+	                               0.2, 7.0, 8.0, 9.0, 9.0};
+	Vector3View v(records.data() + 1, 3, 5);
+	requireEqual(v.get(1), Vector3(4.0, 5.0, 6.0));
+	v.set(2, Vector3(-1.0, -2.0, -3.0));
+	REQUIRE(records[11] == -1.0);
+	REQUIRE(records[14] == 9.0);
+
+	// Structure-of-arrays: x0 x1 x2 | y0 y1 y2 | z0 z1 z2
+	std::vector<double> soa = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+	ConstVector3View s(soa.data(), 3, 1, 3);
+	requireEqual(s.get(2), Vector3(3.0, 6.0, 9.0));
+
+	ConstVector3View tail = v.subview(1, 2);
+	REQUIRE(tail.size() == 2);
+	requireEqual(tail.get(0), Vector3(4.0, 5.0, 6.0));
+	REQUIRE(v.subview(3, 0).empty());
+	REQUIRE(C.subview(1, 1).get(0).m12 == -2.0);
+
+	REQUIRE_THROWS_AS(v.subview(2, 2), std::out_of_range);
+	REQUIRE_THROWS_AS(Vector3View(std::span<double>(records.data(), 4)), std::invalid_argument);
+	REQUIRE_THROWS_AS(Matrix33View(std::span<double>(rows.data(), 10)), std::invalid_argument);
+	REQUIRE_THROWS_AS(Vector3View(nullptr, 1), std::invalid_argument);
+	REQUIRE(Matrix33View().empty());
+}
+
+TEST_CASE("Batch operations on strided views", "[StridedView]")
+{
+	std::mt19937 gen(1);
+	std::normal_distribution<double> normal;
+	const std::size_t n = 100;
+
+	// Row-major AoS matrices, column-major matrices inside 12-double
+	// records, packed vectors and SoA vectors
+	std::vector<double> a(9 * n), b(12 * n), x(3 * n), y(3 * n);
+	for (double& e : a) e = normal(gen);
+	for (double& e : b) e = normal(gen);
+	for (double& e : x) e = normal(gen);
+	for (double& e : y) e = normal(gen);
+	y[7] = y[n + 7] = y[2 * n + 7] = 0.0;
+
+	ConstMatrix33View A{std::span<const double>(a)};
+	ConstMatrix33View B(b.data() + 2, n, MatrixLayout::ColumnMajor, 12);
+	ConstVector3View X{std::span<const double>(x)};
+	ConstVector3View Y(y.data(), n, 1, std::ptrdiff_t(n));
+
+	std::vector<double> outV(3 * n), outM(9 * n), scalars(n);
+	Vector3View V{std::span<double>(outV)};
+	Matrix33View M(outM.data(), n, MatrixLayout::ColumnMajor);
+
+	multiply(A, X, V);
+	for (std::size_t i = 0; i < n; ++i)
+		requireEqual(V.get(i), A.get(i) * X.get(i));
+	transposeMultiply(B, Y, V);
+	for (std::size_t i = 0; i < n; ++i)
+		requireEqual(V.get(i), transpose(B.get(i)) * Y.get(i));
+	multiply(B.get(3), X, V);
+	for (std::size_t i = 0; i < n; ++i)
+		requireEqual(V.get(i), B.get(3) * X.get(i));
+	multiply(A, B, M);
+	for (std::size_t i = 0; i < n; ++i)
+		requireEqual(M.get(i), A.get(i) * B.get(i));
+	transpose(B, M);
+	for (std::size_t i = 0; i < n; ++i)
+		requireEqual(M.get(i), transpose(B.get(i)));
+
+	add(X, Y, V);
+	for (std::size_t i = 0; i < n; ++i)
+		requireEqual(V.get(i), X.get(i) + Y.get(i));
+	subtract(X, Y, V);
+	for (std::size_t i = 0; i < n; ++i)
+		requireEqual(V.get(i), X.get(i) - Y.get(i));
+	scale(X, -2.5, V);
+	for (std::size_t i = 0; i < n; ++i)
+		requireEqual(V.get(i), X.get(i) * -2.5);
+	cross(X, Y, V);
+	for (std::size_t i = 0; i < n; ++i)
+		requireEqual(V.get(i), cross(X.get(i), Y.get(i)));
+	dot(X, Y, scalars.data());
+	for (std::size_t i = 0; i < n; ++i)
+		REQUIRE(scalars[i] == Approx(dot(X.get(i), Y.get(i))));
+	norm(Y, scalars.data());
+	for (std::size_t i = 0; i < n; ++i)
+		REQUIRE(scalars[i] == Approx(norm(Y.get(i))).margin(1e-15));
+	normalize(Y, V);
+	for (std::size_t i = 0; i < n; ++i)
+		requireEqual(V.get(i), unit(Y.get(i)));
+	requireEqual(V.get(7), Vector3(0.0, 0.0, 0.0));
+
+	copy(B, M);
+	for (std::size_t i = 0; i < n; ++i)
+		REQUIRE(M.get(i).data[1][2] == B.get(i).data[1][2]);
+	copy(Y, V);
+	REQUIRE(outV[3 * 5 + 1] == y[n + 5]);
+
+	REQUIRE_THROWS_AS(multiply(A, X.subview(0, n - 1), V), std::invalid_argument);
+	REQUIRE_THROWS_AS(add(X, Y, V.subview(1, n - 1)), std::invalid_argument);
+}
+
+TEST_CASE("Strided view operations in place", "[StridedView]")
+{
+	std::mt19937 gen(2);
+	std::normal_distribution<double> normal;
+	const std::size_t n = 50;
+
+	// Rotate vectors stored in the buffer they came from
+	std::vector<double> x(3 * n), original;
+	for (double& e : x) e = normal(gen);
+	original = x;
+	Matrix33 R = quat2dcm(unit(Quaternion(0.3, -0.2, 0.9, 0.1)));
+	Vector3View X{std::span<double>(x)};
+	multiply(R, X, X);
+	for (std::size_t i = 0; i < n; ++i)
+		requireEqual(X.get(i), R * Vector3(original.data() + 3 * i));
+	transposeMultiply(ConstMatrix33View(&R.m11, n, MatrixLayout::RowMajor, 0), X, X);
+	for (std::size_t i = 0; i < n; ++i)
+		requireEqual(X.get(i), Vector3(original.data() + 3 * i));
+
+	// Compose attitudes in place, row- and column-major alike
+	std::vector<double> rows(9 * n), cols(9 * n);
+	Matrix33View Rows{std::span<double>(rows)};
+	Matrix33View Cols{std::span<double>(cols), MatrixLayout::ColumnMajor};
+	std::vector<Matrix33> first(n), second(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		first[i] = quat2dcm(unit(Quaternion(normal(gen), normal(gen), normal(gen), normal(gen))));
+		second[i] = quat2dcm(unit(Quaternion(normal(gen), normal(gen), normal(gen), normal(gen))));
+		Rows.set(i, first[i]);
+		Cols.set(i, second[i]);
+	}
+	multiply(Rows, Cols, Rows);
+	for (std::size_t i = 0; i < n; ++i)
+		requireEqual(Rows.get(i), first[i] * second[i]);
+	multiply(Rows, Cols, Cols);
+	for (std::size_t i = 0; i < n; ++i)
+		requireEqual(Cols.get(i), first[i] * second[i] * second[i]);
+
+	// Transposing a column-major batch in place leaves the
+	// row-major layout of the same matrices
+	std::vector<double> before = cols;
+	transpose(Cols, Cols);
+	ConstMatrix33View Before{std::span<const double>(before), MatrixLayout::ColumnMajor};
+	ConstMatrix33View After{std::span<const double>(cols), MatrixLayout::RowMajor};
+	for (std::size_t i = 0; i < n; ++i)
+		requireEqual(After.get(i), Before.get(i));
+
+	// Structure-of-arrays vectors normalized in place
+	std::vector<double> soa(3 * n, 2.0);
+	Vector3View S(soa.data(), n, 1, std::ptrdiff_t(n));
+	normalize(S, S);
+	REQUIRE(soa[0] == Approx(1.0 / std::sqrt(3.0)));
+	REQUIRE(soa[2 * n + n - 1] == Approx(1.0 / std::sqrt(3.0)));
+}
@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "AttitudeMathLib.h"
+
+#include <cmath>
+
+using namespace AML;
+using Catch::Approx;
+
+namespace
+{
+	void checkEqual(const Matrix33& a, const Matrix33& b)
+	{
+		for (int i = 0; i < 3; ++i)
+			for (int j = 0; j < 3; ++j)
+				CHECK(a.data[i][j] == Approx(b.data[i][j]).margin(1e-12));
+	}
+
+	// Inertia-like tensor (symmetric positive definite)
+	const SymMatrix33 inertia(4.0, -0.3, 0.2, 5.0, 0.1, 6.0);
+}
+
+TEST_CASE("SymMatrix33 construction", "[SymMatrix33]")
+{
+	static constexpr SymMatrix33 I = SymMatrix33::identity();
+	static_assert(I.s11 == 1.0 && I.s12 == 0.0 && I.s33 == 1.0);
+
+	SymMatrix33 zero;
+	for (int i = 0; i < 6; ++i)
+		CHECK(zero.data[i] == 0.0);
+
+	Matrix33 dense = inertia.toMatrix33();
+	CHECK(dense.m21 == dense.m12);
+	CHECK(dense.m31 == dense.m13);
+	CHECK(dense.m32 == dense.m23);
+
+	SymMatrix33 back(dense);
+	for (int i = 0; i < 6; ++i)
+		CHECK(back.data[i] == inertia.data[i]);
+
+	SymMatrix33 fromDiag(DiagMatrix33(1.0, 2.0, 3.0));
+	checkEqual(fromDiag.toMatrix33(), diag(Vector3(1.0, 2.0, 3.0)));
+}
+
+TEST_CASE("SymMatrix33 products match dense", "[SymMatrix33]")
+{
+	double data[9] = {1.0, -2.0, 0.5, 3.0, 0.25, -1.0, 2.0, 4.0, -3.0};
+	Matrix33 M(data);
+	Matrix33 S = inertia.toMatrix33();
+	Vector3 v(0.3, -1.2, 2.5);
+
+	Vector3 sv = inertia * v;
+	Vector3 dv = S * v;
+	CHECK(sv.x == Approx(dv.x));
+	CHECK(sv.y == Approx(dv.y));
+	CHECK(sv.z == Approx(dv.z));
+
+	checkEqual(inertia * M, S * M);
+	checkEqual(M * inertia, M * S);
+	checkEqual(inertia * inertia, S * S);
+
+	SymMatrix33 other(1.0, 2.0, 3.0, 4.0, 5.0, 6.0);
+	checkEqual((inertia + other).toMatrix33(), S + other.toMatrix33());
+	checkEqual((inertia - other).toMatrix33(), S - other.toMatrix33());
+	checkEqual((-inertia).toMatrix33(), -S);
+	checkEqual((inertia * 2.0).toMatrix33(), S * 2.0);
+	checkEqual((inertia / 2.0).toMatrix33(), S / 2.0);
+
+	CHECK(quadraticForm(inertia, v) == Approx(dot(v, S * v)));
+	CHECK(trace(inertia) == Approx(15.0));
+}
+
+TEST_CASE("SymMatrix33 inverse and determinant", "[SymMatrix33]")
+{
+	Matrix33 S = inertia.toMatrix33();
+	CHECK(determinant(inertia) == Approx(determinant(S)));
+
+	SymMatrix33 Si = inverse(inertia);
+	checkEqual(Si.toMatrix33(), inverse(S));
+	checkEqual(inertia * Si.toMatrix33(), Matrix33::identity());
+	checkEqual(transpose(inertia).toMatrix33(), S);
+
+	SymMatrix33 singular(1.0, 2.0, 0.0, 4.0, 0.0, 0.0);
+	SymMatrix33 bad = inverse(singular);
+	for (int i = 0; i < 6; ++i)
+		CHECK(std::isnan(bad.data[i]));
+}
+
+TEST_CASE("Congruence transform", "[SymMatrix33]")
+{
+	Matrix33 R = RotationZ(0.7) * RotationY(-0.4) * RotationX(1.3);
+	Matrix33 S = inertia.toMatrix33();
+
+	SymMatrix33 rotated = congruence(R, inertia);
+	checkEqual(rotated.toMatrix33(), R * S * transpose(R));
+
+	// Rotation preserves trace and determinant
+	CHECK(trace(rotated) == Approx(trace(inertia)));
+	CHECK(determinant(rotated) == Approx(determinant(inertia)));
+
+	// Back to the original frame
+	SymMatrix33 back = congruence(transpose(R), rotated);
+	checkEqual(back.toMatrix33(), S);
+
+	// Principal-axis inertia rotated into the body frame
+	DiagMatrix33 principal(2.0, 3.0, 7.0);
+	SymMatrix33 body = congruence(R, principal);
+	checkEqual(body.toMatrix33(), R * principal.toMatrix33() * transpose(R));
+	checkEqual(body.toMatrix33(), congruence(R, SymMatrix33(principal)).toMatrix33());
+
+	// Also valid for a general (non-orthogonal) matrix
+	double data[9] = {1.0, -2.0, 0.5, 3.0, 0.25, -1.0, 2.0, 4.0, -3.0};
+	Matrix33 M(data);
+	checkEqual(congruence(M, inertia).toMatrix33(), M * S * transpose(M));
+}
@@ -29,3 +29,19 @@ TEST_CASE("Vector3 Constructors", "[Vector3]")
 	CHECK(v.y == 2.0);
 	CHECK(v.z == 1.0);	
 }
+
+TEST_CASE("Vector3 cross product", "[Vector3]")
+{
+	Vector3 z = cross(Vector3::xAxis(), Vector3::yAxis());
+	CHECK(z.x == 0.0);
+	CHECK(z.y == 0.0);
+	CHECK(z.z == 1.0);
+	Vector3 y = cross(Vector3::zAxis(), Vector3::xAxis());
+	CHECK(y.x == 0.0);
+	CHECK(y.y == 1.0);
+	CHECK(y.z == 0.0);
+	Vector3 c = cross(Vector3(1.0, 2.0, 3.0), Vector3(4.0, 5.0, 6.0));
+	CHECK(c.x == -3.0);
+	CHECK(c.y == 6.0);
+	CHECK(c.z == -3.0);
+}